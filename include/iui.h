@@ -13,7 +13,13 @@
 /* MD3 component specifications (dimensions, durations, accessibility) */
 #include "iui-spec.h"
 
-/* System Configuration - Override before including this header */
+/* System Configuration - Override before including this header
+ * The window, blocking region, input event, widget state, focusable widget,
+ * box, ID and clip stack sizes are only defaults: iui_config_t can request
+ * other capacities per context (see iui_min_memory_size_for). The optional
+ * tables (widget map, outline cache, paragraph cache) default to 0, so a
+ * context only pays for the ones it enables.
+ */
 #ifndef IUI_MAX_WINDOWS
 #define IUI_MAX_WINDOWS 16
 #endif
@@ -29,6 +35,12 @@
 #ifndef IUI_MAX_TABLE_COLS
 #define IUI_MAX_TABLE_COLS 16
 #endif
+#ifndef IUI_TABLE_CACHE_TEXT
+#define IUI_TABLE_CACHE_TEXT 32
+#endif
+#ifndef IUI_SCROLL_LAYER_TILES
+#define IUI_SCROLL_LAYER_TILES 16
+#endif
 #ifndef IUI_SEARCH_QUERY_SIZE
 #define IUI_SEARCH_QUERY_SIZE 256
 #endif
@@ -47,6 +59,24 @@
 #ifndef IUI_CLIP_STACK_SIZE
 #define IUI_CLIP_STACK_SIZE 8
 #endif
+#ifndef IUI_SCROLL_STACK_SIZE
+#define IUI_SCROLL_STACK_SIZE 4
+#endif
+#ifndef IUI_GLYPH_CACHE_POINTS
+#define IUI_GLYPH_CACHE_POINTS 0 /* vector font outline cache points */
+#endif
+#ifndef IUI_MAX_INPUT_EVENTS
+#define IUI_MAX_INPUT_EVENTS 24
+#endif
+#ifndef IUI_MAX_WIDGET_STATES
+#define IUI_MAX_WIDGET_STATES 64
+#endif
+#ifndef IUI_WIDGET_MAP_SIZE
+#define IUI_WIDGET_MAP_SIZE 0 /* interactive widgets recorded per frame */
+#endif
+#ifndef IUI_PARAGRAPH_CACHE_SIZE
+#define IUI_PARAGRAPH_CACHE_SIZE 0 /* paragraphs with memoized line breaks */
+#endif
 
 /* Public Structures */
 /* Mouse button flags for multi-button support */
@@ -127,6 +157,30 @@ typedef struct {
     bool is_dragging;      /* true when mouse drag selection is active */
 } iui_edit_state;
 
+/* Gap-buffer text storage for large editable text (caller memory)
+ * The text sits in @data on both sides of a gap kept at the cursor:
+ * [0, gap) before it and [gap + gap_len, capacity - 1) after it, with the
+ * last byte reserved as terminator. Edits next to the cursor only resize the
+ * gap and moving the cursor shifts just the bytes passed over, so typing is
+ * O(1) however long the text is. The length is derived from the gap size.
+ * Manage it with the iui_text_buffer_* functions.
+ */
+typedef struct {
+    char *data;       /* storage, @capacity bytes */
+    size_t capacity;  /* storage size, one byte kept for a terminator */
+    size_t gap;       /* gap start; also the cursor byte offset */
+    size_t gap_len;   /* free bytes in the gap */
+    uint32_t version; /* bumped by every change to the text */
+    /* widths measured by the text fields, reused while version, gap and font
+     * size match (maintained by the library)
+     */
+    struct {
+        uint32_t version;
+        size_t gap, count, head_count; /* code points: all, before the gap */
+        float font_height, width, head_width;
+    } measured;
+} iui_text_buffer_t;
+
 /* MD3 Slider options for enhanced slider configuration
  * Reference: https://m3.material.io/components/sliders/specs
  */
@@ -257,12 +311,17 @@ typedef struct {
 } iui_snackbar_state;
 
 /* Scrollable container state (user-provided)
- * Content size is measured automatically during iui_scroll_end()
+ * Content size is measured automatically during iui_scroll_end(), or kept
+ * from an earlier frame while iui_scroll_content_hash() reports a match
  */
 typedef struct {
     float scroll_x, scroll_y;   /* current scroll offset (pixels) */
     float content_w, content_h; /* measured size (set by iui_scroll_end) */
     float velocity_y; /* for momentum scrolling (optional, user-managed) */
+    uint32_t content_hash; /* hash the content size was measured under */
+    bool content_valid;    /* content_w/content_h belong to content_hash */
+    uint8_t content_frame; /* internal: hash declared this frame (1 = miss,
+                            * 2 = hit) */
 } iui_scroll_state;
 
 /* Menu item structure for vertical menus */
@@ -629,9 +688,33 @@ typedef struct {
                      float width,
                      uint32_t srgb_color,
                      void *user);
+    /* Cached scroll layers (optional, NULL = draw scroll content directly)
+     * Draws between layer_begin and layer_end are scroll content at offset
+     * @scroll_y in @viewport. The port may rasterize them into an offscreen
+     * buffer taller than the viewport; @reuse is true when rows it kept from
+     * earlier frames still hold the same content, so only newly exposed rows
+     * need drawing. Return false to draw directly this frame. layer_end
+     * composites the visible rows into the viewport.
+     */
+    bool (*layer_begin)(iui_rect_t viewport,
+                        float scroll_y,
+                        bool reuse,
+                        void *user);
+    void (*layer_end)(void *user);
     void *user;
 } iui_renderer_t;
 
+/* Coverage mask of one baked glyph: the glyph occupies [x, x + width) by
+ * [y, y + height) of an atlas whose rows are stride bytes apart. bpp is 4
+ * (two pixels per byte, high nibble first) or 8; coverage scales color alpha.
+ */
+typedef struct {
+    const uint8_t *pixels;
+    uint16_t stride;
+    uint16_t x, y, width, height;
+    uint8_t bpp;
+} iui_glyph_mask_t;
+
 /* Vector font callbacks for path-based text rendering
  * Glyph bytecode format (1/64 unit coords):
  * Header [6 bytes]: left_bearing, right_bearing, ascent, descent, n_snap_x,
@@ -649,14 +732,54 @@ typedef struct {
                        float y3,
                        void *user);
     void (*path_stroke)(float width, uint32_t color, void *user);
+    /* Optional text runs: when both are set, every subpath of a string is
+     * emitted between path_begin_run and path_end_run without intermediate
+     * path_stroke calls, and the backend strokes the whole run once with the
+     * width and color given to path_begin_run.
+     */
+    void (*path_begin_run)(float width, uint32_t color, void *user);
+    void (*path_end_run)(void *user);
+    /* Optional pre-rasterized glyphs (CONFIG_FEATURE_FONT_ATLAS): when set and
+     * the font height matches a baked size, text is drawn by blitting glyph
+     * masks at integer (x, y) instead of emitting paths.
+     */
+    void (*draw_glyph_mask)(int x,
+                            int y,
+                            const iui_glyph_mask_t *mask,
+                            uint32_t color,
+                            void *user);
 } iui_vector_t;
 
 typedef struct {
     void *buffer;            /* must be aligned on 8 bytes */
+    size_t buffer_size;      /* bytes at @buffer; 0 skips the size check */
     iui_renderer_t renderer; /* draw_box and set_clip_rect required */
     float font_height;       /* logical font height in pixels */
     /* optional; when NULL, draw_text/text_width are used */
     const iui_vector_t *vector;
+    /* optional capacities, carved from @buffer behind the context; 0 selects
+     * the IUI_MAX_BOX_DEPTH/IUI_MAX_BOX_CHILDREN/IUI_ID_STACK_SIZE/
+     * IUI_CLIP_STACK_SIZE/IUI_MAX_WINDOWS/IUI_MAX_BLOCKING_REGIONS/
+     * IUI_MAX_INPUT_EVENTS/IUI_MAX_WIDGET_STATES/
+     * IUI_MAX_FOCUSABLE_WIDGETS/IUI_SCROLL_STACK_SIZE default;
+     * max_tracked_fields sizes both the text field and the slider set
+     * (default IUI_MAX_TRACKED_TEXTFIELDS/IUI_MAX_TRACKED_SLIDERS)
+     */
+    int max_box_depth, max_box_children;
+    int id_stack_size, clip_stack_size;
+    int max_windows, max_blocking_regions;
+    int max_input_events;
+    int max_widget_states; /* widgets with live press/hover transitions */
+    int max_focusable;     /* focusable widgets registered per frame */
+    int max_tracked_fields; /* text fields and sliders tracked per frame */
+    int max_scroll_depth;   /* scroll regions open inside another one */
+    /* optional tables, off unless the IUI_WIDGET_MAP_SIZE/
+     * IUI_GLYPH_CACHE_POINTS/IUI_PARAGRAPH_CACHE_SIZE default is raised;
+     * 0 selects that default, a negative value turns the table off
+     */
+    int max_widget_map;     /* interactive widgets hit-tested per frame */
+    int glyph_cache_points; /* outline cache points (at most UINT16_MAX) */
+    int max_paragraphs;     /* paragraphs with memoized line breaks */
 } iui_config_t;
 
 typedef struct iui_context iui_context;
@@ -731,9 +854,16 @@ extern "C" {
 #endif
 
 /* Returns the number of bytes needed to allocate a iui_context and its buffer
+ * with the default capacities, the same as a zero-filled iui_config_t
  */
 size_t iui_min_memory_size(void);
 
+/* Same as iui_min_memory_size() for the capacities in @config (NULL or
+ * zero fields select the defaults). The buffer passed to iui_init must be at
+ * least this large; iui_init rejects a smaller nonzero buffer_size.
+ */
+size_t iui_min_memory_size_for(const iui_config_t *config);
+
 /* Initializes the library
  * @config: configuration containing all required parameters
  *
@@ -784,6 +914,43 @@ void iui_update_mouse_buttons(iui_context *ctx,
                               uint8_t pressed,
                               uint8_t released);
 
+/* Timestamped input events
+ * Every iui_update_* call is also recorded in a per-frame queue (capacity
+ * iui_config_t.max_input_events), so keystrokes and characters arriving
+ * faster than the frame rate are not lost: focused text fields replay the
+ * queued key and char events in order. Consecutive motion events coalesce
+ * into one entry. iui_end_frame() empties the queue.
+ */
+typedef enum iui_event_type {
+    IUI_EVENT_KEY = 1, /* @code: iui_key_code_t */
+    IUI_EVENT_CHAR,    /* @code: Unicode codepoint */
+    IUI_EVENT_BUTTON,  /* @pressed/@released: iui_mouse_button_t edges */
+    IUI_EVENT_MOTION,  /* @x/@y: pointer position */
+    IUI_EVENT_SCROLL,  /* @x/@y: wheel delta */
+} iui_event_type_t;
+
+typedef struct {
+    uint8_t type;              /* iui_event_type_t */
+    uint8_t modifiers;         /* iui_modifier_t flags at the event */
+    uint8_t pressed, released; /* IUI_EVENT_BUTTON */
+    int code;                  /* IUI_EVENT_KEY, IUI_EVENT_CHAR */
+    float x, y;                /* IUI_EVENT_MOTION, IUI_EVENT_SCROLL */
+    uint32_t time_ms;          /* platform timestamp in milliseconds */
+} iui_input_event;
+
+/* Applies @event like the matching iui_update_* call (including its
+ * modifiers) and queues it with its timestamp. Events pushed through the
+ * iui_update_* functions carry the latest timestamp seen here.
+ * Returns false when nothing was queued (queue full, or an empty key, char,
+ * button or scroll event): the per-frame input state is still updated, but
+ * only the most recent key and character of the frame reach text fields.
+ */
+bool iui_push_event(iui_context *ctx, const iui_input_event *event);
+
+/* Events queued since the last iui_end_frame(), oldest first */
+int iui_event_count(const iui_context *ctx);
+const iui_input_event *iui_event_get(const iui_context *ctx, int index);
+
 /* Theme API
  * Returns pointer to the current theme (can be modified directly for custom
  * colors)
@@ -817,7 +984,9 @@ void iui_pop_id(iui_context *ctx);
 
 /* Box container layout (nestable, flexbox-like)
  * Supports FIXED, GROW, and PERCENT sizing with min/max constraints.
- * Nests up to IUI_MAX_BOX_DEPTH levels. Gap and padding snap to 4dp grid.
+ * Nests up to iui_config_t.max_box_depth levels (IUI_MAX_BOX_DEPTH by
+ * default), each with up to max_box_children children. Gap and padding snap
+ * to 4dp grid.
  *
  * Usage:
  *   iui_sizing_t sizes[] = { IUI_FIXED(200), IUI_GROW(1) };
@@ -874,6 +1043,29 @@ void iui_text(iui_context *ctx,
               const char *string,
               ...);
 
+/* Paragraph layout options for iui_text_paragraph */
+typedef struct {
+    iui_text_alignment_t alignment; /* per-line alignment */
+    int max_lines;                  /* 0 = unlimited */
+    bool ellipsis; /* end the last line with "..." when text is cut off */
+} iui_paragraph_options;
+
+/* Displays word-wrapped text within the current layout width
+ * @ctx:     current UI context
+ * @text:    paragraph text; '\n' forces a line break
+ * @options: alignment and line limit (NULL = left aligned, unlimited)
+ *
+ * Lines are broken at spaces (mid-word only when a word does not fit) and
+ * advance the layout by row_height each. Line breaks are memoized by (text
+ * hash, width, font size) in a small LRU, so an unchanged paragraph is laid
+ * out without re-measuring; edits and resizes trigger a re-break. Lines past
+ * the cached ones of a very long paragraph are re-measured every frame.
+ * Returns the number of lines drawn.
+ */
+int iui_text_paragraph(iui_context *ctx,
+                       const char *text,
+                       const iui_paragraph_options *options);
+
 /* Moves the cursor to the next line, acts like a carriage return (CR) */
 void iui_newline(iui_context *ctx);
 
@@ -1014,10 +1206,49 @@ float iui_get_remaining_height(const iui_context *ctx);
 
 /* Reports minimum content width requirement for auto-sizing windows.
  * Widgets call this to indicate their required width.
- * The window will expand to fit if window_auto_width flag is set.
+ * The window will expand to fit if window_auto_width flag is set; open
+ * measure scopes record it as their content width.
  */
 void iui_require_content_width(iui_context *ctx, float width);
 
+/* Content measurement records
+ * A measure scope records the extent of the content laid out inside it under
+ * a caller-chosen ID. Records persist across frames, so a container can size
+ * itself to last frame's content before emitting it; a lookup is a hash
+ * probe, so steady-state frames do no extra layout work.
+ *
+ *   float w, h;
+ *   if (!iui_measured_size(ctx, id, &w, &h))
+ *       h = 120.f; // first frame: estimate
+ *   iui_box_begin(ctx, &(iui_box_config_t) {
+ *       .direction = IUI_DIR_COLUMN, .child_count = 2,
+ *       .sizes = (iui_sizing_t[]) {IUI_FIXED(h), IUI_GROW(1)}});
+ *   iui_box_next(ctx);
+ *   iui_measure_begin(ctx, id);
+ *   ... content ...
+ *   iui_measure_end(ctx);
+ *
+ * Height is the layout cursor advance between begin and end; width is the
+ * widest requirement reported through iui_require_content_width().
+ * Cards begun with h <= 0 measure themselves the same way. Scopes nest up to
+ * IUI_MEASURE_DEPTH levels; deeper scopes are counted but not recorded.
+ */
+void iui_measure_begin(iui_context *ctx, uint32_t id);
+
+/* Closes the innermost measure scope and stores its record.
+ * Returns true when the record changed, i.e. layout that used the previous
+ * value is one frame stale (event-driven apps should render another frame).
+ */
+bool iui_measure_end(iui_context *ctx);
+
+/* Last recorded content extent for @id
+ * Returns false (and leaves the outputs untouched) when nothing is recorded
+ */
+bool iui_measured_size(const iui_context *ctx,
+                       uint32_t id,
+                       float *width,
+                       float *height);
+
 /* Ends the current window. Must match iui_begin_window() */
 void iui_end_window(iui_context *ctx);
 
@@ -1027,10 +1258,30 @@ void iui_end_window(iui_context *ctx);
 void iui_end_frame(iui_context *ctx);
 
 /* Vector font text width measurement (uses built-in glyph table)
+ * Text is UTF-8; each non-ASCII codepoint measures as one box glyph.
  * Returns width in pixels at the given font height
  */
 float iui_text_width_vec(const char *text, float font_height);
 
+/* Extended glyph packs
+ * A pack adds glyphs beyond ASCII 0x20-0x7E to the built-in vector font
+ * (e.g. Latin-1, Greek, Cyrillic subsets). Layout, integers little-endian:
+ *   header  "IUGP", u16 version (1), u16 reserved, u32 glyph_count,
+ *           u32 data_size
+ *   index   glyph_count x {u32 codepoint, u32 offset}, sorted by codepoint
+ *   data    data_size bytes of glyph bytecode (same format as iui_vector_t)
+ * Packs are used in place: mmap() the file or link it as a const array
+ * (scripts/gen-glyph-pack.py produces both). Lookups binary-search the index
+ * on demand; nothing is parsed or copied, so the bytes must outlive the
+ * context. Packs are searched in attach order after the built-in font.
+ *
+ * Returns false if the header is malformed or all pack slots are in use.
+ */
+bool iui_glyph_pack_attach(iui_context *ctx, const void *data, size_t size);
+
+/* Detach all glyph packs; text falls back to the built-in font */
+void iui_glyph_pack_detach_all(iui_context *ctx);
+
 /* Draw a line from (x0, y0) to (x1, y1) with specified width and color
  * @ctx:     current UI context
  * @x0, @y0: start point coordinates
@@ -1141,12 +1392,40 @@ static inline float iui_ease_emphasized_decel(float t)
 }
 
 /* Component state helper functions
- * Get the current state of a component based on bounds and interaction
+ * Get the current state of a component based on bounds and interaction.
+ * Each call also records the widget's visible (clipped) bounds in a
+ * per-frame map under an ID derived from the window, the ID stack and the
+ * call's order within that scope; the next iui_begin_frame() resolves the
+ * single topmost widget under the pointer, and only that one hovers.
+ *
+ * The ID is positional, not taken from the label: a widget that is drawn
+ * only on some frames shifts the IDs of the widgets after it in its scope,
+ * which then lose hover and press feedback for a frame. Wrap conditionally
+ * drawn widgets in iui_push_id()/iui_pop_id(); ordinals restart inside the
+ * pushed scope, so the widgets after it keep their IDs either way:
+ *
+ *   if (show_advanced) {
+ *       iui_push_id(ctx, "advanced", 8);
+ *       iui_button(ctx, "Reset", IUI_ALIGN_LEFT);
+ *       iui_pop_id(ctx);
+ *   }
+ *   iui_button(ctx, "Apply", IUI_ALIGN_LEFT); // same ID on every frame
  */
 iui_state_t iui_get_component_state(iui_context *ctx,
                                     iui_rect_t bounds,
                                     bool disabled);
 
+/* Widget ID recorded by the latest iui_get_component_state() call; stable
+ * across frames while the widget order within its ID stack scope is
+ */
+uint32_t iui_last_component_id(const iui_context *ctx);
+
+/* Returns true if @id is the topmost interactive widget under the pointer,
+ * as resolved at the start of this frame. O(1); ids come from
+ * iui_last_component_id().
+ */
+bool iui_is_hot(const iui_context *ctx, uint32_t id);
+
 /* Get appropriate color for a component based on its state */
 uint32_t iui_get_state_color(iui_context *ctx,
                              iui_state_t state,
@@ -1308,6 +1587,7 @@ int iui_get_layer_depth(const iui_context *ctx);
  *     else
  *         iui_focus_next(ui);
  * }
+ * D-pad or arrow keys: iui_focus_move(ui, IUI_FOCUS_DOWN) and so on.
  *
  * Widgets automatically register for focus and show focus ring when
  * focused. Use iui_has_focus() to check if a specific widget has focus.
@@ -1330,6 +1610,21 @@ void iui_focus_next(iui_context *ctx);
 /* Move focus to the previous focusable widget (Shift+Tab) */
 void iui_focus_prev(iui_context *ctx);
 
+typedef enum iui_focus_dir {
+    IUI_FOCUS_LEFT,
+    IUI_FOCUS_RIGHT,
+    IUI_FOCUS_UP,
+    IUI_FOCUS_DOWN,
+} iui_focus_dir_t;
+
+/* Move focus to the nearest focusable widget in @dir (D-pad, arrow keys).
+ * Candidates lie beyond the focused widget's center along @dir; the one with
+ * the smallest distance along @dir plus twice the sideways offset wins.
+ * Focus stays put when nothing lies in that direction. Resolved at
+ * iui_end_frame() like iui_focus_next().
+ */
+void iui_focus_move(iui_context *ctx, iui_focus_dir_t dir);
+
 /* Get the currently focused widget ID (0 if none) */
 uint32_t iui_get_focused_id(const iui_context *ctx);
 
@@ -1792,6 +2087,61 @@ iui_textfield_result iui_textfield_with_selection(
     iui_edit_state *state,
     const iui_textfield_options *options);
 
+/* Gap-buffer text storage (see iui_text_buffer_t)
+ *
+ * Usage:
+ * static char storage[16384];
+ * static iui_text_buffer_t text;
+ * iui_text_buffer_init(&text, storage, sizeof(storage), "initial");
+ * ...
+ * iui_textfield_buffer(ctx, &text, &opts);
+ * iui_text_buffer_copy(&text, out, sizeof(out));  // contiguous copy
+ */
+
+/* Attach @storage and fill it with @text (NULL = empty), cursor at the end.
+ * Returns false if @text was truncated to fit.
+ */
+bool iui_text_buffer_init(iui_text_buffer_t *tb,
+                          char *storage,
+                          size_t capacity,
+                          const char *text);
+
+/* Text length in bytes, without scanning */
+size_t iui_text_buffer_length(const iui_text_buffer_t *tb);
+
+/* Move the cursor to byte offset @pos (clamped, snapped back to the start of
+ * a UTF-8 sequence). Costs the distance moved.
+ */
+void iui_text_buffer_move(iui_text_buffer_t *tb, size_t pos);
+
+/* Insert @n bytes at the cursor and move past them; false if out of room */
+bool iui_text_buffer_insert(iui_text_buffer_t *tb, const char *text, size_t n);
+
+/* Delete up to @before bytes before and @after bytes after the cursor */
+void iui_text_buffer_erase(iui_text_buffer_t *tb, size_t before, size_t after);
+
+/* Copy the text, NUL-terminated, into @out. Returns the full text length. */
+size_t iui_text_buffer_copy(const iui_text_buffer_t *tb,
+                            char *out,
+                            size_t size);
+
+/* TextField editing a gap buffer; otherwise behaves like iui_textfield.
+ * The text is drawn as the two runs around the gap, each terminated in
+ * place, so neither editing nor rendering moves the rest of the text.
+ */
+iui_textfield_result iui_textfield_buffer(iui_context *ctx,
+                                          iui_text_buffer_t *tb,
+                                          const iui_textfield_options *options);
+
+/* Gap-buffer counterpart of iui_textfield_with_selection. state->cursor and
+ * the selection are text offsets; edits move the gap to the cursor first.
+ */
+iui_textfield_result iui_textfield_buffer_with_selection(
+    iui_context *ctx,
+    iui_text_buffer_t *tb,
+    iui_edit_state *state,
+    const iui_textfield_options *options);
+
 /* Switch (Toggle) with Icons */
 bool iui_switch(iui_context *ctx,
                 const char *label,
@@ -1799,7 +2149,11 @@ bool iui_switch(iui_context *ctx,
                 const char *on_icon,   /* optional: "check" glyph */
                 const char *off_icon); /* optional: "x" glyph */
 
-/* Card Container functions */
+/* Card Container functions
+ * A card begun with h <= 0 takes its height from the content measured inside
+ * it on the previous frame (see iui_measure_begin); iui_card_end closes that
+ * measurement.
+ */
 void iui_card_begin(iui_context *ctx,
                     float x,
                     float y,
@@ -2033,6 +2387,140 @@ void iui_table_row_end(iui_context *ctx, iui_table_state *state);
  */
 void iui_table_end(iui_context *ctx, iui_table_state *state);
 
+/* Data-source mode for large tables
+ * Instead of emitting every row, the application supplies the row count and
+ * a callback that formats one cell. Rows scroll below the headers, which stay
+ * put, and only rows inside the viewport are formatted and drawn.
+ *
+ * Formatted text is optionally cached in caller memory keyed by (row, column,
+ * version); bump the version whenever the underlying data changes. A cache
+ * with at least as many entries as visible cells never evicts while idle.
+ *
+ * Usage:
+ * static iui_table_cache_entry cache[256];
+ * static iui_scroll_state rows_scroll = {0};
+ * iui_table_source src = {
+ *     .row_count = sample_count, .cell = format_sample, .user = samples,
+ *     .version = samples_version, .cache = cache, .cache_size = 256,
+ * };
+ * iui_table_begin(ctx, &table, 2, (float[]){-1, 100});
+ * iui_table_header(ctx, &table, "Time");
+ * iui_table_header(ctx, &table, "Value");
+ * iui_table_rows(ctx, &table, &rows_scroll, 400.f, &src);
+ * iui_table_end(ctx, &table);
+ */
+
+/* Cell formatter: write the text of (@row, @col) into @buf of @size bytes */
+typedef void (*iui_table_cell_func_t)(int row,
+                                      int col,
+                                      char *buf,
+                                      size_t size,
+                                      void *user);
+
+/* One cached cell; zero-initialized entries are empty */
+typedef struct {
+    int row, col;     /* cell coordinates, row 0 = first data row */
+    uint32_t version; /* source version the text was formatted for */
+    bool valid;
+    char text[IUI_TABLE_CACHE_TEXT];
+} iui_table_cache_entry;
+
+typedef struct {
+    int row_count;              /* total data rows */
+    iui_table_cell_func_t cell; /* cell formatter */
+    void *user;                 /* passed to the formatter */
+    uint32_t version;           /* bump to invalidate cached text */
+    iui_table_cache_entry *cache; /* optional text cache (NULL = none) */
+    int cache_size;               /* entries in cache */
+} iui_table_source;
+
+/* Render the data rows of @src in a scroll region of @height below the
+ * headers; call after the last iui_table_header instead of the row/cell
+ * calls.
+ * @ctx:    current UI context
+ * @state:  table state from iui_table_begin
+ * @scroll: scroll state for the rows (user-provided)
+ * @height: viewport height (0 = fill available, -N = fill minus N)
+ * @src:    row count, cell formatter and optional cache
+ */
+void iui_table_rows(iui_context *ctx,
+                    iui_table_state *state,
+                    iui_scroll_state *scroll,
+                    float height,
+                    const iui_table_source *src);
+
+/* Table model: sorted and filtered view over a table's rows
+ * Keeps a stable sort permutation and a filter bitmap in caller storage, so
+ * no per-frame rebuild is needed. The model never allocates; rows are
+ * identified by their source index and compared through callbacks.
+ *
+ * Usage:
+ * static int storage[IUI_TABLE_MODEL_STORAGE(MAX_ROWS)];
+ * static iui_table_model model;
+ * iui_table_model_init(&model, storage, MAX_ROWS, compare, keep, data);
+ * ...
+ * iui_table_model_sync(&model, &table, row_count); // each frame
+ * if (query_changed)
+ *     iui_table_model_filter(&model, query_extended);
+ * src.row_count = model.visible_count;
+ * src.version = model.version;
+ * // formatter: source row = iui_table_model_row(&model, row)
+ */
+
+/* Storage (in ints) for a model of @n rows: order, scratch, visible, bitmap */
+#define IUI_TABLE_MODEL_STORAGE(n) (3 * (n) + ((n) + 31) / 32)
+
+/* Row comparison for column @col: <0, 0 or >0 as row @a sorts before, with
+ * or after row @b in ascending order
+ */
+typedef int (*iui_table_compare_func_t)(int a, int b, int col, void *user);
+
+/* Filter predicate: true to show row @row */
+typedef bool (*iui_table_filter_func_t)(int row, void *user);
+
+typedef struct {
+    int *order;         /* all rows in sort order */
+    int *scratch;       /* merge buffer */
+    int *visible;       /* rows passing the filter, in sort order */
+    uint32_t *passes;   /* filter bitmap by source row */
+    int capacity;       /* rows the storage can hold */
+    int row_count;      /* rows merged into order */
+    int filtered_count; /* rows with a current filter bit */
+    int visible_count;  /* entries in visible */
+    int sort_column;    /* -1 = source order */
+    bool sort_ascending;
+    uint32_t version; /* bumped whenever visible changes */
+    iui_table_compare_func_t compare;
+    iui_table_filter_func_t filter; /* NULL = show every row */
+    void *user;                     /* passed to both callbacks */
+} iui_table_model;
+
+/* Attach caller storage of IUI_TABLE_MODEL_STORAGE(@capacity) ints */
+bool iui_table_model_init(iui_table_model *m,
+                          int *storage,
+                          int capacity,
+                          iui_table_compare_func_t compare,
+                          iui_table_filter_func_t filter,
+                          void *user);
+
+/* Bring the model up to date with the table's sort settings and the current
+ * row count (clamped to the capacity). Appended rows are sorted on their own
+ * and merged in; only a sort change or shrinking re-sorts everything.
+ */
+void iui_table_model_sync(iui_table_model *m,
+                          const iui_table_state *state,
+                          int row_count);
+
+/* Re-run the filter predicate after its criteria changed
+ * @narrowing: true if every row hidden before is still hidden (for example,
+ *             characters appended to a substring query); only rows visible
+ *             now are re-tested
+ */
+void iui_table_model_filter(iui_table_model *m, bool narrowing);
+
+/* Source row shown at visible position @index, or -1 */
+int iui_table_model_row(const iui_table_model *m, int index);
+
 /* Scrollable Container
  * Creates a scrollable viewport using the existing clip stack.
  * Content rendered between begin/end is clipped and offset by scroll position.
@@ -2049,6 +2537,11 @@ void iui_table_end(iui_context *ctx, iui_table_state *state);
  * Mouse wheel input via iui_update_scroll() adjusts scroll_y automatically.
  * For momentum scrolling, update velocity_y in the game loop and call
  * iui_scroll_by().
+ *
+ * Regions nest up to max_scroll_depth (iui_config_t) levels inside another,
+ * e.g. a horizontal carousel inside a vertical feed. Wheel input goes to the
+ * innermost region under the mouse that can scroll along each axis, as laid
+ * out on the previous frame.
  */
 
 /* Begin a scrollable region with the given viewport size
@@ -2065,6 +2558,57 @@ iui_rect_t iui_scroll_begin(iui_context *ctx,
  */
 bool iui_scroll_end(iui_context *ctx, iui_scroll_state *state);
 
+/* Declare a hash of whatever decides the open region's content size (item
+ * count, item sizes, labels). While it matches the hash of the last
+ * measurement, iui_scroll_end keeps that content size instead of measuring
+ * again, and this returns true: the caller may then skip content outside the
+ * viewport. Regions that never declare a hash are measured every frame.
+ */
+bool iui_scroll_content_hash(iui_context *ctx,
+                             iui_scroll_state *state,
+                             uint32_t hash);
+
+/* Cached scroll region state (user-provided, zero-initialized)
+ * Commands drawn in the region are hashed per band of content rows (64px
+ * unless IUI_SCROLL_LAYER_BAND is overridden).
+ * Cached pixels are offered for reuse only while the offset is changing and
+ * the bands visible in this frame and the last one hashed the same. So that
+ * the decision rests on this frame's hashes, such a frame is recorded into
+ * @record (caller storage of @record_cap words, enough for one frame of the
+ * region's commands) and reaches the port at iui_scroll_end. Without it, or
+ * when a frame does not fit, the layer is redrawn in full. The other fields
+ * are managed by iui_scroll_begin_cached and iui_scroll_end.
+ */
+typedef struct {
+    uint32_t *record; /* command record (optional) */
+    int record_cap;   /* words in record */
+    int record_len;   /* words recorded this frame */
+    iui_renderer_t target;             /* port renderer, wrapped meanwhile */
+    const iui_vector_t *target_vector; /* port vector callbacks */
+    iui_vector_t vector;               /* hashing vector wrappers */
+    iui_rect_t viewport;               /* viewport of the current frame */
+    float scroll_y, prev_scroll_y;     /* offsets of this and the last frame */
+    float font_height;                 /* extent of draw_text commands */
+    float pen_y;                       /* last vector path point */
+    uint32_t pen;                      /* hash of the open text run */
+    int band, prev_band;               /* content band of hash[0] */
+    uint32_t hash[IUI_SCROLL_LAYER_TILES];
+    uint32_t prev_hash[IUI_SCROLL_LAYER_TILES];
+    bool stable;    /* bands seen in both of the last two frames matched */
+    bool active;    /* the port accepted the layer this frame */
+    bool recording; /* commands are recorded until the region closes */
+} iui_scroll_layer;
+
+/* Like iui_scroll_begin, but lets a port with layer_begin/layer_end keep the
+ * content rasterized offscreen and redraw only newly exposed rows. Without
+ * those callbacks it behaves exactly like iui_scroll_begin.
+ */
+iui_rect_t iui_scroll_begin_cached(iui_context *ctx,
+                                   iui_scroll_state *state,
+                                   float view_w,
+                                   float view_h,
+                                   iui_scroll_layer *layer);
+
 /* Scroll by a delta amount (for mouse wheel, touch drag, momentum) */
 void iui_scroll_by(iui_scroll_state *state, float dx, float dy);
 
@@ -2139,6 +2683,103 @@ bool iui_list_item_two_line(iui_context *ctx,
 /* List divider (inset by 16dp from left) */
 void iui_list_divider(iui_context *ctx);
 
+/* Virtualized List
+ * For lists of uniform-height items too long to emit every frame. Call inside
+ * a scroll region, then render only the returned items; the skipped head and
+ * tail cost nothing and the scroll extent still covers the whole list.
+ *
+ * Usage:
+ * iui_scroll_begin(ctx, &scroll, 0.f, 400.f);
+ * iui_list_range r = iui_list_virtual_begin(ctx, &scroll, row_count,
+ *                                           IUI_LIST_ONE_LINE_HEIGHT);
+ * for (int i = r.first; i < r.last; i++)
+ *     iui_list_item_simple(ctx, rows[i].name, NULL);
+ * iui_scroll_end(ctx, &scroll);
+ */
+
+/* Visible item range of a virtualized list: items [first, last) */
+typedef struct {
+    int first, last;
+} iui_list_range;
+
+/* Begin a virtualized list in the active scroll region
+ * @ctx:         current UI context
+ * @state:       scroll state passed to iui_scroll_begin
+ * @item_count:  total number of items
+ * @item_height: height every item advances the layout by
+ *
+ * Advances layout to the first visible item and sets state->content_h to
+ * cover all items. The list must be the last content of the region. Outside
+ * a scroll region the full range is returned.
+ */
+iui_list_range iui_list_virtual_begin(iui_context *ctx,
+                                      iui_scroll_state *state,
+                                      int item_count,
+                                      float item_height);
+
+/* Mixed-height virtualized lists keep a height index in caller memory: a
+ * Fenwick tree over item heights giving O(log n) index-to-offset and
+ * offset-to-index. Unmeasured items count as the estimate until rendered.
+ *
+ * Usage:
+ * static float storage[2 * MAX_ROWS];
+ * static iui_list_heights heights;
+ * iui_list_heights_init(&heights, storage, MAX_ROWS, 72.f); // once
+ * iui_list_heights_resize(&heights, row_count);
+ * iui_scroll_begin(ctx, &scroll, 0.f, 400.f);
+ * iui_list_range r = iui_list_virtual_begin_var(ctx, &scroll, &heights);
+ * for (int i = r.first; i < r.last; i++) {
+ *     iui_list_item_ex(ctx, rows[i].type, &rows[i].item);
+ *     iui_list_virtual_measure(ctx, &heights, i);
+ * }
+ * iui_scroll_end(ctx, &scroll);
+ */
+typedef struct {
+    float *tree;        /* Fenwick sums (capacity entries) */
+    float *heights;     /* height of each item (capacity entries) */
+    int capacity;       /* items the storage can index */
+    int count;          /* items currently indexed */
+    float estimate;     /* height assumed for new items */
+    int anchor;         /* first visible item of the last list */
+    float anchor_shift; /* height change above the anchor, not yet applied */
+    float cursor_y;     /* layout y where the next measured item starts */
+} iui_list_heights;
+
+/* Attach caller storage of 2 * @capacity floats; the index starts empty */
+bool iui_list_heights_init(iui_list_heights *h,
+                           float *storage,
+                           int capacity,
+                           float estimate);
+
+/* Grow or shrink to @count items; new items take the estimate.
+ * Returns false if @count exceeds the capacity.
+ */
+bool iui_list_heights_resize(iui_list_heights *h, int count);
+
+/* Record the height of item @index */
+void iui_list_heights_set(iui_list_heights *h, int index, float height);
+
+/* Distance from the list top to item @index (@index == count: total) */
+float iui_list_heights_offset(const iui_list_heights *h, int index);
+
+/* Item covering @offset from the list top, clamped to [0, count - 1] */
+int iui_list_heights_find(const iui_list_heights *h, float offset);
+
+/* Like iui_list_virtual_begin, for items of differing heights
+ * Height corrections above the first visible item since the last call are
+ * folded into state->scroll_y so the visible items stay put.
+ */
+iui_list_range iui_list_virtual_begin_var(iui_context *ctx,
+                                          iui_scroll_state *state,
+                                          iui_list_heights *h);
+
+/* Learn the height of item @index from the layout advance since the
+ * previous item; call right after rendering each item of the range.
+ */
+void iui_list_virtual_measure(iui_context *ctx,
+                              iui_list_heights *h,
+                              int index);
+
 /* Navigation Rail Component
  * Vertical navigation for medium-to-large screens (tablet/desktop)
  * Reference: https://m3.material.io/components/navigation-rail
@@ -3205,6 +3846,9 @@ int iui_a11y_describe(const iui_a11y_hint *hint, char *buf, size_t buf_size);
  * 2. Dirty Rectangle Tracking - skips redrawing unchanged regions
  * 3. Text Width Caching - caches text measurement results
  *
+ * Box layouts are additionally memoized (always on); iui_get_frame_stats()
+ * reports how often that cache was hit.
+ *
  * Usage:
  * iui_batch_enable(ctx, true);      // Enable draw batching
  * iui_dirty_enable(ctx, true);      // Enable dirty rect tracking
@@ -3258,6 +3902,15 @@ void iui_text_cache_clear(iui_context *ctx);
 /* Query text cache statistics */
 void iui_text_cache_stats(const iui_context *ctx, int *hits, int *misses);
 
+/* Per-frame statistics, reset by iui_begin_frame() */
+typedef struct {
+    int box_cache_hits;   /* box layouts reused from the size cache */
+    int box_cache_misses; /* box layouts resolved from scratch */
+} iui_frame_stats;
+
+/* Query counters accumulated since the last iui_begin_frame() */
+void iui_get_frame_stats(const iui_context *ctx, iui_frame_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
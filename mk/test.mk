@@ -28,8 +28,13 @@ ifneq ($(filter check check-unit check-headless libiui_test,$(MAKECMDGOALS)),)
     CONFIG_PORT_HEADLESS := y
     CONFIG_CONFIGURED := y
 
+    # Optional features tested on request, e.g.
+    # 'make check CONFIG_FEATURE_FONT_ATLAS=y'
+    TEST_CONFIG_EXTRA := $(if $(filter y,$(CONFIG_FEATURE_FONT_ATLAS)),\
+        CONFIG_FEATURE_FONT_ATLAS=y)
+
     # Use isolated build directory for tests
-    TEST_BUILD_DIR := .build/test
+    TEST_BUILD_DIR := .build/test$(if $(TEST_CONFIG_EXTRA),-extra)
     TEST_CONFIG_HEADER := $(TEST_BUILD_DIR)/iui_config.h
 endif
 
@@ -90,16 +95,18 @@ TEST_OBJS := $$(patsubst tests/%.c,$$(TEST_BUILD_DIR)/%.o,$$(TEST_SRCS))
 # This avoids conflicts with user's src/iui_config.h from their .config
 $$(TEST_CONFIG_HEADER): $$(KCONFIG_DIR)/defconfig.py $$(KCONFIG_DIR)/genconfig.py | $$(TEST_BUILD_DIR)
 	@echo "  GEN     $$@ (test configuration)"
-	@KCONFIG_CONFIG=.config.test python3 $$(KCONFIG_DIR)/defconfig.py --kconfig $$(KCONFIG) configs/defconfig
+	@cp configs/defconfig .config.test.in
+	@$$(foreach opt,$$(TEST_CONFIG_EXTRA),echo '$$(opt)' >> .config.test.in;)
+	@KCONFIG_CONFIG=.config.test python3 $$(KCONFIG_DIR)/defconfig.py --kconfig $$(KCONFIG) .config.test.in
 	@KCONFIG_CONFIG=.config.test python3 $$(KCONFIG_DIR)/genconfig.py --header-path $$@ $$(KCONFIG)
-	@rm -f .config.test
+	@rm -f .config.test .config.test.in
 
 # Compile rules for test build directory (isolated from main build)
 # -I$$(TEST_BUILD_DIR) first ensures test config header takes priority
 # -DIUI_MD3_RUNTIME_VALIDATION enables runtime validation of rendered dimensions
 TEST_CFLAGS := $$(CFLAGS) -DIUI_MD3_RUNTIME_VALIDATION
 
-$$(TEST_BUILD_DIR)/%.o: src/%.c $$(TEST_CONFIG_HEADER) | $$(TEST_BUILD_DIR) $$(MD3_GENERATED)
+$$(TEST_BUILD_DIR)/%.o: src/%.c $$(TEST_CONFIG_HEADER) | $$(TEST_BUILD_DIR) $$(MD3_GENERATED) $$(FONT_ATLAS_GEN)
 	@echo "  CC      $$< (test)"
 	$$(Q)$$(CC) $$(TEST_CFLAGS) -MMD -MP -MF $$(TEST_BUILD_DIR)/$$(notdir $$*).d \
 	    -I$$(TEST_BUILD_DIR) -Iinclude -Isrc -Itests -Iports -Iexternals \
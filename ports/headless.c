@@ -83,6 +83,9 @@ struct iui_port_ctx {
 
     /* Vector path state (shared with port-sw.h) */
     iui_path_state_t path;
+
+    /* Offscreen rows for the cached scroll region (allocated on first use) */
+    iui_raster_layer_t layer;
 #endif
 
     /* Statistics tracking */
@@ -124,6 +127,20 @@ struct iui_port_ctx {
 
 /* Renderer Callbacks */
 
+#if HEADLESS_ENABLE_FRAMEBUFFER
+/* Drawing target: the cached scroll layer while one is open */
+static inline iui_raster_ctx_t *headless_raster(iui_port_ctx *ctx)
+{
+    return ctx->layer.active ? &ctx->layer.raster : &ctx->raster;
+}
+
+/* Screen-to-target y offset matching headless_raster */
+static inline float headless_dy(const iui_port_ctx *ctx)
+{
+    return ctx->layer.active ? (float) ctx->layer.dy : 0.f;
+}
+#endif
+
 static void headless_draw_box(iui_rect_t rect,
                               float radius,
                               uint32_t srgb_color,
@@ -134,7 +151,8 @@ static void headless_draw_box(iui_rect_t rect,
 
 #if HEADLESS_ENABLE_FRAMEBUFFER
     if (ctx->framebuffer)
-        iui_raster_rounded_rect(&ctx->raster, rect.x, rect.y, rect.width,
+        iui_raster_rounded_rect(headless_raster(ctx), rect.x,
+                                rect.y + headless_dy(ctx), rect.width,
                                 rect.height, radius, srgb_color);
 #else
     (void) rect;
@@ -153,8 +171,10 @@ static void headless_set_clip_rect(uint16_t min_x,
     ctx->stats.set_clip_calls++;
 
 #if HEADLESS_ENABLE_FRAMEBUFFER
-    if (min_x == 0 && min_y == 0 && max_x == UINT16_MAX &&
-        max_y == UINT16_MAX) {
+    if (ctx->layer.active) {
+        iui_raster_layer_clip(&ctx->layer, min_x, min_y, max_x, max_y);
+    } else if (min_x == 0 && min_y == 0 && max_x == UINT16_MAX &&
+               max_y == UINT16_MAX) {
         iui_raster_reset_clip(&ctx->raster);
     } else {
         iui_raster_set_clip(&ctx->raster, min_x, min_y, max_x, max_y);
@@ -179,8 +199,11 @@ static void headless_draw_line(float x0,
     ctx->stats.draw_line_calls++;
 
 #if HEADLESS_ENABLE_FRAMEBUFFER
-    if (ctx->framebuffer)
-        iui_raster_line(&ctx->raster, x0, y0, x1, y1, width, srgb_color);
+    if (ctx->framebuffer) {
+        float dy = headless_dy(ctx);
+        iui_raster_line(headless_raster(ctx), x0, y0 + dy, x1, y1 + dy, width,
+                        srgb_color);
+    }
 #else
     (void) x0;
     (void) y0;
@@ -204,10 +227,12 @@ static void headless_draw_circle(float cx,
 
 #if HEADLESS_ENABLE_FRAMEBUFFER
     if (ctx->framebuffer) {
+        iui_raster_ctx_t *r = headless_raster(ctx);
+        cy += headless_dy(ctx);
         if (fill_color != 0)
-            iui_raster_circle_fill(&ctx->raster, cx, cy, radius, fill_color);
+            iui_raster_circle_fill(r, cx, cy, radius, fill_color);
         if (stroke_color != 0 && stroke_width > 0.f)
-            iui_raster_circle_stroke(&ctx->raster, cx, cy, radius, stroke_width,
+            iui_raster_circle_stroke(r, cx, cy, radius, stroke_width,
                                      stroke_color);
     }
 #else
@@ -234,8 +259,8 @@ static void headless_draw_arc(float cx,
 
 #if HEADLESS_ENABLE_FRAMEBUFFER
     if (ctx->framebuffer)
-        iui_raster_arc(&ctx->raster, cx, cy, radius, start_angle, end_angle,
-                       width, srgb_color);
+        iui_raster_arc(headless_raster(ctx), cx, cy + headless_dy(ctx), radius,
+                       start_angle, end_angle, width, srgb_color);
 #else
     (void) cx;
     (void) cy;
@@ -249,11 +274,25 @@ static void headless_draw_arc(float cx,
 
 /* Vector Font Callbacks */
 
+#if HEADLESS_ENABLE_FRAMEBUFFER
+/* Stroke a text run early when the path buffer cannot take more points */
+static void headless_path_reserve(iui_port_ctx *ctx)
+{
+    if (!iui_path_run_full(&ctx->path))
+        return;
+    if (ctx->framebuffer)
+        iui_raster_path_stroke(headless_raster(ctx), &ctx->path,
+                               ctx->path.run_width, ctx->path.run_color);
+    iui_path_run_continue(&ctx->path);
+}
+#endif
+
 static void headless_path_move(float x, float y, void *user)
 {
     iui_port_ctx *ctx = (iui_port_ctx *) user;
 #if HEADLESS_ENABLE_FRAMEBUFFER
-    iui_path_move_to(&ctx->path, x, y);
+    headless_path_reserve(ctx);
+    iui_path_move_to(&ctx->path, x, y + headless_dy(ctx));
 #else
     (void) ctx;
     (void) x;
@@ -265,7 +304,8 @@ static void headless_path_line(float x, float y, void *user)
 {
     iui_port_ctx *ctx = (iui_port_ctx *) user;
 #if HEADLESS_ENABLE_FRAMEBUFFER
-    iui_path_line_to(&ctx->path, x, y);
+    headless_path_reserve(ctx);
+    iui_path_line_to(&ctx->path, x, y + headless_dy(ctx));
 #else
     (void) ctx;
     (void) x;
@@ -283,7 +323,9 @@ static void headless_path_curve(float x1,
 {
     iui_port_ctx *ctx = (iui_port_ctx *) user;
 #if HEADLESS_ENABLE_FRAMEBUFFER
-    iui_path_curve_to(&ctx->path, x1, y1, x2, y2, x3, y3);
+    headless_path_reserve(ctx);
+    float dy = headless_dy(ctx);
+    iui_path_curve_to(&ctx->path, x1, y1 + dy, x2, y2 + dy, x3, y3 + dy);
 #else
     (void) ctx;
     (void) x1;
@@ -307,7 +349,7 @@ static void headless_path_stroke(float width, uint32_t color, void *user)
     }
 
     /* Use SDL2-compatible path stroke with round caps and consistent AA */
-    iui_raster_path_stroke(&ctx->raster, &ctx->path, width, color);
+    iui_raster_path_stroke(headless_raster(ctx), &ctx->path, width, color);
     iui_path_reset(&ctx->path);
 #else
     (void) width;
@@ -315,6 +357,96 @@ static void headless_path_stroke(float width, uint32_t color, void *user)
 #endif
 }
 
+static void headless_path_begin_run(float width, uint32_t color, void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+#if HEADLESS_ENABLE_FRAMEBUFFER
+    iui_path_begin_run(&ctx->path, width, color);
+#else
+    (void) ctx;
+    (void) width;
+    (void) color;
+#endif
+}
+
+/* Stroke every subpath of the run in one pass */
+static void headless_path_end_run(void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+    ctx->stats.path_stroke_calls++;
+
+#if HEADLESS_ENABLE_FRAMEBUFFER
+    if (ctx->framebuffer)
+        iui_raster_path_stroke(headless_raster(ctx), &ctx->path,
+                               ctx->path.run_width, ctx->path.run_color);
+    iui_path_end_run(&ctx->path);
+#endif
+}
+
+/* Blit one baked glyph from the font atlas */
+static void headless_draw_glyph_mask(int x,
+                                     int y,
+                                     const iui_glyph_mask_t *mask,
+                                     uint32_t color,
+                                     void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+#if HEADLESS_ENABLE_FRAMEBUFFER
+    if (ctx->framebuffer)
+        iui_raster_glyph_mask(headless_raster(ctx), x,
+                              y + (int) headless_dy(ctx), mask, color);
+#else
+    (void) ctx;
+    (void) x;
+    (void) y;
+    (void) mask;
+    (void) color;
+#endif
+}
+
+/* Cached scroll layer: rows twice the screen height, allocated on first use
+ * and again after the window width changes
+ */
+static bool headless_layer_begin(iui_rect_t viewport,
+                                 float scroll_y,
+                                 bool reuse,
+                                 void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+#if HEADLESS_ENABLE_FRAMEBUFFER
+    if (!ctx->framebuffer)
+        return false;
+    iui_raster_layer_t *l = &ctx->layer;
+    if (!l->raster.framebuffer || l->raster.width != ctx->width) {
+        free(l->raster.framebuffer);
+        int rows = ctx->height * 2;
+        size_t n = (size_t) ctx->width * (size_t) rows;
+        uint32_t *pixels = (uint32_t *) malloc(n * sizeof(uint32_t));
+        iui_raster_layer_init(l, pixels, pixels ? ctx->width : 0,
+                              pixels ? rows : 0);
+        if (!pixels)
+            return false;
+    }
+    return iui_raster_layer_begin(l, &ctx->raster, viewport, scroll_y, reuse);
+#else
+    (void) ctx;
+    (void) viewport;
+    (void) scroll_y;
+    (void) reuse;
+    return false;
+#endif
+}
+
+static void headless_layer_end(void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+#if HEADLESS_ENABLE_FRAMEBUFFER
+    iui_raster_layer_end(&ctx->layer, &ctx->raster);
+#else
+    (void) ctx;
+#endif
+}
+
 /* Port Interface Implementation (iui_port_t) */
 
 static iui_port_ctx *headless_init(int width, int height, const char *title)
@@ -368,6 +500,7 @@ static void headless_shutdown(iui_port_ctx *ctx)
         free(ctx->framebuffer);
         ctx->framebuffer = NULL;
     }
+    free(ctx->layer.raster.framebuffer);
 #endif
 
     free(ctx);
@@ -390,6 +523,8 @@ static void headless_configure(iui_port_ctx *ctx)
     ctx->render_ops.draw_line = headless_draw_line;
     ctx->render_ops.draw_circle = headless_draw_circle;
     ctx->render_ops.draw_arc = headless_draw_arc;
+    ctx->render_ops.layer_begin = headless_layer_begin;
+    ctx->render_ops.layer_end = headless_layer_end;
     ctx->render_ops.user = ctx;
 
     /* Initialize vector callbacks */
@@ -397,6 +532,9 @@ static void headless_configure(iui_port_ctx *ctx)
     ctx->vector_ops.path_line = headless_path_line;
     ctx->vector_ops.path_curve = headless_path_curve;
     ctx->vector_ops.path_stroke = headless_path_stroke;
+    ctx->vector_ops.path_begin_run = headless_path_begin_run;
+    ctx->vector_ops.path_end_run = headless_path_end_run;
+    ctx->vector_ops.draw_glyph_mask = headless_draw_glyph_mask;
 }
 
 static bool headless_poll_events(iui_port_ctx *ctx)
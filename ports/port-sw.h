@@ -4,6 +4,7 @@
  * Consolidated header providing:
  *   - Color manipulation and alpha blending (ARGB32)
  *   - Pixel-level drawing operations (rasterizer)
+ *   - Offscreen rows for cached scroll regions
  *   - Vector path tessellation (Bezier curves)
  *
  * Architecture:
@@ -22,7 +23,10 @@
  *      - Used by headless.c and wasm.c
  *      - NOT used by sdl2.c (uses SDL_Renderer instead)
  *
- *   3. Path state and Bezier tessellation (iui_path_*)
+ *   3. Cached scroll layers (iui_raster_layer_*)
+ *      - Offscreen rows for iui_renderer_t.layer_begin/layer_end
+ *
+ *   4. Path state and Bezier tessellation (iui_path_*)
  *      - Shared by ALL ports for vector font rendering
  *      - sdl2.c uses _scaled variants for HiDPI support
  *      - headless.c/wasm.c use unscaled variants
@@ -35,8 +39,10 @@
 #define IUI_PORT_SW_H
 
 #include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "port.h"
 
@@ -719,20 +725,225 @@ static inline void iui_raster_clear(iui_raster_ctx_t *r, uint32_t color)
         r->framebuffer[i] = color;
 }
 
+/* Blit a baked glyph coverage mask (A4 or A8) with its top-left at (x, y) */
+static inline void iui_raster_glyph_mask(iui_raster_ctx_t *r,
+                                         int x,
+                                         int y,
+                                         const iui_glyph_mask_t *m,
+                                         uint32_t color)
+{
+    const float inv_max = (m->bpp == 4) ? 1.0f / 15.0f : 1.0f / 255.0f;
+
+    for (int row = 0; row < m->height; row++) {
+        int py = y + row;
+        if (py < r->clip_min_y || py >= r->clip_max_y)
+            continue;
+        const uint8_t *src = m->pixels + (size_t) (m->y + row) * m->stride;
+        for (int col = 0; col < m->width; col++) {
+            int sx = m->x + col;
+            uint8_t v = (m->bpp == 4)
+                            ? (uint8_t) ((sx & 1) ? src[sx >> 1] & 0x0F
+                                                  : src[sx >> 1] >> 4)
+                            : src[sx];
+            if (!v)
+                continue;
+            if (v == ((m->bpp == 4) ? 0x0F : 0xFF))
+                iui_raster_pixel(r, x + col, py, color);
+            else
+                iui_raster_pixel_aa(r, x + col, py, color, v * inv_max);
+        }
+    }
+}
+
+/* Cached Scroll Layers */
+
+/* Offscreen rows backing one cached scroll region (iui_renderer_t.layer_*).
+ * The layer is as wide as the screen raster and taller than the viewport; it
+ * stores content rows [origin, origin + height). Rows in [valid_top,
+ * valid_bottom) hold pixels from earlier frames, so a scroll only redraws
+ * the rows it newly exposes. While active, drawing goes to @raster with
+ * screen y shifted by @dy.
+ */
+typedef struct {
+    iui_raster_ctx_t raster;     /* layer pixels */
+    iui_rect_t viewport;         /* viewport of the cached region */
+    int origin;                  /* content row stored in pixel row 0 */
+    int valid_top, valid_bottom; /* cached content rows */
+    int band_top, band_bottom;   /* content rows redrawn this frame */
+    int dy;                      /* screen y + dy = layer row */
+    bool active;
+} iui_raster_layer_t;
+
+static inline void iui_raster_layer_init(iui_raster_layer_t *l,
+                                         uint32_t *pixels,
+                                         int width,
+                                         int height)
+{
+    memset(l, 0, sizeof(*l));
+    iui_raster_init(&l->raster, pixels, width, height);
+}
+
+/* Move the stored window of content rows to start at @origin, keeping any
+ * cached rows that remain inside it
+ */
+static inline void iui_raster_layer_shift(iui_raster_layer_t *l, int origin)
+{
+    int h = l->raster.height;
+    int top = l->valid_top > origin ? l->valid_top : origin;
+    int bottom = l->valid_bottom < origin + h ? l->valid_bottom : origin + h;
+    if (bottom > top) {
+        size_t row = (size_t) l->raster.width;
+        memmove(l->raster.framebuffer + (size_t) (top - origin) * row,
+                l->raster.framebuffer + (size_t) (top - l->origin) * row,
+                (size_t) (bottom - top) * row * sizeof(uint32_t));
+        l->valid_top = top, l->valid_bottom = bottom;
+    } else {
+        l->valid_top = l->valid_bottom = 0;
+    }
+    l->origin = origin;
+}
+
+/* Start drawing scroll content into the layer. Returns false (draw directly)
+ * for fractional offsets or a viewport that is not whole pixels, fully inside
+ * the screen clip, or shorter than the layer.
+ */
+static inline bool iui_raster_layer_begin(iui_raster_layer_t *l,
+                                          const iui_raster_ctx_t *screen,
+                                          iui_rect_t viewport,
+                                          float scroll_y,
+                                          bool reuse)
+{
+    int vx = (int) viewport.x, vy = (int) viewport.y;
+    int vw = (int) viewport.width, vh = (int) viewport.height;
+    if (!l->raster.framebuffer || l->raster.width != screen->width ||
+        scroll_y != floorf(scroll_y) || scroll_y < 0.f ||
+        viewport.x != (float) vx || viewport.y != (float) vy ||
+        viewport.width != (float) vw || viewport.height != (float) vh ||
+        vh > l->raster.height || vx < screen->clip_min_x ||
+        vy < screen->clip_min_y || vx + vw > screen->clip_max_x ||
+        vy + vh > screen->clip_max_y)
+        return false;
+
+    bool same_view =
+        viewport.x == l->viewport.x && viewport.y == l->viewport.y &&
+        viewport.width == l->viewport.width &&
+        viewport.height == l->viewport.height;
+    if (!reuse || !same_view)
+        l->valid_top = l->valid_bottom = 0;
+    l->viewport = viewport;
+
+    /* Recenter the stored rows when the viewport leaves them */
+    int top = (int) scroll_y, bottom = top + vh;
+    if (top < l->origin || bottom > l->origin + l->raster.height) {
+        int origin = top - (l->raster.height - vh) / 2;
+        iui_raster_layer_shift(l, origin > 0 ? origin : 0);
+    }
+
+    /* Redraw what the cached rows do not cover; keep them one run of rows */
+    int vt = l->valid_top, vb = l->valid_bottom;
+    if (vb <= vt || bottom <= vt || top >= vb || (top < vt && bottom > vb)) {
+        l->band_top = top, l->band_bottom = bottom;
+        l->valid_top = l->valid_bottom = 0;
+    } else if (top < vt) {
+        l->band_top = top, l->band_bottom = vt;
+    } else if (bottom > vb) {
+        l->band_top = vb, l->band_bottom = bottom;
+    } else {
+        l->band_top = l->band_bottom = top;
+    }
+
+    /* Seed redrawn rows with the background already under the viewport */
+    size_t row = (size_t) screen->width;
+    l->dy = top - l->origin - vy;
+    for (int c = l->band_top; c < l->band_bottom; c++) {
+        memcpy(l->raster.framebuffer + (size_t) (c - l->origin) * row,
+               screen->framebuffer + (size_t) (c - top + vy) * row,
+               row * sizeof(uint32_t));
+    }
+
+    l->raster.pixels_drawn = screen->pixels_drawn;
+    l->raster.clip_min_x = vx;
+    l->raster.clip_max_x = vx + vw;
+    l->raster.clip_min_y = l->band_top - l->origin;
+    l->raster.clip_max_y = l->band_bottom - l->origin;
+    l->active = true;
+    return true;
+}
+
+/* Clip in screen coordinates while the layer is active; never reaches past
+ * the rows being redrawn
+ */
+static inline void iui_raster_layer_clip(iui_raster_layer_t *l,
+                                         int min_x,
+                                         int min_y,
+                                         int max_x,
+                                         int max_y)
+{
+    int vx = (int) l->viewport.x, vw = (int) l->viewport.width;
+    int band_min = l->band_top - l->origin;
+    int band_max = l->band_bottom - l->origin;
+    min_y += l->dy, max_y += l->dy;
+    iui_raster_set_clip(&l->raster, min_x > vx ? min_x : vx,
+                        min_y > band_min ? min_y : band_min,
+                        max_x < vx + vw ? max_x : vx + vw,
+                        max_y < band_max ? max_y : band_max);
+}
+
+/* Finish the layer and copy its visible rows into the screen viewport */
+static inline void iui_raster_layer_end(iui_raster_layer_t *l,
+                                        iui_raster_ctx_t *screen)
+{
+    if (!l->active)
+        return;
+    l->active = false;
+    screen->pixels_drawn = l->raster.pixels_drawn;
+
+    if (l->band_bottom > l->band_top) {
+        if (l->valid_bottom <= l->valid_top) {
+            l->valid_top = l->band_top, l->valid_bottom = l->band_bottom;
+        } else {
+            if (l->band_top < l->valid_top)
+                l->valid_top = l->band_top;
+            if (l->band_bottom > l->valid_bottom)
+                l->valid_bottom = l->band_bottom;
+        }
+    }
+
+    int vx = (int) l->viewport.x, vy = (int) l->viewport.y;
+    int vw = (int) l->viewport.width, vh = (int) l->viewport.height;
+    size_t row = (size_t) screen->width;
+    for (int y = vy; y < vy + vh; y++) {
+        memcpy(screen->framebuffer + (size_t) y * row + (size_t) vx,
+               l->raster.framebuffer + (size_t) (y + l->dy) * row +
+                   (size_t) vx,
+               (size_t) vw * sizeof(uint32_t));
+    }
+}
+
 /* Vector Path State and Bezier Tessellation */
 
-/* Vector path state container - embed in port context structure */
+/* Vector path state container - embed in port context structure.
+ * Outside a text run every move starts a fresh path. Inside a run
+ * (iui_path_begin_run) subpaths accumulate and subpath[] records where each
+ * one starts, so the backend strokes the whole string at once.
+ */
 typedef struct {
     float points_x[IUI_PORT_MAX_PATH_POINTS];
     float points_y[IUI_PORT_MAX_PATH_POINTS];
     int count;
     float pen_x, pen_y;
+    int subpath[IUI_PORT_MAX_SUBPATHS]; /* first point of each subpath */
+    int subpath_count;
+    bool in_run;
+    float run_width; /* stroke parameters of the active run */
+    uint32_t run_color;
 } iui_path_state_t;
 
-/* Initialize/reset path state */
+/* Initialize/reset path state (an active run stays open) */
 static inline void iui_path_reset(iui_path_state_t *p)
 {
     p->count = 0;
+    p->subpath_count = 0;
     p->pen_x = 0.0f;
     p->pen_y = 0.0f;
 }
@@ -742,9 +953,14 @@ static inline void iui_path_move_to(iui_path_state_t *p, float x, float y)
 {
     p->pen_x = x;
     p->pen_y = y;
-    p->count = 0;
+    if (!p->in_run) {
+        p->count = 0;
+        p->subpath_count = 0;
+    }
 
-    if (p->count < IUI_PORT_MAX_PATH_POINTS) {
+    if (p->count < IUI_PORT_MAX_PATH_POINTS &&
+        p->subpath_count < IUI_PORT_MAX_SUBPATHS) {
+        p->subpath[p->subpath_count++] = p->count;
         p->points_x[p->count] = x;
         p->points_y[p->count] = y;
         p->count++;
@@ -764,6 +980,57 @@ static inline void iui_path_line_to(iui_path_state_t *p, float x, float y)
     }
 }
 
+/* Number of subpaths; points added without a move form a single one */
+static inline int iui_path_subpaths(const iui_path_state_t *p)
+{
+    return p->subpath_count > 0 ? p->subpath_count : 1;
+}
+
+/* Point range [*start, *end) of subpath s */
+static inline void iui_path_subpath_range(const iui_path_state_t *p,
+                                          int s,
+                                          int *start,
+                                          int *end)
+{
+    *start = p->subpath_count > 0 ? p->subpath[s] : 0;
+    *end = (s + 1 < p->subpath_count) ? p->subpath[s + 1] : p->count;
+}
+
+/* Text runs: begin accumulating subpaths for one stroke */
+static inline void iui_path_begin_run(iui_path_state_t *p,
+                                      float width,
+                                      uint32_t color)
+{
+    iui_path_reset(p);
+    p->in_run = true;
+    p->run_width = width;
+    p->run_color = color;
+}
+
+/* True when a run cannot take another curve or subpath; the port should
+ * stroke what it has and call iui_path_run_continue().
+ */
+static inline bool iui_path_run_full(const iui_path_state_t *p)
+{
+    return p->in_run && (p->count + 12 >= IUI_PORT_MAX_PATH_POINTS ||
+                         p->subpath_count >= IUI_PORT_MAX_SUBPATHS);
+}
+
+/* Restart a flushed run, continuing the current subpath from the pen */
+static inline void iui_path_run_continue(iui_path_state_t *p)
+{
+    float x = p->pen_x, y = p->pen_y;
+    iui_path_reset(p);
+    iui_path_move_to(p, x, y);
+}
+
+/* Close a run; the caller strokes the accumulated path first */
+static inline void iui_path_end_run(iui_path_state_t *p)
+{
+    p->in_run = false;
+    iui_path_reset(p);
+}
+
 /* Add cubic Bezier curve using adaptive tessellation
  * Control points: p0 (current pen), p1 (x1,y1), p2 (x2,y2), p3 (x3,y3)
  */
@@ -902,16 +1169,20 @@ static inline void iui_raster_path_stroke(iui_raster_ctx_t *r,
      * Capsule geometry inherently provides round caps at endpoints,
      * so no explicit cap drawing is needed.
      */
-    for (int i = 0; i < p->count - 1; i++) {
-        float x0 = p->points_x[i], y0 = p->points_y[i];
-        float x1 = p->points_x[i + 1], y1 = p->points_y[i + 1];
-
-        /* Skip degenerate segments (threshold matches iui_raster_capsule) */
-        float dx = x1 - x0, dy = y1 - y0;
-        if (dx * dx + dy * dy < 0.001f * 0.001f)
-            continue;
+    for (int s = 0; s < iui_path_subpaths(p); s++) {
+        int start, end;
+        iui_path_subpath_range(p, s, &start, &end);
+        for (int i = start; i < end - 1; i++) {
+            float x0 = p->points_x[i], y0 = p->points_y[i];
+            float x1 = p->points_x[i + 1], y1 = p->points_y[i + 1];
+
+            /* Skip degenerate segments (matches iui_raster_capsule) */
+            float dx = x1 - x0, dy = y1 - y0;
+            if (dx * dx + dy * dy < 0.001f * 0.001f)
+                continue;
 
-        iui_raster_capsule(r, x0, y0, x1, y1, radius, color);
+            iui_raster_capsule(r, x0, y0, x1, y1, radius, color);
+        }
     }
 }
 
@@ -29,8 +29,17 @@ extern "C" {
 #define IUI_PORT_PI 3.14159265358979323846
 #endif
 
+/* Path capacity, embedded in every port context (~8.7 KB by default). It
+ * holds a typical label so the run is stroked with a single backend call;
+ * longer runs are stroked in chunks (iui_path_run_full). Define larger
+ * values before including this header to trade memory for fewer strokes.
+ */
 #ifndef IUI_PORT_MAX_PATH_POINTS
-#define IUI_PORT_MAX_PATH_POINTS 256
+#define IUI_PORT_MAX_PATH_POINTS 1024
+#endif
+
+#ifndef IUI_PORT_MAX_SUBPATHS
+#define IUI_PORT_MAX_SUBPATHS 128
 #endif
 
 /* Calculate adaptive segment count for Bezier curves based on Manhattan
@@ -140,6 +149,11 @@ extern "C" {
 /* Forward declaration for opaque port context */
 typedef struct iui_port_ctx iui_port_ctx;
 
+/* Key and text events a backend can keep per frame (see events below) */
+#ifndef IUI_PORT_MAX_EVENTS
+#define IUI_PORT_MAX_EVENTS 16
+#endif
+
 /* Input event structure - backends queue these for the application to process.
  * This decouples event polling from input application.
  */
@@ -151,6 +165,12 @@ typedef struct {
     uint32_t text;            /* Unicode codepoint for text input or 0 */
     float scroll_x, scroll_y; /* Horizontal/Vertical scroll delta */
     bool shift_down;          /* For Tab navigation */
+    /* Optional timestamped key/char events in arrival order; when present
+     * they replace @key and @text so fast typing is not cut to one key and
+     * one character per frame.
+     */
+    iui_input_event events[IUI_PORT_MAX_EVENTS];
+    int event_count;
 } iui_port_input;
 
 /* Port lifecycle helper: consume queued input and clear per-frame fields.
@@ -167,6 +187,7 @@ static inline void iui_port_consume_input(iui_port_input *dst,
     src->text = 0;
     src->scroll_x = 0.f;
     src->scroll_y = 0.f;
+    src->event_count = 0;
 }
 
 /* Port lifecycle helper: request exit from application.
@@ -290,7 +311,23 @@ static inline void iui_port_apply_input(iui_context *ui,
 
     iui_update_mouse_buttons(ui, input->mouse_pressed, input->mouse_released);
 
-    if (input->key != IUI_KEY_NONE) {
+    for (int i = 0; i < input->event_count; i++) {
+        const iui_input_event *ev = &input->events[i];
+        /* Tab/Escape drive focus at port layer, as for @key below */
+        if (ev->type == IUI_EVENT_KEY && ev->code == IUI_KEY_TAB) {
+            if (ev->modifiers & IUI_MOD_SHIFT) {
+                iui_focus_prev(ui);
+            } else {
+                iui_focus_next(ui);
+            }
+        } else if (ev->type == IUI_EVENT_KEY && ev->code == IUI_KEY_ESCAPE) {
+            iui_clear_focus(ui);
+        } else {
+            iui_push_event(ui, ev);
+        }
+    }
+
+    if (input->event_count == 0 && input->key != IUI_KEY_NONE) {
         /* Handle focus navigation (Tab/Shift+Tab) at port layer */
         if (input->key == IUI_KEY_TAB) {
             if (input->shift_down) {
@@ -305,7 +342,7 @@ static inline void iui_port_apply_input(iui_context *ui,
         }
     }
 
-    if (input->text != 0)
+    if (input->event_count == 0 && input->text != 0)
         iui_update_char(ui, (int) input->text);
 
     if (input->scroll_x != 0.0f || input->scroll_y != 0.0f)
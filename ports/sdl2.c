@@ -322,15 +322,28 @@ static void sdl2_draw_arc(float cx,
  * rendering to SDL_Renderer without per-point scaling overhead.
  */
 
+static void sdl2_stroke_path(iui_port_ctx *ctx, float width, uint32_t color);
+
+/* Stroke a text run early when the path buffer cannot take more points */
+static void sdl2_path_reserve(iui_port_ctx *ctx)
+{
+    if (!iui_path_run_full(&ctx->path))
+        return;
+    sdl2_stroke_path(ctx, ctx->path.run_width, ctx->path.run_color);
+    iui_path_run_continue(&ctx->path);
+}
+
 static void sdl2_path_move(float x, float y, void *user)
 {
     iui_port_ctx *ctx = (iui_port_ctx *) user;
+    sdl2_path_reserve(ctx);
     iui_path_move_to_scaled(&ctx->path, x, y, ctx->scale);
 }
 
 static void sdl2_path_line(float x, float y, void *user)
 {
     iui_port_ctx *ctx = (iui_port_ctx *) user;
+    sdl2_path_reserve(ctx);
     iui_path_line_to_scaled(&ctx->path, x, y, ctx->scale);
 }
 
@@ -343,6 +356,7 @@ static void sdl2_path_curve(float x1,
                             void *user)
 {
     iui_port_ctx *ctx = (iui_port_ctx *) user;
+    sdl2_path_reserve(ctx);
     iui_path_curve_to_scaled(&ctx->path, x1, y1, x2, y2, x3, y3, ctx->scale);
 }
 
@@ -363,6 +377,10 @@ static void sdl2_path_curve(float x1,
 #define STROKE_MAX_VERTS 2040   /* 255 segments × 8 */
 #define STROKE_MAX_INDICES 4590 /* 255 segments × 18 */
 
+/* Round cap geometry limits: center + 2 rings of up to 24 vertices */
+#define CAP_MAX_VERTS 49
+#define CAP_MAX_INDICES 216
+
 /* Create SDL_Vertex with position and color (tex coords unused) */
 #define VERT(px, py, c) ((SDL_Vertex) {{(px), (py)}, (c), {0, 0}})
 
@@ -397,15 +415,18 @@ static inline int clamp_segs(float radius, int lo, int hi)
     return (s < lo) ? lo : ((s > hi) ? hi : s);
 }
 
-/* Draw antialiased round cap at endpoint using geometry triangles.
+/* Append an antialiased round cap at an endpoint to the geometry batch.
  * Uses a center vertex + inner ring (solid) + outer ring (transparent fringe).
  */
-static void draw_aa_cap(SDL_Renderer *r,
-                        float cx,
-                        float cy,
-                        float radius,
-                        SDL_Color solid,
-                        SDL_Color trans)
+static void append_aa_cap(SDL_Vertex *v,
+                          int *vi,
+                          int *idx,
+                          int *ii,
+                          float cx,
+                          float cy,
+                          float radius,
+                          SDL_Color solid,
+                          SDL_Color trans)
 {
     if (radius < AA_FRINGE)
         return;
@@ -413,44 +434,37 @@ static void draw_aa_cap(SDL_Renderer *r,
     int segs = clamp_segs(radius, 8, 24);
 
     /* Vertex layout: center(1) + inner_ring(segs) + outer_ring(segs) */
-    SDL_Vertex v[49]; /* 1 + 24 + 24 max */
-    int idx[216];     /* 24 * 9 max */
-    int ii = 0;
-
     float r_inner = radius - AA_FRINGE, r_outer = radius + AA_FRINGE;
     if (r_inner < 0.f)
         r_inner = 0.f;
 
     float step = TWO_PI / (float) segs;
+    int b = *vi;
 
-    v[0] = VERT(cx, cy, solid);
+    v[b] = VERT(cx, cy, solid);
 
     for (int i = 0; i < segs; i++) {
         float a = (float) i * step;
         float cs = cosf(a), sn = sinf(a);
         int next = (i + 1) % segs;
 
-        v[1 + i] = VERT(cx + cs * r_inner, cy + sn * r_inner, solid);
-        v[1 + segs + i] = VERT(cx + cs * r_outer, cy + sn * r_outer, trans);
+        v[b + 1 + i] = VERT(cx + cs * r_inner, cy + sn * r_inner, solid);
+        v[b + 1 + segs + i] =
+            VERT(cx + cs * r_outer, cy + sn * r_outer, trans);
 
         /* Core fan triangle + fringe quad */
-        TRI(idx, ii, 0, 1 + i, 1 + next);
-        QUAD(idx, ii, 1 + i, 1 + segs + i, 1 + segs + next, 1 + next);
+        TRI(idx, *ii, b, b + 1 + i, b + 1 + next);
+        QUAD(idx, *ii, b + 1 + i, b + 1 + segs + i, b + 1 + segs + next,
+             b + 1 + next);
     }
-
-    SDL_RenderGeometry(r, NULL, v, 1 + 2 * segs, idx, ii);
+    *vi += 1 + 2 * segs;
 }
 
-static void sdl2_path_stroke(float width, uint32_t color, void *user)
+/* Stroke every subpath in ctx->path, batching segments and caps into as few
+ * SDL_RenderGeometry calls as the vertex buffer allows.
+ */
+static void sdl2_stroke_path(iui_port_ctx *ctx, float width, uint32_t color)
 {
-    iui_port_ctx *ctx = (iui_port_ctx *) user;
-    int n = ctx->path.count;
-
-    if (n < 2) {
-        iui_path_reset(&ctx->path);
-        return;
-    }
-
     SDL_Color solid = COLOR_FROM_U32(color);
     SDL_Color trans = solid;
     trans.a = 0;
@@ -464,86 +478,130 @@ static void sdl2_path_stroke(float width, uint32_t color, void *user)
     if (r_inner < 0.f)
         r_inner = 0.f;
 
-    /* Batched geometry: 8 vertices and 18 indices per segment.
-     * Max 255 segments per batch → 2040 verts, 4590 indices.
+    /* Batched geometry: 8 vertices and 18 indices per segment, up to
+     * CAP_MAX_VERTS/CAP_MAX_INDICES per round cap.
      */
     SDL_Vertex verts[STROKE_MAX_VERTS];
     int indices[STROKE_MAX_INDICES];
     int vi = 0, ii = 0;
 
-    /* Track actual rendered endpoints for caps (skip degenerate segments) */
-    float cap_start_x = 0, cap_start_y = 0;
-    float cap_end_x = 0, cap_end_y = 0;
-    int has_start_cap = 0;
-
-    for (int i = 0; i < n - 1; i++) {
-        /* Flush if buffer would overflow (8 verts + 18 indices per seg) */
-        if (vi + 8 > STROKE_MAX_VERTS || ii + 18 > STROKE_MAX_INDICES) {
-            SDL_RenderGeometry(ctx->renderer, NULL, verts, vi, indices, ii);
-            vi = 0;
-            ii = 0;
-        }
+    for (int s = 0; s < iui_path_subpaths(&ctx->path); s++) {
+        int start, end;
+        iui_path_subpath_range(&ctx->path, s, &start, &end);
+
+        /* Track actual rendered endpoints for caps (skip degenerate
+         * segments)
+         */
+        float cap_start_x = 0, cap_start_y = 0;
+        float cap_end_x = 0, cap_end_y = 0;
+        int has_start_cap = 0;
+
+        for (int i = start; i < end - 1; i++) {
+            /* Flush if buffer would overflow (8 verts + 18 indices per seg) */
+            if (vi + 8 > STROKE_MAX_VERTS || ii + 18 > STROKE_MAX_INDICES) {
+                SDL_RenderGeometry(ctx->renderer, NULL, verts, vi, indices,
+                                   ii);
+                vi = 0;
+                ii = 0;
+            }
 
-        float x0 = ctx->path.points_x[i], y0 = ctx->path.points_y[i];
-        float x1 = ctx->path.points_x[i + 1], y1 = ctx->path.points_y[i + 1];
+            float x0 = ctx->path.points_x[i], y0 = ctx->path.points_y[i];
+            float x1 = ctx->path.points_x[i + 1],
+                  y1 = ctx->path.points_y[i + 1];
 
-        float dx = x1 - x0, dy = y1 - y0;
-        float len = sqrtf(dx * dx + dy * dy);
+            float dx = x1 - x0, dy = y1 - y0;
+            float len = sqrtf(dx * dx + dy * dy);
 
-        if (len < 0.001f)
-            continue;
+            if (len < 0.001f)
+                continue;
+
+            /* Track first rendered segment's start for start cap */
+            if (!has_start_cap) {
+                cap_start_x = x0;
+                cap_start_y = y0;
+                has_start_cap = 1;
+            }
+            /* Always update end cap to last rendered segment's end */
+            cap_end_x = x1;
+            cap_end_y = y1;
+
+            /* Perpendicular unit vector scaled by radii */
+            float nx = -dy / len, ny = dx / len;
+            float in_x = nx * r_inner, in_y = ny * r_inner;
+            float out_x = nx * r_outer, out_y = ny * r_outer;
+
+            int b = vi; /* Base vertex index for this segment */
+
+            /* 8 vertices: outer/inner on left(+) and right(-) sides at both
+             * ends
+             */
+            verts[vi++] = VERT(x0 + out_x, y0 + out_y, trans); /* 0 */
+            verts[vi++] = VERT(x0 + in_x, y0 + in_y, solid);   /* 1 */
+            verts[vi++] = VERT(x1 + in_x, y1 + in_y, solid);   /* 2 */
+            verts[vi++] = VERT(x1 + out_x, y1 + out_y, trans); /* 3 */
+            verts[vi++] = VERT(x0 - in_x, y0 - in_y, solid);   /* 4 */
+            verts[vi++] = VERT(x0 - out_x, y0 - out_y, trans); /* 5 */
+            verts[vi++] = VERT(x1 - in_x, y1 - in_y, solid);   /* 6 */
+            verts[vi++] = VERT(x1 - out_x, y1 - out_y, trans); /* 7 */
+
+            /* 3 quads: left fringe, solid core, right fringe */
+            QUAD(indices, ii, b + 0, b + 1, b + 2, b + 3); /* left fringe */
+            QUAD(indices, ii, b + 1, b + 4, b + 6, b + 2); /* core */
+            QUAD(indices, ii, b + 4, b + 5, b + 7, b + 6); /* right fringe */
+        }
 
-        /* Track first rendered segment's start for start cap */
-        if (!has_start_cap) {
-            cap_start_x = x0;
-            cap_start_y = y0;
-            has_start_cap = 1;
+        /* Round caps at actual rendered endpoints only */
+        if (has_start_cap) {
+            if (vi + 2 * CAP_MAX_VERTS > STROKE_MAX_VERTS ||
+                ii + 2 * CAP_MAX_INDICES > STROKE_MAX_INDICES) {
+                SDL_RenderGeometry(ctx->renderer, NULL, verts, vi, indices,
+                                   ii);
+                vi = 0;
+                ii = 0;
+            }
+            append_aa_cap(verts, &vi, indices, &ii, cap_start_x, cap_start_y,
+                          r_total, solid, trans);
+            append_aa_cap(verts, &vi, indices, &ii, cap_end_x, cap_end_y,
+                          r_total, solid, trans);
         }
-        /* Always update end cap to last rendered segment's end */
-        cap_end_x = x1;
-        cap_end_y = y1;
-
-        /* Perpendicular unit vector scaled by radii */
-        float nx = -dy / len, ny = dx / len;
-        float in_x = nx * r_inner, in_y = ny * r_inner;
-        float out_x = nx * r_outer, out_y = ny * r_outer;
-
-        int b = vi; /* Base vertex index for this segment */
-
-        /* 8 vertices: outer/inner on left(+) and right(-) sides at both ends */
-        verts[vi++] = VERT(x0 + out_x, y0 + out_y, trans); /* 0: start outer+ */
-        verts[vi++] = VERT(x0 + in_x, y0 + in_y, solid);   /* 1: start inner+ */
-        verts[vi++] = VERT(x1 + in_x, y1 + in_y, solid);   /* 2: end inner+ */
-        verts[vi++] = VERT(x1 + out_x, y1 + out_y, trans); /* 3: end outer+ */
-        verts[vi++] = VERT(x0 - in_x, y0 - in_y, solid);   /* 4: start inner- */
-        verts[vi++] = VERT(x0 - out_x, y0 - out_y, trans); /* 5: start outer- */
-        verts[vi++] = VERT(x1 - in_x, y1 - in_y, solid);   /* 6: end inner- */
-        verts[vi++] = VERT(x1 - out_x, y1 - out_y, trans); /* 7: end outer- */
-
-        /* 3 quads: left fringe, solid core, right fringe */
-        QUAD(indices, ii, b + 0, b + 1, b + 2, b + 3); /* left fringe */
-        QUAD(indices, ii, b + 1, b + 4, b + 6, b + 2); /* core */
-        QUAD(indices, ii, b + 4, b + 5, b + 7, b + 6); /* right fringe */
     }
 
-    /* Single batched draw call for all segments */
+    /* Single batched draw call for everything that is left */
     if (vi > 0)
         SDL_RenderGeometry(ctx->renderer, NULL, verts, vi, indices, ii);
+}
 
-    /* Round caps at actual rendered endpoints only */
-    if (has_start_cap) {
-        draw_aa_cap(ctx->renderer, cap_start_x, cap_start_y, r_total, solid,
-                    trans);
-        draw_aa_cap(ctx->renderer, cap_end_x, cap_end_y, r_total, solid, trans);
-    }
-
+static void sdl2_path_stroke(float width, uint32_t color, void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+    if (ctx->path.count >= 2)
+        sdl2_stroke_path(ctx, width, color);
     iui_path_reset(&ctx->path);
 }
 
+/* Text runs: the whole string is accumulated in ctx->path and stroked with
+ * one batched geometry submission instead of one per glyph subpath.
+ */
+static void sdl2_path_begin_run(float width, uint32_t color, void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+    iui_path_begin_run(&ctx->path, width, color);
+}
+
+static void sdl2_path_end_run(void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+    if (ctx->path.count >= 2)
+        sdl2_stroke_path(ctx, ctx->path.run_width, ctx->path.run_color);
+    iui_path_end_run(&ctx->path);
+}
+
 #undef TWO_PI
 #undef AA_FRINGE
 #undef STROKE_MAX_VERTS
 #undef STROKE_MAX_INDICES
+#undef CAP_MAX_VERTS
+#undef CAP_MAX_INDICES
 #undef VERT
 #undef COLOR_FROM_U32
 #undef TRI
@@ -640,6 +698,50 @@ static void sdl2_configure(iui_port_ctx *ctx)
     ctx->vector_ops.path_line = sdl2_path_line;
     ctx->vector_ops.path_curve = sdl2_path_curve;
     ctx->vector_ops.path_stroke = sdl2_path_stroke;
+    ctx->vector_ops.path_begin_run = sdl2_path_begin_run;
+    ctx->vector_ops.path_end_run = sdl2_path_end_run;
+}
+
+/* Append a key/char event to this frame's list; extras beyond
+ * IUI_PORT_MAX_EVENTS are dropped.
+ */
+static void sdl2_queue_event(iui_port_ctx *ctx,
+                             iui_event_type_t type,
+                             int code,
+                             Uint32 timestamp)
+{
+    iui_port_input *in = &ctx->queued_input;
+    if (in->event_count >= IUI_PORT_MAX_EVENTS)
+        return;
+
+    SDL_Keymod mod = SDL_GetModState();
+    uint8_t modifiers = 0;
+    if (mod & KMOD_CTRL)
+        modifiers |= IUI_MOD_CTRL;
+    if (mod & KMOD_SHIFT)
+        modifiers |= IUI_MOD_SHIFT;
+    if (mod & KMOD_ALT)
+        modifiers |= IUI_MOD_ALT;
+    in->events[in->event_count++] = (iui_input_event) {
+        .type = (uint8_t) type,
+        .modifiers = modifiers,
+        .code = code,
+        .time_ms = timestamp,
+    };
+}
+
+/* Decode one UTF-8 codepoint from SDL text input and advance @p */
+static uint32_t sdl2_utf8_next(const unsigned char **p)
+{
+    const unsigned char *s = *p;
+    uint32_t cp = *s++;
+    int extra = cp >= 0xF0 ? 3 : cp >= 0xE0 ? 2 : cp >= 0xC0 ? 1 : 0;
+    if (extra)
+        cp &= 0x3F >> extra;
+    while (extra-- > 0 && (*s & 0xC0) == 0x80)
+        cp = (cp << 6) | (*s++ & 0x3F);
+    *p = s;
+    return cp;
 }
 
 static bool sdl2_poll_events(iui_port_ctx *ctx)
@@ -655,6 +757,7 @@ static bool sdl2_poll_events(iui_port_ctx *ctx)
     ctx->queued_input.scroll_x = 0;
     ctx->queued_input.scroll_y = 0;
     ctx->queued_input.shift_down = false;
+    ctx->queued_input.event_count = 0;
 
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
@@ -701,10 +804,9 @@ static bool sdl2_poll_events(iui_port_ctx *ctx)
             if (event.key.keysym.mod & KMOD_SHIFT)
                 ctx->queued_input.shift_down = true;
 
-            /* First key per frame only */
-            if (ctx->queued_input.key != 0)
-                break;
-
+            /* Every key goes to the event list, the first also to @key */
+            iui_key_code_t first = ctx->queued_input.key;
+            ctx->queued_input.key = IUI_KEY_NONE;
             if (key == SDLK_BACKSPACE) {
                 ctx->queued_input.key = IUI_KEY_BACKSPACE;
             } else if (key == SDLK_DELETE) {
@@ -728,14 +830,26 @@ static bool sdl2_poll_events(iui_port_ctx *ctx)
             } else if (key == SDLK_DOWN) {
                 ctx->queued_input.key = IUI_KEY_DOWN;
             }
+            if (ctx->queued_input.key != IUI_KEY_NONE)
+                sdl2_queue_event(ctx, IUI_EVENT_KEY, ctx->queued_input.key,
+                                 event.key.timestamp);
+            if (first != IUI_KEY_NONE)
+                ctx->queued_input.key = first;
             break;
         }
 
-        case SDL_TEXTINPUT:
-            /* First text event per frame only */
-            if (ctx->queued_input.text == 0 && event.text.text[0] != '\0')
-                ctx->queued_input.text = (uint32_t) event.text.text[0];
+        case SDL_TEXTINPUT: {
+            /* One event per codepoint; @text keeps the first */
+            const unsigned char *t = (const unsigned char *) event.text.text;
+            while (*t) {
+                uint32_t cp = sdl2_utf8_next(&t);
+                if (ctx->queued_input.text == 0)
+                    ctx->queued_input.text = cp;
+                sdl2_queue_event(ctx, IUI_EVENT_CHAR, (int) cp,
+                                 event.text.timestamp);
+            }
             break;
+        }
 
         case SDL_MOUSEWHEEL:
             /* Accumulate scroll deltas */
@@ -160,10 +160,61 @@ static void wasm_draw_arc(float cx,
     }, cx, cy, radius, start_angle, end_angle, width, srgb_color);
 }
 
-/* Vector Font Callbacks (iui_vector_t implementation) */
+/* Vector Font Callbacks (iui_vector_t implementation)
+ *
+ * Outside a text run, path commands go straight to the canvas. Inside a run
+ * the points accumulate in ctx->path and the whole string crosses into
+ * JavaScript once, read directly from the wasm heap.
+ */
+
+static void wasm_stroke_run(iui_port_ctx *ctx)
+{
+    iui_path_state_t *p = &ctx->path;
+    if (p->count < 2)
+        return;
+    if (p->subpath_count == 0) {
+        p->subpath[0] = 0;
+        p->subpath_count = 1;
+    }
+    EM_ASM({
+            const ctx = IuiCanvas.getContext();
+            const xs = $0 >> 2, ys = $1 >> 2, subs = $2 >> 2;
+            const count = $3, nsub = $4;
+            ctx.strokeStyle = IuiCanvas.parseColor($6);
+            ctx.lineWidth = $5;
+            ctx.lineJoin = "round";
+            ctx.lineCap = "round";
+            ctx.beginPath();
+            for (let s = 0; s < nsub; s++) {
+                const start = HEAP32[subs + s];
+                const end = s + 1 < nsub ? HEAP32[subs + s + 1] : count;
+                ctx.moveTo(HEAPF32[xs + start], HEAPF32[ys + start]);
+                for (let i = start + 1; i < end; i++)
+                    ctx.lineTo(HEAPF32[xs + i], HEAPF32[ys + i]);
+            }
+            ctx.stroke();
+    }, p->points_x, p->points_y, p->subpath, p->count, p->subpath_count,
+       p->run_width, p->run_color);
+}
+
+/* Stroke a text run early when the path buffer cannot take more points */
+static void wasm_path_reserve(iui_port_ctx *ctx)
+{
+    if (!iui_path_run_full(&ctx->path))
+        return;
+    wasm_stroke_run(ctx);
+    iui_path_run_continue(&ctx->path);
+}
+
 
 static void wasm_path_move(float x, float y, void *user)
 {
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+    if (ctx->path.in_run) {
+        wasm_path_reserve(ctx);
+        iui_path_move_to(&ctx->path, x, y);
+        return;
+    }
     EM_ASM({
             const ctx = IuiCanvas.getContext();
             ctx.beginPath();
@@ -173,6 +224,12 @@ static void wasm_path_move(float x, float y, void *user)
 
 static void wasm_path_line(float x, float y, void *user)
 {
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+    if (ctx->path.in_run) {
+        wasm_path_reserve(ctx);
+        iui_path_line_to(&ctx->path, x, y);
+        return;
+    }
     EM_ASM({
             const ctx = IuiCanvas.getContext();
             ctx.lineTo($0, $1);
@@ -187,6 +244,12 @@ static void wasm_path_curve(float x1,
                             float y3,
                             void *user)
 {
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+    if (ctx->path.in_run) {
+        wasm_path_reserve(ctx);
+        iui_path_curve_to(&ctx->path, x1, y1, x2, y2, x3, y3);
+        return;
+    }
     EM_ASM({
             const ctx = IuiCanvas.getContext();
             ctx.bezierCurveTo($0, $1, $2, $3, $4, $5);
@@ -205,6 +268,19 @@ static void wasm_path_stroke(float width, uint32_t color, void *user)
     }, width, color);
 }
 
+static void wasm_path_begin_run(float width, uint32_t color, void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+    iui_path_begin_run(&ctx->path, width, color);
+}
+
+static void wasm_path_end_run(void *user)
+{
+    iui_port_ctx *ctx = (iui_port_ctx *) user;
+    wasm_stroke_run(ctx);
+    iui_path_end_run(&ctx->path);
+}
+
 /* clang-format on */
 
 /* Port Interface Implementation (iui_port_t) */
@@ -281,6 +357,8 @@ static void wasm_configure(iui_port_ctx *ctx)
     ctx->vector_ops.path_line = wasm_path_line;
     ctx->vector_ops.path_curve = wasm_path_curve;
     ctx->vector_ops.path_stroke = wasm_path_stroke;
+    ctx->vector_ops.path_begin_run = wasm_path_begin_run;
+    ctx->vector_ops.path_end_run = wasm_path_end_run;
 }
 
 static bool wasm_poll_events(iui_port_ctx *ctx)
@@ -0,0 +1,335 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""
+Font atlas generator for the built-in vector font.
+
+Bakes src/glyphs-data.inc at a fixed set of pixel sizes into an A4 or A8
+coverage atlas so software ports can blit glyph rectangles straight from
+flash instead of flattening and stroking outlines every frame.
+
+The rasterizer mirrors the runtime vector path:
+  - outlines are scaled by font_height / 64 and snapped to the pixel grid
+    relative to an integer glyph origin on the baseline,
+  - cubics use the same Manhattan-length segment heuristic (4-12 segments),
+  - strokes are capsules of width max(font_height / 32, 0.75), clamped to
+    1 px like iui_raster_path_stroke, with the same adaptive AA fringe.
+
+Output format (src/font-atlas-gen.inc):
+  IUI_FONT_ATLAS_BPP     4 (two pixels per byte, high nibble first) or 8
+  IUI_FONT_ATLAS_WIDTH   atlas width in pixels
+  IUI_FONT_ATLAS_HEIGHT  atlas height in pixels
+  IUI_FONT_ATLAS_SIZES   number of baked font heights
+  iui_font_atlas_pixels[]                      packed coverage rows
+  iui_font_atlas_heights[SIZES]                baked font_height values
+  iui_font_atlas_glyphs[SIZES][96]             {x, y, w, h, dx, dy}
+Glyph slot 0 is the replacement box, slots 1-95 map to ASCII 0x20-0x7E,
+matching iui_glyph_advance_index(). dx/dy offset the bitmap from the glyph
+origin (left bearing applied) on the baseline.
+"""
+
+import argparse
+import math
+import re
+import sys
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+UNITS_PER_EM = 64.0
+PEN_WIDTH_DIVISOR = 32.0
+PEN_WIDTH_MIN = 0.75
+GLYPH_COUNT = 96
+ATLAS_WIDTH = 256
+
+Point = Tuple[float, float]
+
+
+def parse_glyphs(path: Path) -> Dict[int, List[int]]:
+    """
+    Parse glyphs-data.inc into {codepoint: bytecode}.
+
+    Each glyph is introduced by a comment of the form "/* 0x41 'A' ... */";
+    the remaining comments (snap array labels) are dropped.
+    """
+    content = path.read_text()
+    header = re.compile(r"/\*\s*0x([0-9a-fA-F]+)\b.*?\*/")
+    marks = list(header.finditer(content))
+    if not marks:
+        print(f"Error: no glyphs found in {path}", file=sys.stderr)
+        sys.exit(1)
+
+    glyphs = {}
+    for i, m in enumerate(marks):
+        end = marks[i + 1].start() if i + 1 < len(marks) else len(content)
+        body = re.sub(r"/\*.*?\*/", "", content[m.end() : end], flags=re.S)
+        code = []
+        for tok in re.findall(r"'(?:\\.|[^'])'|-?\d+", body):
+            code.append(ord(tok[1]) if tok.startswith("'") else int(tok))
+        glyphs[int(m.group(1), 16)] = code
+    return glyphs
+
+
+def glyph_slots(glyphs: Dict[int, List[int]]) -> List[List[int]]:
+    """Order glyphs like iui_glyph_advance_index(): box, then 0x20-0x7E."""
+    box = glyphs[0]
+    return [box] + [glyphs.get(c, box) for c in range(0x20, 0x7F)]
+
+
+def flatten(code: List[int], scale: float) -> List[List[Point]]:
+    """Flatten glyph opcodes into pixel-snapped subpaths."""
+    it = 6 + code[4] + code[5]
+    subpaths: List[List[Point]] = []
+    x = y = 0.0
+
+    def snap(px: float, py: float) -> Point:
+        return (math.floor(px + 0.5), math.floor(py + 0.5))
+
+    while it < len(code):
+        op = chr(code[it])
+        if op == "m":
+            x, y = code[it + 1] * scale, code[it + 2] * scale
+            subpaths.append([snap(x, y)])
+            it += 3
+        elif op == "l":
+            x, y = code[it + 1] * scale, code[it + 2] * scale
+            subpaths[-1].append(snap(x, y))
+            it += 3
+        elif op == "c":
+            x1, y1 = code[it + 1] * scale, code[it + 2] * scale
+            x2, y2 = code[it + 3] * scale, code[it + 4] * scale
+            x3, y3 = code[it + 5] * scale, code[it + 6] * scale
+            approx = (
+                abs(x1 - x)
+                + abs(y1 - y)
+                + abs(x2 - x1)
+                + abs(y2 - y1)
+                + abs(x3 - x2)
+                + abs(y3 - y2)
+            )
+            segments = int(min(max(approx * 0.15, 4.0), 12.0))
+            for i in range(1, segments + 1):
+                t = i / segments
+                u = 1.0 - t
+                px = u**3 * x + 3 * u * u * t * x1 + 3 * u * t * t * x2 + t**3 * x3
+                py = u**3 * y + 3 * u * u * t * y1 + 3 * u * t * t * y2 + t**3 * y3
+                subpaths[-1].append(snap(px, py))
+            x, y = x3, y3
+            it += 7
+        else:
+            break
+    return subpaths
+
+
+def rasterize(subpaths: List[List[Point]], pen: float):
+    """
+    Rasterize stroked subpaths into a cropped coverage bitmap.
+
+    Returns (dx, dy, w, h, rows) where rows holds floats in [0, 1].
+    Overlapping capsules take the maximum coverage instead of blending twice.
+    """
+    radius = max(pen, 1.0) * 0.5
+    if radius <= 0.4:
+        aa_half = 0.35
+    elif radius >= 0.6:
+        aa_half = 0.5
+    else:
+        aa_half = 0.35 + (radius - 0.4) * (0.5 - 0.35) / (0.6 - 0.4)
+    inner, outer = radius - aa_half, radius + aa_half
+
+    segs = []
+    for sp in subpaths:
+        for (x0, y0), (x1, y1) in zip(sp, sp[1:]):
+            if (x1 - x0) ** 2 + (y1 - y0) ** 2 >= 0.001**2:
+                segs.append((x0, y0, x1, y1))
+    if not segs:
+        return 0, 0, 0, 0, []
+
+    margin = outer + 0.5
+    min_x = math.floor(min(min(s[0], s[2]) for s in segs) - margin)
+    max_x = math.ceil(max(max(s[0], s[2]) for s in segs) + margin)
+    min_y = math.floor(min(min(s[1], s[3]) for s in segs) - margin)
+    max_y = math.ceil(max(max(s[1], s[3]) for s in segs) + margin)
+
+    w, h = max_x - min_x, max_y - min_y
+    cov = [[0.0] * w for _ in range(h)]
+    for x0, y0, x1, y1 in segs:
+        dx, dy = x1 - x0, y1 - y0
+        inv_len2 = 1.0 / (dx * dx + dy * dy)
+        for row in range(h):
+            fy = min_y + row + 0.5
+            for col in range(w):
+                fx = min_x + col + 0.5
+                t = ((fx - x0) * dx + (fy - y0) * dy) * inv_len2
+                t = min(max(t, 0.0), 1.0)
+                dist = math.hypot(fx - (x0 + t * dx), fy - (y0 + t * dy))
+                if dist < inner:
+                    c = 1.0
+                elif dist < outer:
+                    c = (outer - dist) / (2.0 * aa_half)
+                else:
+                    continue
+                if c > cov[row][col]:
+                    cov[row][col] = c
+
+    # Crop empty borders
+    rows = [r for r in range(h) if any(cov[r])]
+    cols = [c for c in range(w) if any(cov[r][c] for r in range(h))]
+    if not rows:
+        return 0, 0, 0, 0, []
+    r0, r1, c0, c1 = rows[0], rows[-1] + 1, cols[0], cols[-1] + 1
+    bitmap = [cov[r][c0:c1] for r in range(r0, r1)]
+    return min_x + c0, min_y + r0, c1 - c0, r1 - r0, bitmap
+
+
+def bake(slots: List[List[int]], sizes: List[float], bpp: int):
+    """Rasterize every glyph at every size and shelf-pack the atlas."""
+    levels = (1 << bpp) - 1
+    bitmaps = []
+    for si, size in enumerate(sizes):
+        scale = size / UNITS_PER_EM
+        pen = max(size / PEN_WIDTH_DIVISOR, PEN_WIDTH_MIN)
+        for gi, code in enumerate(slots):
+            dx, dy, w, h, bm = rasterize(flatten(code, scale), pen)
+            if w > 255 or h > 255 or not (-128 <= dx < 128 and -128 <= dy < 128):
+                print(f"Error: size {size:g} too large to bake", file=sys.stderr)
+                sys.exit(1)
+            q = [[int(v * levels + 0.5) for v in r] for r in bm]
+            bitmaps.append((si, gi, dx, dy, w, h, q))
+
+    # Shelf packing, tallest first; 1 px gutter keeps A4 nibbles separate
+    order = sorted(range(len(bitmaps)), key=lambda i: -bitmaps[i][5])
+    placed = {}
+    shelf_x = shelf_y = shelf_h = 0
+    for i in order:
+        w, h = bitmaps[i][4], bitmaps[i][5]
+        if w == 0:
+            placed[i] = (0, 0)
+            continue
+        if shelf_x + w > ATLAS_WIDTH:
+            shelf_y += shelf_h + 1
+            shelf_x = shelf_h = 0
+        placed[i] = (shelf_x, shelf_y)
+        shelf_x += w + 1
+        shelf_h = max(shelf_h, h)
+    height = shelf_y + shelf_h
+
+    pixels = [[0] * ATLAS_WIDTH for _ in range(height)]
+    glyphs = [[None] * GLYPH_COUNT for _ in sizes]
+    for i, (si, gi, dx, dy, w, h, q) in enumerate(bitmaps):
+        x, y = placed[i]
+        for r in range(h):
+            pixels[y + r][x : x + w] = q[r]
+        glyphs[si][gi] = (x, y, w, h, dx, dy)
+    return pixels, glyphs
+
+
+def pack_rows(pixels: List[List[int]], bpp: int) -> List[int]:
+    """Pack atlas rows into bytes (A4: two pixels per byte, high first)."""
+    out = []
+    for row in pixels:
+        if bpp == 8:
+            out.extend(row)
+        else:
+            for x in range(0, len(row), 2):
+                out.append((row[x] << 4) | row[x + 1])
+    return out
+
+
+def generate_atlas(
+    glyphs_path: Path, output_path: Path, sizes: List[float], bpp: int
+) -> None:
+    """Generate font-atlas-gen.inc with the baked atlas."""
+    slots = glyph_slots(parse_glyphs(glyphs_path))
+    pixels, glyphs = bake(slots, sizes, bpp)
+    data = pack_rows(pixels, bpp)
+
+    lines = [
+        "/* AUTO-GENERATED by scripts/gen-font-atlas.py - DO NOT EDIT */",
+        f"/* Built-in vector font baked at {' '.join(f'{s:g}' for s in sizes)} px,"
+        f" A{bpp} */",
+        "",
+        f"#define IUI_FONT_ATLAS_BPP {bpp}",
+        f"#define IUI_FONT_ATLAS_WIDTH {ATLAS_WIDTH}",
+        f"#define IUI_FONT_ATLAS_HEIGHT {len(pixels)}",
+        f"#define IUI_FONT_ATLAS_SIZES {len(sizes)}",
+        "",
+        "/* clang-format off */",
+        f"static const uint8_t iui_font_atlas_pixels[{len(data)}] = {{",
+    ]
+    for i in range(0, len(data), 12):
+        chunk = data[i : i + 12]
+        lines.append("    " + " ".join(f"0x{b:02X}," for b in chunk))
+    lines.append("};")
+    lines.append("")
+    lines.append(
+        "static const float iui_font_atlas_heights[IUI_FONT_ATLAS_SIZES] = {"
+    )
+    lines.append("    " + " ".join(f"{s!r}f," for s in sizes))
+    lines.append("};")
+    lines.append("")
+    lines.append(
+        "static const iui_font_atlas_rect "
+        "iui_font_atlas_glyphs[IUI_FONT_ATLAS_SIZES][96] = {"
+    )
+    for si, size in enumerate(sizes):
+        lines.append(f"    /* {size:g} px */")
+        lines.append("    {")
+        for x, y, w, h, dx, dy in glyphs[si]:
+            lines.append(f"        {{{x}, {y}, {w}, {h}, {dx}, {dy}}},")
+        lines.append("    },")
+    lines.append("};")
+    lines.append("/* clang-format on */")
+    lines.append("")
+
+    output_path.write_text("\n".join(lines))
+    print(
+        f"Generated {output_path}: {ATLAS_WIDTH}x{len(pixels)} A{bpp}, "
+        f"{len(data)} bytes of pixels for {len(sizes)} sizes"
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Bake the built-in vector font into a coverage atlas"
+    )
+    parser.add_argument(
+        "--output",
+        "-o",
+        type=Path,
+        default=Path("src/font-atlas-gen.inc"),
+        help="Output include file path (default: src/font-atlas-gen.inc)",
+    )
+    parser.add_argument(
+        "--glyphs",
+        type=Path,
+        default=Path("src/glyphs-data.inc"),
+        help="Glyph bytecode source (default: src/glyphs-data.inc)",
+    )
+    parser.add_argument(
+        "--sizes",
+        default="14 16 21",
+        help="Space-separated font heights in pixels (default: '14 16 21')",
+    )
+    parser.add_argument(
+        "--bpp",
+        type=int,
+        choices=(4, 8),
+        default=4,
+        help="Coverage bits per pixel (default: 4)",
+    )
+
+    args = parser.parse_args()
+
+    try:
+        sizes = [float(s) for s in args.sizes.replace(",", " ").split()]
+    except ValueError:
+        print(f"Error: invalid size list '{args.sizes}'", file=sys.stderr)
+        sys.exit(1)
+    if not sizes or any(s <= 0 for s in sizes):
+        print("Error: at least one positive size is required", file=sys.stderr)
+        sys.exit(1)
+
+    generate_atlas(args.glyphs, args.output, sizes, args.bpp)
+
+
+if __name__ == "__main__":
+    main()
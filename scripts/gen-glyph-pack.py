@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""
+Glyph pack builder for extended vector font coverage.
+
+Collects glyph bytecode written in the src/glyphs-data.inc syntax and emits a
+pack that iui_glyph_pack_attach() uses in place, either as a binary file for
+mmap() or as a C array for flash.
+
+Input: each glyph is introduced by a comment naming its codepoint, followed
+by the usual bytecode (header, snap arrays, opcodes):
+  /* 0x00E9 'e acute' */
+      0, 22, 30, 0, 0, 0,
+      'm', 0, -14, ... 'e',
+
+Pack layout (little-endian):
+  header  "IUGP", u16 version (1), u16 reserved, u32 glyph_count,
+          u32 data_size
+  index   glyph_count x {u32 codepoint, u32 offset}, sorted by codepoint
+  data    glyph bytecode, one glyph after another
+"""
+
+import argparse
+import re
+import struct
+import sys
+from pathlib import Path
+from typing import Dict, List
+
+PACK_MAGIC = b"IUGP"
+PACK_VERSION = 1
+
+
+def parse_glyphs(path: Path) -> Dict[int, List[int]]:
+    """Parse a glyph source file into {codepoint: bytecode}."""
+    content = path.read_text()
+    header = re.compile(r"/\*\s*0x([0-9a-fA-F]+)\b.*?\*/")
+    marks = list(header.finditer(content))
+    glyphs = {}
+    for i, m in enumerate(marks):
+        end = marks[i + 1].start() if i + 1 < len(marks) else len(content)
+        body = re.sub(r"/\*.*?\*/", "", content[m.end() : end], flags=re.S)
+        code = []
+        for tok in re.findall(r"'(?:\\.|[^'])'|-?\d+", body):
+            code.append(ord(tok[1]) if tok.startswith("'") else int(tok))
+        glyphs[int(m.group(1), 16)] = code
+    return glyphs
+
+
+def validate(cp: int, code: List[int]) -> None:
+    """Check that the bytecode is well formed and fits signed chars."""
+    if len(code) < 7 or code[-1] != ord("e"):
+        print(f"Error: glyph U+{cp:04X} must end with 'e'", file=sys.stderr)
+        sys.exit(1)
+    if any(v < -128 or v > 127 for v in code):
+        print(f"Error: glyph U+{cp:04X} has out-of-range values", file=sys.stderr)
+        sys.exit(1)
+
+
+def build_pack(glyphs: Dict[int, List[int]]) -> bytes:
+    """Serialize glyphs into the pack layout."""
+    index = bytearray()
+    data = bytearray()
+    for cp in sorted(glyphs):
+        code = glyphs[cp]
+        validate(cp, code)
+        index += struct.pack("<II", cp, len(data))
+        data += bytes(v & 0xFF for v in code)
+    header = PACK_MAGIC + struct.pack("<HHII", PACK_VERSION, 0, len(glyphs), len(data))
+    return bytes(header + index + data)
+
+
+def write_c_array(pack: bytes, name: str, output_path: Path) -> None:
+    """Emit the pack as a const array for linking into flash."""
+    lines = [
+        "/* AUTO-GENERATED by scripts/gen-glyph-pack.py - DO NOT EDIT */",
+        "",
+        "#include <stdint.h>",
+        "",
+        f"static const uint8_t {name}[{len(pack)}] = {{",
+    ]
+    for i in range(0, len(pack), 12):
+        chunk = pack[i : i + 12]
+        lines.append("    " + " ".join(f"0x{b:02X}," for b in chunk))
+    lines.append("};")
+    lines.append("")
+    output_path.write_text("\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Build an extended glyph pack for the vector font"
+    )
+    parser.add_argument(
+        "inputs", nargs="+", type=Path, help="Glyph source files (.inc syntax)"
+    )
+    parser.add_argument(
+        "--output",
+        "-o",
+        type=Path,
+        required=True,
+        help="Output pack path (binary, or C source with --c-array)",
+    )
+    parser.add_argument(
+        "--c-array",
+        metavar="NAME",
+        help="Emit a C array with this name instead of a binary pack",
+    )
+
+    args = parser.parse_args()
+
+    glyphs: Dict[int, List[int]] = {}
+    for path in args.inputs:
+        for cp, code in parse_glyphs(path).items():
+            if cp in glyphs:
+                print(f"Warning: U+{cp:04X} redefined in {path}", file=sys.stderr)
+            glyphs[cp] = code
+    if not glyphs:
+        print("Error: no glyphs found", file=sys.stderr)
+        sys.exit(1)
+
+    pack = build_pack(glyphs)
+    if args.c_array:
+        write_c_array(pack, args.c_array, args.output)
+    else:
+        args.output.write_bytes(pack)
+    print(f"Generated {args.output}: {len(glyphs)} glyphs, {len(pack)} bytes")
+
+
+if __name__ == "__main__":
+    main()
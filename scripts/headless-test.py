@@ -372,6 +372,112 @@ static int focus_changes = 0;""",
         }""",
         min_box_calls=2,
     ),
+    "scroll_layer": TestCase(
+        name="scroll_layer",
+        description="Cached scroll layer matches a plain scroll region",
+        state_vars="""static iui_scroll_state sa = {0}, sb = {0};
+static uint32_t record[16384];
+static iui_scroll_layer layer = {.record = record, .record_cap = 16384};
+static iui_rect_t va, vb;
+static bool reused = false;
+static uint32_t region_sum(iui_port_ctx *port, iui_rect_t v) {
+    int w, h; iui_headless_get_framebuffer_size(port, &w, &h);
+    const uint32_t *fb = iui_headless_get_framebuffer(port);
+    uint32_t sum = 0x811c9dc5;
+    for (int y = (int) v.y; y < (int) (v.y + v.height); y++)
+        for (int x = (int) v.x; x < (int) (v.x + v.width); x++)
+            sum = (sum ^ fb[y * w + x]) * 0x01000193;
+    return sum;
+}""",
+        code="""iui_scroll_to(&sa, 0, frame * 9.0f);
+        iui_scroll_to(&sb, 0, frame * 9.0f);
+        va = iui_scroll_begin_cached(ctx, &sa, 200, 100, &layer);
+        for (int i = 0; i < 20; i++) {
+            char lbl[32]; snprintf(lbl, sizeof(lbl), "Item %d", i);
+            if (frame == 8 && i == 3) snprintf(lbl, sizeof(lbl), "Changed");
+            iui_button(ctx, lbl, IUI_ALIGN_LEFT);
+            iui_newline(ctx);
+        }
+        iui_scroll_end(ctx, &sa);
+        reused |= layer.active && layer.stable;
+        vb = iui_scroll_begin(ctx, &sb, 200, 100);
+        for (int i = 0; i < 20; i++) {
+            char lbl[32]; snprintf(lbl, sizeof(lbl), "Item %d", i);
+            if (frame == 8 && i == 3) snprintf(lbl, sizeof(lbl), "Changed");
+            iui_button(ctx, lbl, IUI_ALIGN_LEFT);
+            iui_newline(ctx);
+        }
+        iui_scroll_end(ctx, &sb);""",
+        inject_code="",
+        validate_code="""
+        if (frame == 8) {
+            uint32_t a = region_sum(port, va), b = region_sum(port, vb);
+            test_passed = reused && va.height == vb.height && a == b;
+            printf("reused:%d layer:%08x plain:%08x\\n", reused, a, b);
+        }""",
+        min_box_calls=2,
+    ),
+    # === Font rendering ===
+    "font_atlas": TestCase(
+        name="font_atlas",
+        description="Baked font atlas matches the outline path",
+        state_vars="""static iui_vector_t *vec;
+static void (*blit)(int, int, const iui_glyph_mask_t *, uint32_t, void *);
+static int blits = 0;
+static iui_rect_t tr;
+static long ink[2];
+static int box[2][4];
+int iui_font_atlas_find(float font_height) __attribute__((weak));
+static void count_blit(int x, int y, const iui_glyph_mask_t *m,
+                       uint32_t color, void *user) {
+    blits++;
+    blit(x, y, m, color, user);
+}
+/* Total ink and its bounding box, against the region's right edge */
+static void measure(iui_port_ctx *port, long *sum, int *b) {
+    int w, h; iui_headless_get_framebuffer_size(port, &w, &h);
+    const uint32_t *fb = iui_headless_get_framebuffer(port);
+    int x0 = (int) tr.x, y0 = (int) tr.y;
+    int x1 = (int) (tr.x + tr.width), y1 = (int) (tr.y + tr.height);
+    int bg = (int) iui_headless_get_green(fb[y0 * w + x1 - 1]);
+    *sum = 0; b[0] = x1; b[1] = y1; b[2] = x0; b[3] = y0;
+    for (int y = y0; y < y1; y++)
+        for (int x = x0; x < x1; x++) {
+            int d = abs((int) iui_headless_get_green(fb[y * w + x]) - bg);
+            *sum += d;
+            if (d < 64) continue;
+            if (x < b[0]) b[0] = x;
+            if (y < b[1]) b[1] = y;
+            if (x > b[2]) b[2] = x;
+            if (y > b[3]) b[3] = y;
+        }
+}""",
+        code="""if (frame == 1) {
+            vec = (iui_vector_t *) g_iui_port.get_vector_callbacks(port);
+            blit = vec->draw_glyph_mask;
+            if (blit) vec->draw_glyph_mask = count_blit;
+        }
+        if (frame == 5) vec->draw_glyph_mask = NULL;
+        tr = iui_get_layout_rect(ctx);
+        tr.width = 300, tr.height = 24;
+        iui_text(ctx, IUI_ALIGN_LEFT, "Atlas Hg 0123 @#");""",
+        inject_code="",
+        validate_code="""
+        if (frame == 4) measure(port, &ink[0], box[0]);
+        if (frame == 8) {
+            measure(port, &ink[1], box[1]);
+            bool edges = true;
+            for (int i = 0; i < 4; i++)
+                edges &= abs(box[0][i] - box[1][i]) <= 1;
+            bool baked = iui_font_atlas_find && iui_font_atlas_find(14.0f) >= 0;
+            test_passed = ink[1] > 0 && edges && ink[0] * 5 > ink[1] * 4 &&
+                          ink[0] * 4 < ink[1] * 5 && (!baked || blits > 0);
+            printf("atlas:%d blits:%d ink:%ld/%ld box:%d,%d-%d,%d/%d,%d-%d,%d\\n",
+                   baked, blits, ink[0], ink[1], box[0][0], box[0][1],
+                   box[0][2], box[0][3], box[1][0], box[1][1], box[1][2],
+                   box[1][3]);
+        }""",
+    ),
 }
 
 # Unified test template - handles both render-only and interactive tests
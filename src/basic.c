@@ -530,6 +530,12 @@ bool iui_button_styled(iui_context *ctx,
     iui_register_focusable(ctx, widget_id, button_rect, corner);
     bool is_focused = iui_widget_is_focused(ctx, widget_id);
 
+    /* Press and hover transitions; without a record (table full) the button
+     * still works, just without animating.
+     */
+    iui_widget_state *ws = iui_widget_state_touch(ctx, widget_id, button_rect);
+    bool animating = ws && ws->anim_t < 1.f;
+
     /* Center text in button */
     iui_vec2 text_pos = {
         button_rect.x + (button_rect.width - text_width) * .5f,
@@ -546,9 +552,8 @@ bool iui_button_styled(iui_context *ctx,
     if (is_focused && (ctx->key_pressed == IUI_KEY_ENTER)) {
         clicked = true;
         ctx->key_pressed = IUI_KEY_NONE; /* Consume key */
-        ctx->animation = (iui_animation) {
-            .widget = (void *) label,
-        };
+        if (ws)
+            ws->anim_t = 0.f;
     }
 
     /* Determine colors based on button style */
@@ -594,7 +599,7 @@ bool iui_button_styled(iui_context *ctx,
         break;
     }
 
-    if (ctx->animation.widget == label) {
+    if (animating) {
         /* Press animation: flash appropriate color then fade */
         bg_color = lerp_color(
             (style == IUI_BUTTON_FILLED)
@@ -604,27 +609,31 @@ bool iui_button_styled(iui_context *ctx,
                        : (style == IUI_BUTTON_ELEVATED
                               ? ctx->colors.surface_container_high
                               : ctx->colors.surface_container)),
-            bg_color, ease_in_expo(ctx->animation.t));
-        expand_rect(&button_rect, -ease_impulse(ctx->animation.t) * 2.f);
+            bg_color, ease_in_expo(ws->anim_t));
+        expand_rect(&button_rect, -ease_impulse(ws->anim_t) * 2.f);
     } else if (state == IUI_STATE_PRESSED) {
         clicked = true;
-        ctx->animation = (iui_animation) {.widget = (void *) label};
-    } else if (state == IUI_STATE_HOVERED) {
-        /* Apply hover state layer for the button style */
-        if (ctx->hover.widget == label) {
-            /* Blend hover state layer */
-            if (bg_color != 0)
-                bg_color = iui_blend_color(bg_color, hover_layer);
-        } else {
-            ctx->hover = (iui_hover) {.widget = (void *) label};
-        }
-    } else if (ctx->hover.widget == label) {
-        ctx->hover.widget = NULL;
+        if (ws)
+            ws->anim_t = 0.f;
+    }
+
+    /* Hover state layer fades in and out over IUI_DURATION_SHORT_2 */
+    bool hovered = state == IUI_STATE_HOVERED;
+    float hover_t = hovered ? 1.f : 0.f;
+    if (ws) {
+        float step = ctx->delta_time / IUI_DURATION_SHORT_2;
+        ws->hover_t = hovered ? fminf(1.f, ws->hover_t + step)
+                              : fmaxf(0.f, ws->hover_t - step);
+        hover_t = ws->hover_t;
+    }
+    if (!animating && hover_t > 0.f && bg_color != 0) {
+        uint32_t hover_color = iui_blend_color(bg_color, hover_layer);
+        bg_color = lerp_color(bg_color, hover_color, hover_t);
     }
 
     /* Apply focus state layer (12% opacity per MD3) */
     uint32_t focus_layer = 0;
-    if (is_focused && ctx->animation.widget != label) {
+    if (is_focused && !animating) {
         focus_layer =
             iui_state_layer(ctx->colors.primary, IUI_STATE_FOCUS_ALPHA);
         if (bg_color != 0)
@@ -13,6 +13,17 @@ void iui_card_begin(iui_context *ctx,
     if (!ctx->current_window)
         return;
 
+    /* Auto height: last frame's content plus padding (just padding at
+     * first), keyed on the ID stack so a moving card keeps its measurement
+     */
+    uint32_t measure_id = 0;
+    if (h <= 0.f) {
+        measure_id = iui_next_scope_id(ctx);
+        float content_h = 0.f;
+        iui_measured_size(ctx, measure_id, NULL, &content_h);
+        h = content_h + ctx->padding * 2.f;
+    }
+
     iui_rect_t card_rect = {.x = x, .y = y, .width = w, .height = h};
 
     uint32_t bg_color, border_color = 0;
@@ -59,15 +70,19 @@ void iui_card_begin(iui_context *ctx,
         .width = card_rect.width - 2 * ctx->padding,
         .height = card_rect.height - 2 * ctx->padding,
     };
+
+    iui_measure_card_begin(ctx, measure_id);
 }
 
 void iui_card_end(iui_context *ctx)
 {
-    /* Intentional no-op for API symmetry with iui_card_begin().
-     * Cards are self-contained visual elements, so no cleanup is needed.
-     * This function is retained for a consistent begin/end pairing pattern.
+    if (!ctx->current_window)
+        return;
+
+    /* Fixed-size cards are self-contained and need no cleanup; auto-height
+     * cards close the measurement opened by their own iui_card_begin().
      */
-    (void) ctx;
+    iui_measure_card_end(ctx);
 }
 
 /* Progress indicators */
@@ -310,6 +325,44 @@ bool iui_snackbar(iui_context *ctx,
  * scrolling
  */
 
+/* Make the enclosing region (if any) the open one again */
+static void scroll_restore_parent(iui_context *ctx)
+{
+    if (!ctx->scroll_depth) {
+        ctx->active_scroll = NULL;
+        return;
+    }
+    const iui_scroll_frame *f = &ctx->scroll_stack[--ctx->scroll_depth];
+    ctx->active_scroll = f->state;
+    ctx->scroll_viewport = f->viewport;
+    ctx->scroll_content_start_x = f->start_x;
+    ctx->scroll_content_start_y = f->start_y;
+    ctx->scroll_content_start_width = f->start_width;
+    ctx->scroll_virtual_h = f->virtual_h;
+}
+
+/* Whether the region @state, which @can scroll along @axis under the
+ * mouse, takes this frame's wheel delta. Last frame's innermost such region
+ * wins while the mouse stays in its viewport; otherwise the first region
+ * that can scroll does. Also nominates @state for the next frame.
+ */
+static bool scroll_wheel_route(iui_context *ctx,
+                               int axis,
+                               iui_scroll_state *state,
+                               iui_rect_t viewport,
+                               bool can)
+{
+    iui_scroll_wheel *w = &ctx->scroll_wheel[axis];
+    if (!can)
+        return false;
+    if (!w->next || ctx->scroll_depth >= w->next_depth) {
+        w->next = state, w->next_view = viewport;
+        w->next_depth = ctx->scroll_depth;
+    }
+    return w->target == state || !w->target ||
+           !in_rect(&w->view, ctx->mouse_pos);
+}
+
 iui_rect_t iui_scroll_begin(iui_context *ctx,
                             iui_scroll_state *state,
                             float view_w,
@@ -327,9 +380,6 @@ iui_rect_t iui_scroll_begin(iui_context *ctx,
     if (view_h <= 0.0f)
         view_h = fmaxf(0.0f, ctx->layout.height + view_h);
 
-    assert(
-        !ctx->active_scroll &&
-        "nested scroll regions are not supported; call iui_scroll_end first");
     assert(view_w <= ctx->layout.width + 0.5f &&
            "scroll view_w exceeds layout width; use 0.f for auto");
 
@@ -338,13 +388,32 @@ iui_rect_t iui_scroll_begin(iui_context *ctx,
     viewport.width = view_w;
     viewport.height = view_h;
 
+    /* A nested region saves the enclosing one; wheel input reaches it only
+     * while the mouse is inside both viewports */
+    bool hovered = in_rect(&viewport, ctx->mouse_pos);
+    if (ctx->active_scroll) {
+        if (ctx->scroll_depth >= ctx->scroll_capacity)
+            return (iui_rect_t) {0, 0, 0, 0};
+        hovered = hovered && in_rect(&ctx->scroll_viewport, ctx->mouse_pos);
+        ctx->scroll_stack[ctx->scroll_depth++] = (iui_scroll_frame) {
+            .state = ctx->active_scroll,
+            .viewport = ctx->scroll_viewport,
+            .start_x = ctx->scroll_content_start_x,
+            .start_y = ctx->scroll_content_start_y,
+            .start_width = ctx->scroll_content_start_width,
+            .virtual_h = ctx->scroll_virtual_h,
+        };
+    }
+
     ctx->scroll_viewport = viewport;
     ctx->active_scroll = state;
+    state->content_frame = 0;
 
     /* Save layout origin for restoration in iui_scroll_end */
     ctx->scroll_content_start_x = ctx->layout.x;
     ctx->scroll_content_start_y = ctx->layout.y;
     ctx->scroll_content_start_width = ctx->layout.width;
+    ctx->scroll_virtual_h = 0.f;
 
     /* Unconditionally reserve scrollbar space to avoid a one-frame width
      * pop when content first exceeds view_h. */
@@ -356,21 +425,29 @@ iui_rect_t iui_scroll_begin(iui_context *ctx,
     state->scroll_x = clamp_float(0.f, max_scroll_x, state->scroll_x);
     state->scroll_y = clamp_float(0.f, max_scroll_y, state->scroll_y);
 
-    /* Apply scroll wheel input if mouse is within viewport */
-    if (in_rect(&viewport, ctx->mouse_pos)) {
-        state->scroll_x -= ctx->scroll_wheel_dx;
-        state->scroll_y -= ctx->scroll_wheel_dy;
-        state->scroll_x = clamp_float(0.f, max_scroll_x, state->scroll_x);
-        state->scroll_y = clamp_float(0.f, max_scroll_y, state->scroll_y);
-        /* Consume delta to prevent overlapping scroll regions from reusing */
+    /* Apply scroll wheel input if mouse is within viewport. Each axis goes
+     * to the region that can scroll along it, so a carousel inside a vertical
+     * feed still receives horizontal deltas.
+     */
+    bool wheel_x = scroll_wheel_route(ctx, 0, state, viewport,
+                                      hovered && max_scroll_x > 0.f);
+    bool wheel_y = scroll_wheel_route(ctx, 1, state, viewport,
+                                      hovered && max_scroll_y > 0.f);
+    if (wheel_x) {
+        state->scroll_x = clamp_float(0.f, max_scroll_x,
+                                      state->scroll_x - ctx->scroll_wheel_dx);
         ctx->scroll_wheel_dx = 0;
+    }
+    if (wheel_y) {
+        state->scroll_y = clamp_float(0.f, max_scroll_y,
+                                      state->scroll_y - ctx->scroll_wheel_dy);
         ctx->scroll_wheel_dy = 0;
     }
 
     /* Push clip rect for viewport; rollback on overflow */
     if (!iui_push_clip(ctx, viewport)) {
         ctx->layout.width = ctx->scroll_content_start_width;
-        ctx->active_scroll = NULL;
+        scroll_restore_parent(ctx);
         return (iui_rect_t) {0, 0, 0, 0};
     }
 
@@ -381,6 +458,538 @@ iui_rect_t iui_scroll_begin(iui_context *ctx,
     return viewport;
 }
 
+/* Cached scroll layers: while a cached region is open the renderer and vector
+ * callbacks are wrapped so each command is hashed, in content coordinates,
+ * into the bands of content rows it touches. On a frame that may reuse cached
+ * rows the commands are also recorded, so that the reuse decision can rest on
+ * this frame's hashes; they reach the port when the region closes.
+ */
+
+#define LAYER_Q(v) ((int32_t) lrintf((v) * 4.f)) /* quarter-pixel */
+
+/* Command codes, shared by the hashed words and the record */
+enum {
+    LAYER_BOX = 1,
+    LAYER_TEXT,
+    LAYER_LINE,
+    LAYER_CIRCLE,
+    LAYER_ARC,
+    LAYER_PATH_MOVE,
+    LAYER_PATH_LINE,
+    LAYER_PATH_CURVE,
+    LAYER_PATH_STROKE,
+    LAYER_PATH_BEGIN_RUN,
+    LAYER_GLYPH_MASK,
+    LAYER_PATH_END_RUN,
+    LAYER_CLIP,
+};
+
+static void layer_record(iui_scroll_layer *l,
+                         float y0,
+                         float y1,
+                         const int32_t *words,
+                         size_t count)
+{
+    uint32_t h = iui_hash(words, count * sizeof(int32_t));
+    float top = l->viewport.y - l->scroll_y; /* screen y of content row 0 */
+    int b0 = (int) floorf((y0 - top) / IUI_SCROLL_LAYER_BAND) - l->band;
+    int b1 = (int) floorf((y1 - top) / IUI_SCROLL_LAYER_BAND) - l->band;
+    if (b1 < 0 || b0 >= IUI_SCROLL_LAYER_TILES)
+        return; /* above or below the hashed bands */
+    if (b0 < 0)
+        b0 = 0;
+    if (b1 >= IUI_SCROLL_LAYER_TILES)
+        b1 = IUI_SCROLL_LAYER_TILES - 1;
+    for (int b = b0; b <= b1; b++)
+        l->hash[b] = (l->hash[b] ^ h) * 0x01000193;
+}
+
+static inline int32_t layer_x(const iui_scroll_layer *l, float x)
+{
+    return LAYER_Q(x - l->viewport.x);
+}
+
+static inline int32_t layer_y(const iui_scroll_layer *l, float y)
+{
+    return LAYER_Q(y - l->viewport.y + l->scroll_y);
+}
+
+static inline void layer_put(uint32_t *w, float v)
+{
+    memcpy(w, &v, sizeof(v));
+}
+
+static inline float layer_get(const uint32_t *w)
+{
+    float v;
+    memcpy(&v, w, sizeof(v));
+    return v;
+}
+
+/* Send the recorded commands to the port inside layer_begin, and draw
+ * directly from then on
+ */
+static void layer_flush(iui_scroll_layer *l, bool reuse)
+{
+    const iui_renderer_t *t = &l->target;
+    const iui_vector_t *v = l->target_vector;
+    l->recording = false;
+    l->active = t->layer_begin(l->viewport, l->scroll_y, reuse, t->user);
+
+    for (int i = 0; i < l->record_len;) {
+        const uint32_t *w = l->record + i + 1;
+        uint32_t op = l->record[i] & 0xFF;
+        i += 1 + (int) (l->record[i] >> 8);
+        switch (op) {
+        case LAYER_BOX:
+            t->draw_box((iui_rect_t) {layer_get(w), layer_get(w + 1),
+                                      layer_get(w + 2), layer_get(w + 3)},
+                        layer_get(w + 4), w[5], t->user);
+            break;
+        case LAYER_TEXT:
+            t->draw_text(layer_get(w), layer_get(w + 1),
+                         (const char *) (w + 3), w[2], t->user);
+            break;
+        case LAYER_LINE:
+            t->draw_line(layer_get(w), layer_get(w + 1), layer_get(w + 2),
+                         layer_get(w + 3), layer_get(w + 4), w[5], t->user);
+            break;
+        case LAYER_CIRCLE:
+            t->draw_circle(layer_get(w), layer_get(w + 1), layer_get(w + 2),
+                           w[3], w[4], layer_get(w + 5), t->user);
+            break;
+        case LAYER_ARC:
+            t->draw_arc(layer_get(w), layer_get(w + 1), layer_get(w + 2),
+                        layer_get(w + 3), layer_get(w + 4), layer_get(w + 5),
+                        w[6], t->user);
+            break;
+        case LAYER_PATH_MOVE:
+            v->path_move(layer_get(w), layer_get(w + 1), t->user);
+            break;
+        case LAYER_PATH_LINE:
+            v->path_line(layer_get(w), layer_get(w + 1), t->user);
+            break;
+        case LAYER_PATH_CURVE:
+            v->path_curve(layer_get(w), layer_get(w + 1), layer_get(w + 2),
+                          layer_get(w + 3), layer_get(w + 4), layer_get(w + 5),
+                          t->user);
+            break;
+        case LAYER_PATH_STROKE:
+            v->path_stroke(layer_get(w), w[1], t->user);
+            break;
+        case LAYER_PATH_BEGIN_RUN:
+            v->path_begin_run(layer_get(w), w[1], t->user);
+            break;
+        case LAYER_PATH_END_RUN:
+            v->path_end_run(t->user);
+            break;
+        case LAYER_GLYPH_MASK: {
+            iui_glyph_mask_t mask;
+            memcpy(&mask, w + 3, sizeof(mask));
+            v->draw_glyph_mask((int) w[0], (int) w[1], &mask, w[2], t->user);
+            break;
+        }
+        case LAYER_CLIP:
+            t->set_clip_rect((uint16_t) w[0], (uint16_t) (w[0] >> 16),
+                             (uint16_t) w[1], (uint16_t) (w[1] >> 16),
+                             t->user);
+            break;
+        }
+    }
+    l->record_len = 0;
+}
+
+/* Room for a command of @n payload words in the record. NULL when the layer
+ * is not recording, or the record is full: then everything recorded so far
+ * is drawn without reuse and the caller draws directly.
+ */
+static uint32_t *layer_push(iui_scroll_layer *l, uint32_t op, size_t n)
+{
+    if (!l->recording)
+        return NULL;
+    if ((size_t) (l->record_cap - l->record_len) < n + 1) {
+        layer_flush(l, false);
+        return NULL;
+    }
+    uint32_t *w = l->record + l->record_len;
+    w[0] = op | (uint32_t) n << 8;
+    l->record_len += (int) n + 1;
+    return w + 1;
+}
+
+static void layer_draw_box(iui_rect_t rect,
+                           float radius,
+                           uint32_t color,
+                           void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    int32_t w[] = {LAYER_BOX,
+                   layer_x(l, rect.x),
+                   layer_y(l, rect.y),
+                   LAYER_Q(rect.width),
+                   LAYER_Q(rect.height),
+                   LAYER_Q(radius),
+                   (int32_t) color};
+    layer_record(l, rect.y, rect.y + rect.height, w, 7);
+    uint32_t *r = layer_push(l, LAYER_BOX, 6);
+    if (!r) {
+        l->target.draw_box(rect, radius, color, l->target.user);
+        return;
+    }
+    layer_put(r, rect.x), layer_put(r + 1, rect.y);
+    layer_put(r + 2, rect.width), layer_put(r + 3, rect.height);
+    layer_put(r + 4, radius), r[5] = color;
+}
+
+static void layer_draw_text(float x,
+                            float y,
+                            const char *text,
+                            uint32_t color,
+                            void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    int32_t w[] = {LAYER_TEXT, layer_x(l, x), layer_y(l, y), (int32_t) color,
+                   (int32_t) iui_hash_str(text)};
+    layer_record(l, y, y + l->font_height, w, 5);
+    size_t size = strlen(text) + 1;
+    uint32_t *r = layer_push(l, LAYER_TEXT, 3 + (size + 3) / 4);
+    if (!r) {
+        l->target.draw_text(x, y, text, color, l->target.user);
+        return;
+    }
+    layer_put(r, x), layer_put(r + 1, y), r[2] = color;
+    memcpy(r + 3, text, size);
+}
+
+static void layer_set_clip_rect(uint16_t min_x,
+                                uint16_t min_y,
+                                uint16_t max_x,
+                                uint16_t max_y,
+                                void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    uint32_t *r = layer_push(l, LAYER_CLIP, 2);
+    if (!r) {
+        l->target.set_clip_rect(min_x, min_y, max_x, max_y, l->target.user);
+        return;
+    }
+    r[0] = min_x | (uint32_t) min_y << 16;
+    r[1] = max_x | (uint32_t) max_y << 16;
+}
+
+static float layer_text_width(const char *text, void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    return l->target.text_width(text, l->target.user);
+}
+
+static void layer_draw_line(float x0,
+                            float y0,
+                            float x1,
+                            float y1,
+                            float width,
+                            uint32_t color,
+                            void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    int32_t w[] = {LAYER_LINE,
+                   layer_x(l, x0),
+                   layer_y(l, y0),
+                   layer_x(l, x1),
+                   layer_y(l, y1),
+                   LAYER_Q(width),
+                   (int32_t) color};
+    layer_record(l, fminf(y0, y1) - width, fmaxf(y0, y1) + width, w, 7);
+    uint32_t *r = layer_push(l, LAYER_LINE, 6);
+    if (!r) {
+        l->target.draw_line(x0, y0, x1, y1, width, color, l->target.user);
+        return;
+    }
+    layer_put(r, x0), layer_put(r + 1, y0);
+    layer_put(r + 2, x1), layer_put(r + 3, y1);
+    layer_put(r + 4, width), r[5] = color;
+}
+
+static void layer_draw_circle(float cx,
+                              float cy,
+                              float radius,
+                              uint32_t fill_color,
+                              uint32_t stroke_color,
+                              float stroke_width,
+                              void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    int32_t w[] = {LAYER_CIRCLE,
+                   layer_x(l, cx),
+                   layer_y(l, cy),
+                   LAYER_Q(radius),
+                   (int32_t) fill_color,
+                   (int32_t) stroke_color,
+                   LAYER_Q(stroke_width)};
+    float rr = radius + stroke_width;
+    layer_record(l, cy - rr, cy + rr, w, 7);
+    uint32_t *r = layer_push(l, LAYER_CIRCLE, 6);
+    if (!r) {
+        l->target.draw_circle(cx, cy, radius, fill_color, stroke_color,
+                              stroke_width, l->target.user);
+        return;
+    }
+    layer_put(r, cx), layer_put(r + 1, cy), layer_put(r + 2, radius);
+    r[3] = fill_color, r[4] = stroke_color;
+    layer_put(r + 5, stroke_width);
+}
+
+static void layer_draw_arc(float cx,
+                           float cy,
+                           float radius,
+                           float start_angle,
+                           float end_angle,
+                           float width,
+                           uint32_t color,
+                           void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    int32_t w[] = {LAYER_ARC,
+                   layer_x(l, cx),
+                   layer_y(l, cy),
+                   LAYER_Q(radius),
+                   LAYER_Q(start_angle * 64.f),
+                   LAYER_Q(end_angle * 64.f),
+                   LAYER_Q(width),
+                   (int32_t) color};
+    float rr = radius + width;
+    layer_record(l, cy - rr, cy + rr, w, 8);
+    uint32_t *r = layer_push(l, LAYER_ARC, 7);
+    if (!r) {
+        l->target.draw_arc(cx, cy, radius, start_angle, end_angle, width,
+                           color, l->target.user);
+        return;
+    }
+    layer_put(r, cx), layer_put(r + 1, cy), layer_put(r + 2, radius);
+    layer_put(r + 3, start_angle), layer_put(r + 4, end_angle);
+    layer_put(r + 5, width), r[6] = color;
+}
+
+/* Path points carry the open run's pen; a plain stroke is charged to the band
+ * of the last point.
+ */
+static void layer_path_point(iui_scroll_layer *l, int32_t op, float x, float y)
+{
+    int32_t w[] = {op, layer_x(l, x), layer_y(l, y), (int32_t) l->pen};
+    layer_record(l, y, y, w, 4);
+    l->pen_y = y;
+}
+
+/* Record a path command of up to six float operands */
+static bool layer_push_path(iui_scroll_layer *l,
+                            uint32_t op,
+                            const float *args,
+                            size_t n)
+{
+    uint32_t *r = layer_push(l, op, n);
+    for (size_t i = 0; r && i < n; i++)
+        layer_put(r + i, args[i]);
+    return r != NULL;
+}
+
+static void layer_path_move(float x, float y, void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    layer_path_point(l, LAYER_PATH_MOVE, x, y);
+    if (!layer_push_path(l, LAYER_PATH_MOVE, (float[]) {x, y}, 2))
+        l->target_vector->path_move(x, y, l->target.user);
+}
+
+static void layer_path_line(float x, float y, void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    layer_path_point(l, LAYER_PATH_LINE, x, y);
+    if (!layer_push_path(l, LAYER_PATH_LINE, (float[]) {x, y}, 2))
+        l->target_vector->path_line(x, y, l->target.user);
+}
+
+static void layer_path_curve(float x1,
+                             float y1,
+                             float x2,
+                             float y2,
+                             float x3,
+                             float y3,
+                             void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    layer_path_point(l, LAYER_PATH_CURVE, x1, y1);
+    layer_path_point(l, LAYER_PATH_CURVE, x2, y2);
+    layer_path_point(l, LAYER_PATH_CURVE, x3, y3);
+    if (!layer_push_path(l, LAYER_PATH_CURVE,
+                         (float[]) {x1, y1, x2, y2, x3, y3}, 6))
+        l->target_vector->path_curve(x1, y1, x2, y2, x3, y3, l->target.user);
+}
+
+static void layer_path_stroke(float width, uint32_t color, void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    int32_t w[] = {LAYER_PATH_STROKE, LAYER_Q(width), (int32_t) color};
+    layer_record(l, l->pen_y, l->pen_y, w, 3);
+    uint32_t *r = layer_push(l, LAYER_PATH_STROKE, 2);
+    if (!r) {
+        l->target_vector->path_stroke(width, color, l->target.user);
+        return;
+    }
+    layer_put(r, width), r[1] = color;
+}
+
+static void layer_path_begin_run(float width, uint32_t color, void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    int32_t w[] = {LAYER_PATH_BEGIN_RUN, LAYER_Q(width), (int32_t) color};
+    l->pen = iui_hash(w, sizeof(w));
+    uint32_t *r = layer_push(l, LAYER_PATH_BEGIN_RUN, 2);
+    if (!r) {
+        l->target_vector->path_begin_run(width, color, l->target.user);
+        return;
+    }
+    layer_put(r, width), r[1] = color;
+}
+
+static void layer_path_end_run(void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    l->pen = 0;
+    if (!layer_push(l, LAYER_PATH_END_RUN, 0))
+        l->target_vector->path_end_run(l->target.user);
+}
+
+static void layer_draw_glyph_mask(int x,
+                                  int y,
+                                  const iui_glyph_mask_t *mask,
+                                  uint32_t color,
+                                  void *user)
+{
+    iui_scroll_layer *l = (iui_scroll_layer *) user;
+    int32_t w[] = {LAYER_GLYPH_MASK,
+                   layer_x(l, (float) x),
+                   layer_y(l, (float) y),
+                   (int32_t) (mask->x | (uint32_t) mask->y << 16),
+                   (int32_t) (mask->width | (uint32_t) mask->height << 16),
+                   (int32_t) color};
+    layer_record(l, (float) y, (float) (y + mask->height), w, 6);
+    uint32_t *r =
+        layer_push(l, LAYER_GLYPH_MASK, 3 + (sizeof(*mask) + 3) / 4);
+    if (!r) {
+        l->target_vector->draw_glyph_mask(x, y, mask, color, l->target.user);
+        return;
+    }
+    r[0] = (uint32_t) x, r[1] = (uint32_t) y, r[2] = color;
+    memcpy(r + 3, mask, sizeof(*mask));
+}
+
+iui_rect_t iui_scroll_begin_cached(iui_context *ctx,
+                                   iui_scroll_state *state,
+                                   float view_w,
+                                   float view_h,
+                                   iui_scroll_layer *layer)
+{
+    iui_rect_t viewport = iui_scroll_begin(ctx, state, view_w, view_h);
+    /* Only the outermost region is cached; nested ones are drawn into it */
+    if (!layer || viewport.height <= 0.f || ctx->scroll_depth ||
+        ctx->scroll_layer || !ctx->renderer.layer_begin ||
+        !ctx->renderer.layer_end)
+        return viewport;
+
+    /* Roll this frame's hashes over to the previous frame */
+    bool same_view = viewport.x == layer->viewport.x &&
+                     viewport.y == layer->viewport.y &&
+                     viewport.width == layer->viewport.width &&
+                     viewport.height == layer->viewport.height;
+    bool moved = state->scroll_y != layer->scroll_y;
+    memcpy(layer->prev_hash, layer->hash, sizeof(layer->hash));
+    layer->prev_band = layer->band;
+    layer->prev_scroll_y = layer->scroll_y;
+    layer->scroll_y = state->scroll_y;
+    layer->viewport = viewport;
+    layer->band = (int) floorf(state->scroll_y / IUI_SCROLL_LAYER_BAND);
+    for (int b = 0; b < IUI_SCROLL_LAYER_TILES; b++)
+        layer->hash[b] = 0x811c9dc5;
+    layer->font_height = ctx->font_height;
+    layer->pen = 0;
+    if (!same_view)
+        layer->stable = false;
+
+    /* Idle frames redraw everything, so content changes show at once. A
+     * frame that may reuse cached rows is recorded and sent to the port once
+     * its own hashes are known; hashing goes on even when the port declines.
+     */
+    layer->target = ctx->renderer;
+    layer->target_vector = ctx->vector;
+    layer->record_len = 0;
+    layer->recording = layer->stable && moved && layer->record &&
+                       layer->record_cap > 0;
+    layer->active = false;
+    if (!layer->recording)
+        layer->active = ctx->renderer.layer_begin(viewport, state->scroll_y,
+                                                  false, ctx->renderer.user);
+
+    const iui_renderer_t *t = &layer->target;
+    ctx->renderer = (iui_renderer_t) {
+        .draw_box = layer_draw_box,
+        .draw_text = t->draw_text ? layer_draw_text : NULL,
+        .set_clip_rect = layer_set_clip_rect,
+        .text_width = t->text_width ? layer_text_width : NULL,
+        .draw_line = t->draw_line ? layer_draw_line : NULL,
+        .draw_circle = t->draw_circle ? layer_draw_circle : NULL,
+        .draw_arc = t->draw_arc ? layer_draw_arc : NULL,
+        .user = layer,
+    };
+    if (ctx->vector) {
+        const iui_vector_t *v = ctx->vector;
+        layer->vector = (iui_vector_t) {
+            .path_move = v->path_move ? layer_path_move : NULL,
+            .path_line = v->path_line ? layer_path_line : NULL,
+            .path_curve = v->path_curve ? layer_path_curve : NULL,
+            .path_stroke = v->path_stroke ? layer_path_stroke : NULL,
+            .path_begin_run = v->path_begin_run ? layer_path_begin_run : NULL,
+            .path_end_run = v->path_end_run ? layer_path_end_run : NULL,
+            .draw_glyph_mask =
+                v->draw_glyph_mask ? layer_draw_glyph_mask : NULL,
+        };
+        ctx->vector = &layer->vector;
+    }
+    ctx->scroll_layer = layer;
+    return viewport;
+}
+
+/* Unwrap the port callbacks and compare every band holding rows visible in
+ * both frames. Widgets that reach the viewport are never culled, so an edge
+ * band can only report a change that is not there, never miss one. A
+ * recorded frame reuses cached rows only if they all matched.
+ */
+static void scroll_layer_close(iui_context *ctx)
+{
+    iui_scroll_layer *l = ctx->scroll_layer;
+    ctx->renderer = l->target;
+    ctx->vector = l->target_vector;
+    ctx->scroll_layer = NULL;
+
+    float lo = fmaxf(l->scroll_y, l->prev_scroll_y);
+    float hi = fminf(l->scroll_y, l->prev_scroll_y) + l->viewport.height;
+    int first = (int) floorf(lo / IUI_SCROLL_LAYER_BAND);
+    int end = (int) ceilf(hi / IUI_SCROLL_LAYER_BAND);
+    l->stable = true;
+    for (int k = first; k < end; k++) {
+        int a = k - l->band, b = k - l->prev_band;
+        if (a < 0 || b < 0 || a >= IUI_SCROLL_LAYER_TILES ||
+            b >= IUI_SCROLL_LAYER_TILES || l->hash[a] != l->prev_hash[b]) {
+            l->stable = false;
+            break;
+        }
+    }
+
+    if (l->recording)
+        layer_flush(l, l->stable);
+    if (l->active)
+        ctx->renderer.layer_end(ctx->renderer.user);
+}
+
 /* Scroll Container */
 
 bool iui_scroll_end(iui_context *ctx, iui_scroll_state *state)
@@ -394,25 +1003,38 @@ bool iui_scroll_end(iui_context *ctx, iui_scroll_state *state)
     if (ctx->active_scroll != state)
         return false;
 
-    /* Measure content size (assumes vertical-only content flow) */
-    float content_height =
-        (ctx->layout.y + state->scroll_y) - ctx->scroll_content_start_y;
-    float content_width =
-        (ctx->layout.x + state->scroll_x) - ctx->scroll_content_start_x;
+    /* The scrollbar is drawn directly, over the composited layer */
+    if (ctx->scroll_layer && !ctx->scroll_depth)
+        scroll_layer_close(ctx);
 
-    state->content_h = fmaxf(content_height, 0.f);
-    state->content_w = fmaxf(content_width, ctx->scroll_viewport.width);
+    /* Measure content size from the layout cursor: rows advance y, items in
+     * a horizontal flow advance x. Skipped while the declared content hash
+     * matches the last measurement.
+     */
+    if (state->content_frame != 2) {
+        float content_height =
+            (ctx->layout.y + state->scroll_y) - ctx->scroll_content_start_y;
+        float content_width =
+            (ctx->layout.x + state->scroll_x) - ctx->scroll_content_start_x;
+
+        /* A virtual list extends the content past the rows laid out */
+        state->content_h =
+            fmaxf(fmaxf(content_height, ctx->scroll_virtual_h), 0.f);
+        state->content_w = fmaxf(content_width, ctx->scroll_viewport.width);
+        state->content_valid = state->content_frame == 1;
+    }
 
     /* Restore layout to after the viewport */
+    iui_rect_t viewport = ctx->scroll_viewport;
     ctx->layout.x = ctx->scroll_content_start_x;
     ctx->layout.width = ctx->scroll_content_start_width;
-    ctx->layout.y = ctx->scroll_content_start_y + ctx->scroll_viewport.height +
+    ctx->layout.y = ctx->scroll_content_start_y + viewport.height +
                     ctx->padding;
 
-    ctx->active_scroll = NULL;
+    scroll_restore_parent(ctx);
 
-    bool scrollable_x = state->content_w > ctx->scroll_viewport.width;
-    bool scrollable_y = state->content_h > ctx->scroll_viewport.height;
+    bool scrollable_x = state->content_w > viewport.width;
+    bool scrollable_y = state->content_h > viewport.height;
 
     /* Release drag if scrollbar disappears (content shrunk) */
     if (ctx->scroll_dragging == state &&
@@ -422,20 +1044,18 @@ bool iui_scroll_end(iui_context *ctx, iui_scroll_state *state)
 
     if (scrollable_y) {
         float scrollbar_width = IUI_SCROLLBAR_W;
-        float track_height = ctx->scroll_viewport.height;
+        float track_height = viewport.height;
         float thumb_height =
-            fmaxf(20.f, track_height *
-                            (ctx->scroll_viewport.height / state->content_h));
+            fmaxf(20.f, track_height * (viewport.height / state->content_h));
         float thumb_y_range = track_height - thumb_height;
-        float max_scroll = state->content_h - ctx->scroll_viewport.height;
+        float max_scroll = state->content_h - viewport.height;
         float scroll_ratio =
             (max_scroll > 0.f) ? state->scroll_y / max_scroll : 0.f;
-        float thumb_y = ctx->scroll_viewport.y + thumb_y_range * scroll_ratio;
+        float thumb_y = viewport.y + thumb_y_range * scroll_ratio;
 
         iui_rect_t track_rect = {
-            .x = ctx->scroll_viewport.x + ctx->scroll_viewport.width -
-                 scrollbar_width,
-            .y = ctx->scroll_viewport.y,
+            .x = viewport.x + viewport.width - scrollbar_width,
+            .y = viewport.y,
             .width = scrollbar_width,
             .height = track_height,
         };
@@ -489,6 +1109,18 @@ bool iui_scroll_end(iui_context *ctx, iui_scroll_state *state)
     return scrollable_x || scrollable_y;
 }
 
+bool iui_scroll_content_hash(iui_context *ctx,
+                             iui_scroll_state *state,
+                             uint32_t hash)
+{
+    if (!ctx || !state || ctx->active_scroll != state)
+        return false;
+    bool hit = state->content_valid && state->content_hash == hash;
+    state->content_hash = hash;
+    state->content_frame = hit ? 2 : 1;
+    return hit;
+}
+
 void iui_scroll_by(iui_scroll_state *state, float dx, float dy)
 {
     if (!state)
@@ -1194,6 +1826,254 @@ void iui_table_end(iui_context *ctx, iui_table_state *state)
     ctx->layout.y = state->row_y + ctx->padding;
 }
 
+/* Formatted text of one cell, from the cache when it is current */
+static const char *table_source_text(iui_context *ctx,
+                                     const iui_table_source *src,
+                                     int row,
+                                     int col,
+                                     int cols)
+{
+    if (!src->cache || src->cache_size <= 0) {
+        ctx->string_buffer[0] = '\0';
+        src->cell(row, col, ctx->string_buffer, IUI_STRING_BUFFER_SIZE,
+                  src->user);
+        return ctx->string_buffer;
+    }
+
+    /* Direct-mapped: consecutive visible cells land in distinct entries */
+    size_t slot = ((size_t) row * (size_t) cols + (size_t) col) %
+                  (size_t) src->cache_size;
+    iui_table_cache_entry *e = &src->cache[slot];
+    if (!e->valid || e->row != row || e->col != col ||
+        e->version != src->version) {
+        e->text[0] = '\0';
+        src->cell(row, col, e->text, sizeof(e->text), src->user);
+        /* Formatters truncate by bytes; never keep half a code point */
+        e->text[sizeof(e->text) - 1] = '\0';
+        iui_utf8_trim_partial(e->text, strlen(e->text));
+        e->row = row, e->col = col;
+        e->version = src->version;
+        e->valid = true;
+    }
+    return e->text;
+}
+
+void iui_table_rows(iui_context *ctx,
+                    iui_table_state *state,
+                    iui_scroll_state *scroll,
+                    float height,
+                    const iui_table_source *src)
+{
+    if (!ctx || !ctx->current_window || !state || !scroll || !src ||
+        !src->cell || state->cols <= 0)
+        return;
+
+    /* Headers stay outside the scroll region, so they never scroll away */
+    ctx->layout.y = state->row_y;
+    iui_scroll_begin(ctx, scroll, 0.f, height);
+    if (ctx->active_scroll != scroll)
+        return; /* region not opened: no clip to pop */
+
+    iui_list_range range = iui_list_virtual_begin(ctx, scroll, src->row_count,
+                                                  IUI_TABLE_ROW_HEIGHT);
+    float row_w = ctx->layout.width;
+    for (int row = range.first; row < range.last; row++) {
+        float y = ctx->layout.y;
+
+        /* One zebra stripe per row rather than one box per cell */
+        if (row % 2 == 1)
+            ctx->renderer.draw_box(
+                (iui_rect_t) {state->start_x, y, row_w, IUI_TABLE_ROW_HEIGHT},
+                0.f, ctx->colors.surface_container_low, ctx->renderer.user);
+
+        float x = state->start_x;
+        float text_y = y + (IUI_TABLE_ROW_HEIGHT - ctx->font_height) * 0.5f;
+        for (int col = 0; col < state->cols; col++) {
+            const char *text =
+                table_source_text(ctx, src, row, col, state->cols);
+            iui_internal_draw_text(ctx, x + IUI_TABLE_CELL_PADDING, text_y,
+                                   text, ctx->colors.on_surface);
+            x += state->widths[col];
+        }
+
+        ctx->renderer.draw_box(
+            (iui_rect_t) {state->start_x,
+                          y + IUI_TABLE_ROW_HEIGHT - IUI_TABLE_DIVIDER_HEIGHT,
+                          row_w, IUI_TABLE_DIVIDER_HEIGHT},
+            0.f, ctx->colors.outline_variant, ctx->renderer.user);
+        ctx->layout.y += IUI_TABLE_ROW_HEIGHT;
+    }
+    state->row_index = range.last - 1;
+
+    iui_scroll_end(ctx, scroll);
+    /* iui_table_end adds the trailing padding again */
+    state->row_y = ctx->layout.y - ctx->padding;
+}
+
+/* Table model */
+
+bool iui_table_model_init(iui_table_model *m,
+                          int *storage,
+                          int capacity,
+                          iui_table_compare_func_t compare,
+                          iui_table_filter_func_t filter,
+                          void *user)
+{
+    if (!m || !storage || capacity <= 0 || capacity > INT32_MAX / 4)
+        return false;
+    *m = (iui_table_model) {
+        .order = storage,
+        .scratch = storage + capacity,
+        .visible = storage + 2 * capacity,
+        .passes = (uint32_t *) (storage + 3 * capacity),
+        .capacity = capacity,
+        .sort_column = -1,
+        .sort_ascending = true,
+        .compare = compare,
+        .filter = filter,
+        .user = user,
+    };
+    return true;
+}
+
+static int model_compare(const iui_table_model *m, int a, int b)
+{
+    int c = m->compare(a, b, m->sort_column, m->user);
+    return m->sort_ascending ? c : -c;
+}
+
+static bool model_sorted(const iui_table_model *m)
+{
+    return m->compare && m->sort_column >= 0;
+}
+
+/* Stable merge of order[lo, mid) and order[mid, hi); ties keep left first */
+static void model_merge(iui_table_model *m, int lo, int mid, int hi)
+{
+    int *a = m->order, *tmp = m->scratch;
+    if (model_compare(m, a[mid], a[mid - 1]) >= 0)
+        return; /* already in order, common for appends */
+
+    int i = lo, j = mid, k = lo;
+    while (i < mid && j < hi)
+        tmp[k++] = model_compare(m, a[j], a[i]) < 0 ? a[j++] : a[i++];
+    while (i < mid)
+        tmp[k++] = a[i++];
+    while (j < hi)
+        tmp[k++] = a[j++];
+    memcpy(a + lo, tmp + lo, sizeof(int) * (size_t) (hi - lo));
+}
+
+/* Bottom-up merge sort of order[lo, hi) */
+static void model_sort_range(iui_table_model *m, int lo, int hi)
+{
+    for (int width = 1; width < hi - lo; width *= 2) {
+        for (int l = lo; l < hi - width; l += 2 * width) {
+            int r = (hi - l > 2 * width) ? l + 2 * width : hi;
+            model_merge(m, l, l + width, r);
+        }
+    }
+}
+
+static void model_set_pass(iui_table_model *m, int row, bool pass)
+{
+    uint32_t bit = 1u << (row & 31);
+    if (pass)
+        m->passes[row >> 5] |= bit;
+    else
+        m->passes[row >> 5] &= ~bit;
+}
+
+static bool model_passes(const iui_table_model *m, int row)
+{
+    return (m->passes[row >> 5] >> (row & 31)) & 1u;
+}
+
+static void model_collect_visible(iui_table_model *m)
+{
+    int n = 0;
+    for (int i = 0; i < m->row_count; i++) {
+        if (model_passes(m, m->order[i]))
+            m->visible[n++] = m->order[i];
+    }
+    m->visible_count = n;
+    m->version++;
+}
+
+void iui_table_model_sync(iui_table_model *m,
+                          const iui_table_state *state,
+                          int row_count)
+{
+    if (!m)
+        return;
+    if (row_count < 0)
+        row_count = 0;
+    if (row_count > m->capacity)
+        row_count = m->capacity;
+
+    int old = m->row_count;
+    if (state && (state->sort_column != m->sort_column ||
+                  state->sort_ascending != m->sort_ascending)) {
+        m->sort_column = state->sort_column;
+        m->sort_ascending = state->sort_ascending;
+        old = 0;
+    }
+    if (row_count < m->row_count) {
+        /* Rows went away: remaining indices need a fresh permutation */
+        old = 0;
+        if (m->filtered_count > row_count)
+            m->filtered_count = row_count;
+    }
+    if (old == m->row_count && row_count == m->row_count)
+        return;
+
+    for (int row = m->filtered_count; row < row_count; row++)
+        model_set_pass(m, row, !m->filter || m->filter(row, m->user));
+    m->filtered_count = row_count;
+
+    for (int i = old; i < row_count; i++)
+        m->order[i] = i;
+    m->row_count = row_count;
+    if (model_sorted(m) && row_count > old) {
+        model_sort_range(m, old, row_count);
+        if (old > 0)
+            model_merge(m, 0, old, row_count);
+    }
+    model_collect_visible(m);
+}
+
+void iui_table_model_filter(iui_table_model *m, bool narrowing)
+{
+    if (!m)
+        return;
+
+    if (!narrowing) {
+        for (int row = 0; row < m->row_count; row++)
+            model_set_pass(m, row, !m->filter || m->filter(row, m->user));
+        model_collect_visible(m);
+        return;
+    }
+
+    /* Hidden rows stay hidden: re-test and compact the visible list only */
+    int n = 0;
+    for (int i = 0; i < m->visible_count; i++) {
+        int row = m->visible[i];
+        bool pass = !m->filter || m->filter(row, m->user);
+        model_set_pass(m, row, pass);
+        if (pass)
+            m->visible[n++] = row;
+    }
+    m->visible_count = n;
+    m->version++;
+}
+
+int iui_table_model_row(const iui_table_model *m, int index)
+{
+    if (!m || index < 0 || index >= m->visible_count)
+        return -1;
+    return m->visible[index];
+}
+
 /* MD3 Carousel */
 
 void iui_carousel_begin(iui_context *ctx,
@@ -1233,6 +2113,18 @@ bool iui_carousel_item(iui_context *ctx,
 
     iui_rect_t item_rect = {item_x, item_y, state->item_width,
                             state->item_height};
+
+    /* Items scrolled out of the viewport only advance the layout */
+    const iui_rect_t *view = &ctx->scroll_viewport;
+    if (ctx->active_scroll == &state->scroll &&
+        (item_x + state->item_width <= view->x ||
+         item_x >= view->x + view->width)) {
+        state->item_count++;
+        ctx->layout.x += state->item_width;
+        ctx->layout.height = state->item_height;
+        return false;
+    }
+
     iui_state_t comp_state = iui_get_component_state(ctx, item_rect, false);
 
     /* Determine colors */
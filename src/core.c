@@ -446,6 +446,15 @@ static float iui_vector_side_bearing(float scale, float pen_w)
     return fmaxf(pen_w + scale * IUI_FONT_SIDE_BEARING_EXTRA, min_margin);
 }
 
+/* Full pen advance of one glyph: outline width plus both side bearings */
+static inline float iui_vector_glyph_advance(const signed char *g,
+                                             float scale,
+                                             float side)
+{
+    float glyph_w = (float) (IUI_GLYPH_RIGHT(g) - IUI_GLYPH_LEFT(g)) * scale;
+    return glyph_w + side * 2.f;
+}
+
 float iui_text_width_vec(const char *text, float font_height)
 {
     if (font_height <= 0.f)
@@ -454,12 +463,17 @@ float iui_text_width_vec(const char *text, float font_height)
     float w = 0.f, scale = font_height / IUI_FONT_UNITS_PER_EM;
     const float pen_w = iui_vector_pen_for_height(font_height);
     const float side = iui_vector_side_bearing(scale, pen_w);
-    for (; *text; ++text) {
-        unsigned char c = (unsigned char) *text;
-        const signed char *g = iui_get_glyph(c);
-        float glyph_w =
-            (float) (IUI_GLYPH_RIGHT(g) - IUI_GLYPH_LEFT(g)) * scale;
-        w += glyph_w + side * 2.f;
+    /* One glyph per codepoint; non-ASCII has no context packs: box glyph */
+    size_t len = strlen(text);
+    for (size_t i = 0; i < len;) {
+        size_t end = iui_utf8_ascii_run(text, i, len);
+        for (; i < end; i++)
+            w += iui_vector_glyph_advance(
+                iui_get_glyph((unsigned char) text[i]), scale, side);
+        if (i < len) {
+            w += iui_vector_glyph_advance(iui_get_glyph(0), scale, side);
+            i = iui_utf8_next(text, i, len);
+        }
     }
     return w;
 }
@@ -478,145 +492,407 @@ float iui_codepoint_width_vec(uint32_t cp, float font_height)
     const float side = iui_vector_side_bearing(scale, pen_w);
     /* iui_get_glyph handles out-of-range codepoints by returning box glyph */
     const signed char *g = iui_get_glyph((unsigned char) (cp > 0x7F ? 0 : cp));
-    float glyph_w = (float) (IUI_GLYPH_RIGHT(g) - IUI_GLYPH_LEFT(g)) * scale;
-    return glyph_w + side * 2.f;
+    return iui_vector_glyph_advance(g, scale, side);
+}
+
+float iui_glyph_advance_of(const iui_context *ctx, const signed char *g)
+{
+    if (ctx->font_height <= 0.f)
+        return 0.f;
+
+    float scale = ctx->font_height / IUI_FONT_UNITS_PER_EM;
+    const float pen_w = iui_vector_pen_for_height(ctx->font_height);
+    return iui_vector_glyph_advance(
+        g, scale, iui_vector_side_bearing(scale, pen_w));
+}
+
+/* Glyph advance tables
+ * Scale, pen width and side bearing depend only on the font size, so the
+ * per-glyph advance is computed once per size instead of once per character.
+ */
+
+static void glyph_advance_build(iui_glyph_advance_table *t, float font_height)
+{
+    t->font_height = font_height;
+    if (font_height <= 0.f) {
+        memset(t->advance, 0, sizeof(t->advance));
+        return;
+    }
+
+    float scale = font_height / IUI_FONT_UNITS_PER_EM;
+    const float pen_w = iui_vector_pen_for_height(font_height);
+    const float side = iui_vector_side_bearing(scale, pen_w);
+    t->advance[0] = iui_vector_glyph_advance(iui_get_glyph(0), scale, side);
+    for (int c = 32; c < 127; ++c)
+        t->advance[c - 31] =
+            iui_vector_glyph_advance(iui_get_glyph(c), scale, side);
+}
+
+void iui_glyph_advance_init(iui_context *ctx)
+{
+    if (!ctx)
+        return;
+
+    memset(&ctx->glyph_advance, 0, sizeof(ctx->glyph_advance));
+    glyph_advance_build(&ctx->glyph_advance.tables[0], ctx->font_height);
+    ctx->glyph_advance.current = 0;
+    ctx->glyph_advance.next = 1 % IUI_GLYPH_ADVANCE_SIZES;
+}
+
+const float *iui_glyph_advances(iui_context *ctx)
+{
+    iui_glyph_advance_state *st = &ctx->glyph_advance;
+    iui_glyph_advance_table *t = &st->tables[st->current];
+    if (t->font_height == ctx->font_height)
+        return t->advance;
+
+    /* Font size changed (typography scale, port resize): look for a resident
+     * table before rebuilding one.
+     */
+    for (int i = 0; i < IUI_GLYPH_ADVANCE_SIZES; i++) {
+        if (st->tables[i].font_height == ctx->font_height) {
+            st->current = i;
+            return st->tables[i].advance;
+        }
+    }
+
+    st->current = st->next;
+    st->next = (st->next + 1) % IUI_GLYPH_ADVANCE_SIZES;
+    t = &st->tables[st->current];
+    glyph_advance_build(t, ctx->font_height);
+    return t->advance;
+}
+
+float iui_text_width_adv(iui_context *ctx, const char *text)
+{
+    const float *advance = iui_glyph_advances(ctx);
+    size_t len = strlen(text);
+    float w = 0.f;
+    for (size_t i = 0; i < len;) {
+        size_t end = iui_utf8_ascii_run(text, i, len);
+        for (; i < end; i++)
+            w += advance[iui_glyph_advance_index((unsigned char) text[i])];
+        if (i < len) {
+            uint32_t cp = iui_utf8_decode(text, i, len);
+            w += ctx->glyph_pack_count > 0
+                     ? iui_glyph_advance_of(ctx,
+                                            iui_glyph_lookup(ctx, cp, NULL))
+                     : advance[0];
+            i = iui_utf8_next(text, i, len);
+        }
+    }
+    return w;
+}
+
+/* Glyph outline cache
+ * Each glyph's bytecode is flattened once per font size into fixed-point
+ * polylines (curves subdivided with the ports' adaptive segment count), so
+ * drawing text streams stored points without any Bezier evaluation.
+ */
+
+void iui_glyph_cache_init(iui_context *ctx)
+{
+    if (!ctx)
+        return;
+
+    iui_glyph_cache_state *gc = &ctx->glyph_cache;
+    if (gc->entries)
+        memset(gc->entries, 0, sizeof(*gc->entries) * (gc->mask + 1));
+    ctx->glyph_cache.used = 0;
+    ctx->glyph_cache.hits = 0, ctx->glyph_cache.misses = 0;
+}
+
+/* Pixels per fixed-point step for a font size (1/16 px, whole pixels for
+ * sizes whose outlines would overflow int16 at that precision)
+ */
+static inline float glyph_cache_unit(float font_height)
+{
+    return font_height <= IUI_GLYPH_CACHE_FINE_MAX ? 1.f / 16.f : 1.f;
+}
+
+/* Flatten glyph bytecode into out[] relative to the glyph origin. Pack
+ * glyphs pass the end of their pack data in @end and every opcode and its
+ * operands are checked against it; built-in glyphs pass NULL.
+ * Returns the number of points written, -1 if cap is too small, or -2 if the
+ * bytecode runs past @end.
+ */
+static int glyph_flatten(const signed char *g,
+                         const signed char *end,
+                         float scale,
+                         float unit,
+                         iui_glyph_point *out,
+                         int cap)
+{
+    if (end && (IUI_GLYPH_N_SNAP_X(g) < 0 || IUI_GLYPH_N_SNAP_Y(g) < 0))
+        return -2;
+    const signed char *it = IUI_GLYPH_DRAW(g);
+    float inv_unit = 1.f / unit, x = 0.f, y = 0.f;
+    int n = 0;
+
+#define GLYPH_NEED(k)              \
+    do {                           \
+        if (end && end - it < (k)) \
+            return -2;             \
+    } while (0)
+
+#define GLYPH_EMIT(px, py)                                          \
+    do {                                                            \
+        if (n >= cap)                                               \
+            return -1;                                              \
+        out[n].x = (int16_t) floorf((px) * inv_unit + 0.5f);        \
+        out[n].y = (int16_t) floorf((py) * inv_unit + 0.5f);        \
+        n++;                                                        \
+    } while (0)
+
+    for (;;) {
+        GLYPH_NEED(1);
+        switch (*it++) {
+        case 'm':
+            GLYPH_NEED(2);
+            if (n >= cap)
+                return -1;
+            out[n].x = IUI_GLYPH_CACHE_BREAK, out[n].y = 0;
+            n++;
+            x = it[0] * scale, y = it[1] * scale;
+            GLYPH_EMIT(x, y);
+            it += 2;
+            break;
+        case 'l':
+            GLYPH_NEED(2);
+            x = it[0] * scale, y = it[1] * scale;
+            GLYPH_EMIT(x, y);
+            it += 2;
+            break;
+        case 'c': {
+            GLYPH_NEED(6);
+            float x0 = x, y0 = y;
+            float x1 = it[0] * scale, y1 = it[1] * scale;
+            float x2 = it[2] * scale, y2 = it[3] * scale;
+            float x3 = it[4] * scale, y3 = it[5] * scale;
+            /* Same Manhattan-length heuristic as IUI_BEZIER_SEGMENTS */
+            float approx_len = fabsf(x1 - x0) + fabsf(y1 - y0) +
+                               fabsf(x2 - x1) + fabsf(y2 - y1) +
+                               fabsf(x3 - x2) + fabsf(y3 - y2);
+            int segments = (int) fminf(fmaxf(approx_len * 0.15f, 4.f), 12.f);
+            float inv_seg = 1.f / (float) segments;
+            for (int i = 1; i <= segments; i++) {
+                float t = (float) i * inv_seg;
+                float u = 1.f - t;
+                float px = u * u * u * x0 + 3 * u * u * t * x1 +
+                           3 * u * t * t * x2 + t * t * t * x3;
+                float py = u * u * u * y0 + 3 * u * u * t * y1 +
+                           3 * u * t * t * y2 + t * t * t * y3;
+                GLYPH_EMIT(px, py);
+            }
+            x = x3, y = y3;
+            it += 6;
+            break;
+        }
+        case 'e':
+        default:
+            return n;
+        }
+    }
+#undef GLYPH_NEED
+#undef GLYPH_EMIT
+}
+
+/* Look up or build the flattened outline of glyph key at the current
+ * font size. Returns NULL if the cache is disabled or a single glyph cannot
+ * fit the arena. A malformed pack glyph is cached as an empty outline.
+ */
+static const iui_glyph_cache_entry *glyph_cache_get(iui_context *ctx,
+                                                    const signed char *g,
+                                                    const signed char *end,
+                                                    uint32_t key)
+{
+    iui_glyph_cache_state *gc = &ctx->glyph_cache;
+    float fh = ctx->font_height;
+    uint32_t fh_bits;
+    memcpy(&fh_bits, &fh, sizeof(fh_bits));
+    uint32_t start = (key * 2654435769u) ^ (fh_bits * 40503u);
+    iui_glyph_cache_entry *slot = NULL;
+
+    if (!gc->entries)
+        return NULL;
+
+    for (int i = 0; i < IUI_GLYPH_CACHE_PROBE_LEN; i++) {
+        iui_glyph_cache_entry *e = &gc->entries[(start + i) & gc->mask];
+        if (e->font_height == 0.f) {
+            slot = e;
+            break;
+        }
+        if (e->font_height == fh && e->glyph == key) {
+            gc->hits++;
+            return e;
+        }
+    }
+    gc->misses++;
+
+    float scale = fh / IUI_FONT_UNITS_PER_EM, unit = glyph_cache_unit(fh);
+    int n = slot ? glyph_flatten(g, end, scale, unit, gc->points + gc->used,
+                                 gc->capacity - gc->used)
+                 : -1;
+    if (n == -1) {
+        /* Probe window or arena exhausted: start over with an empty cache */
+        memset(gc->entries, 0, sizeof(*gc->entries) * (gc->mask + 1));
+        gc->used = 0;
+        slot = &gc->entries[start & gc->mask];
+        n = glyph_flatten(g, end, scale, unit, gc->points, gc->capacity);
+        if (n == -1)
+            return NULL;
+    }
+    if (n < 0)
+        n = 0; /* truncated bytecode: draw nothing, and don't re-parse it */
+
+    slot->font_height = fh;
+    slot->glyph = key;
+    slot->start = (uint16_t) gc->used;
+    slot->count = (uint16_t) n;
+    gc->used += n;
+    return slot;
 }
 
 /* Emit vector commands for drawing a glyph.
  * @ctx:     Current UI context
  * @g:       Pointer to glyph data
+ * @g_end:   End of the pack data holding @g, NULL for built-in glyphs
+ * @key:     Glyph cache key (advance index or IUI_GLYPH_PACK_KEY)
  * @base_x:  X coordinate for glyph placement
  * @base_y:  Y coordinate for glyph placement
  * @color:   Color to draw the glyph with
+ * @run:     Inside a text run: subpaths are stroked by path_end_run
  */
 static void iui_emit_glyph(iui_context *ctx,
                            const signed char *g,
+                           const signed char *g_end,
+                           uint32_t key,
                            float base_x,
                            float base_y,
-                           uint32_t color)
+                           uint32_t color,
+                           bool run)
 {
     float scale = ctx->font_height / IUI_FONT_UNITS_PER_EM;
+    float unit = glyph_cache_unit(ctx->font_height);
+    iui_glyph_point scratch[IUI_GLYPH_SCRATCH_POINTS];
+    const iui_glyph_point *pt = scratch;
+    int count;
+
+    const iui_glyph_cache_entry *e = glyph_cache_get(ctx, g, g_end, key);
+    if (e) {
+        pt = ctx->glyph_cache.points + e->start;
+        count = e->count;
+    } else {
+        /* No cache, or an outline larger than it: flatten on the stack */
+        count = glyph_flatten(g, g_end, scale, unit, scratch,
+                              IUI_GLYPH_SCRATCH_POINTS);
+        if (count < 0)
+            return;
+    }
+    if (count == 0)
+        return; /* empty or malformed outline: nothing to stroke */
+
     float pen_w = ctx->pen_width;
-    const signed char *it = IUI_GLYPH_DRAW(g);
-    float ox = base_x - IUI_GLYPH_LEFT(g) * scale;
-    /* Glyph's local coordinate system has baseline at y=0. */
-    /* To align glyph's baseline with text baseline (base_y), start at base_y.
+    /* Glyph's local coordinate system has baseline at y=0, so the origin
+     * sits on the text baseline (base_y).
      */
-    float oy = base_y;
+    float ox = base_x - IUI_GLYPH_LEFT(g) * scale, oy = base_y;
+    const iui_glyph_point *end = pt + count;
     float x = ox, y = oy;
-    bool in_path = false; /* track if path content exists to stroke */
+    bool in_path = false, move = false;
 
-    for (;;) {
-        switch (*it++) {
-        case 'm':
+    for (; pt < end; pt++) {
+        if (pt->x == IUI_GLYPH_CACHE_BREAK) {
             /* Stroke any existing sub-path before starting a new one */
-            if (ctx->vector && in_path) {
+            if (ctx->vector && in_path && !run) {
                 ctx->vector->path_stroke(pen_w, color, ctx->renderer.user);
                 in_path = false;
             }
-            x = ox + it[0] * scale;
-            y = oy + it[1] * scale;
-            if (ctx->vector) {
-                float sx = floorf(x + 0.5f);
-                float sy = floorf(y + 0.5f);
+            move = true;
+            continue;
+        }
+
+        float nx = ox + pt->x * unit, ny = oy + pt->y * unit;
+        if (ctx->vector) {
+            /* Snap to pixel grid for crisper strokes */
+            float sx = floorf(nx + 0.5f), sy = floorf(ny + 0.5f);
+            if (move) {
                 ctx->vector->path_move(sx, sy, ctx->renderer.user);
-                x = sx;
-                y = sy;
-            }
-            it += 2;
-            break;
-        case 'l': {
-            float nx = ox + it[0] * scale;
-            float ny = oy + it[1] * scale;
-            if (ctx->vector) {
-                float sx = floorf(nx + 0.5f);
-                float sy = floorf(ny + 0.5f);
+            } else {
                 ctx->vector->path_line(sx, sy, ctx->renderer.user);
-                nx = sx, ny = sy;
                 in_path = true;
-            } else {
-                /* Fallback: draw line as thin box */
-                float dx = nx - x, dy = ny - y;
-                float len = sqrtf(dx * dx + dy * dy);
-                if (len > 0.5f) {
-                    float mx = (x + nx) * 0.5f, my = (y + ny) * 0.5f;
-                    float w = fmaxf(len, 1.f), h = fmaxf(pen_w, 1.f);
-                    if (fabsf(dx) > fabsf(dy))
-                        ctx->renderer.draw_box(
-                            (iui_rect_t) {fminf(x, nx), my - h * 0.5f, w, h}, 0,
-                            color, ctx->renderer.user);
-                    else
-                        ctx->renderer.draw_box(
-                            (iui_rect_t) {mx - h * 0.5f, fminf(y, ny), h, len},
-                            0, color, ctx->renderer.user);
-                }
             }
-            x = nx, y = ny;
-            it += 2;
-            break;
-        }
-        case 'c':
-            if (ctx->vector) {
-                float cx1 = floorf((ox + it[0] * scale) + 0.5f);
-                float cy1 = floorf((oy + it[1] * scale) + 0.5f);
-                float cx2 = floorf((ox + it[2] * scale) + 0.5f);
-                float cy2 = floorf((oy + it[3] * scale) + 0.5f);
-                float cx3 = floorf((ox + it[4] * scale) + 0.5f);
-                float cy3 = floorf((oy + it[5] * scale) + 0.5f);
-                ctx->vector->path_curve(cx1, cy1, cx2, cy2, cx3, cy3,
-                                        ctx->renderer.user);
-                in_path = true;
-            } else {
-                /* Fallback: approximate curve with adaptive subdivision */
-                float x0 = x, y0 = y;
-                float x1 = ox + it[0] * scale, y1 = oy + it[1] * scale;
-                float x2 = ox + it[2] * scale, y2 = oy + it[3] * scale;
-                float x3 = ox + it[4] * scale, y3 = oy + it[5] * scale;
-                /* Use Manhattan distance for cheap length estimate */
-                float approx_len = fabsf(x1 - x0) + fabsf(y1 - y0) +
-                                   fabsf(x2 - x1) + fabsf(y2 - y1) +
-                                   fabsf(x3 - x2) + fabsf(y3 - y2);
-                /* Adaptive segments: 4-12 based on curve size (avoid sqrtf) */
-                int segments =
-                    (int) fminf(fmaxf(approx_len * 0.25f, 4.f), 12.f);
-                float inv_seg = 1.f / (float) segments;
-                for (int i = 1; i <= segments; i++) {
-                    float t = (float) i * inv_seg;
-                    float u = 1.f - t;
-                    float nx = u * u * u * x0 + 3 * u * u * t * x1 +
-                               3 * u * t * t * x2 + t * t * t * x3;
-                    float ny = u * u * u * y0 + 3 * u * u * t * y1 +
-                               3 * u * t * t * y2 + t * t * t * y3;
-                    float dx = nx - x, dy = ny - y;
-                    float len = sqrtf(dx * dx + dy * dy);
-                    if (len > 0.5f) {
-                        float w = fmaxf(len, 1.f), h = fmaxf(pen_w, 1.f);
-                        if (fabsf(dx) > fabsf(dy))
-                            ctx->renderer.draw_box(
-                                (iui_rect_t) {fminf(x, nx),
-                                              (y + ny) * 0.5f - h * 0.5f, w, h},
-                                0, color, ctx->renderer.user);
-                        else
-                            ctx->renderer.draw_box(
-                                (iui_rect_t) {(x + nx) * 0.5f - h * 0.5f,
-                                              fminf(y, ny), h, len},
-                                0, color, ctx->renderer.user);
-                    }
-                    x = nx;
-                    y = ny;
-                }
+        } else if (!move) {
+            /* Fallback: draw segment as thin axis-aligned box */
+            float dx = nx - x, dy = ny - y;
+            float len = sqrtf(dx * dx + dy * dy);
+            if (len > 0.5f) {
+                float w = fmaxf(len, 1.f), h = fmaxf(pen_w, 1.f);
+                if (fabsf(dx) > fabsf(dy))
+                    ctx->renderer.draw_box(
+                        (iui_rect_t) {fminf(x, nx), (y + ny) * 0.5f - h * 0.5f,
+                                      w, h},
+                        0, color, ctx->renderer.user);
+                else
+                    ctx->renderer.draw_box(
+                        (iui_rect_t) {(x + nx) * 0.5f - h * 0.5f,
+                                      fminf(y, ny), h, len},
+                        0, color, ctx->renderer.user);
             }
-            x = ox + it[4] * scale;
-            y = oy + it[5] * scale;
-            it += 6;
-            break;
-        case 'e':
-            if (ctx->vector)
-                ctx->vector->path_stroke(pen_w, color, ctx->renderer.user);
-            return;
-        default:
-            return; /* safety */
         }
+        x = nx, y = ny;
+        move = false;
+    }
+
+    if (ctx->vector && !run)
+        ctx->vector->path_stroke(pen_w, color, ctx->renderer.user);
+}
+
+/* One glyph of a UTF-8 string, as resolved by text_next_glyph */
+typedef struct {
+    const signed char *g;   /* bytecode */
+    const signed char *end; /* pack data end, NULL for built-in glyphs */
+    uint32_t key;           /* glyph cache key */
+    int gi;                 /* advance table index, -1 for pack glyphs */
+    float advance;
+} iui_text_glyph;
+
+/* Resolve the glyph at text[*pos] and step past it. Bytes inside the current
+ * ASCII run (*ascii_end) are a table lookup; other codepoints are decoded and
+ * looked up in the glyph packs.
+ */
+static inline void text_next_glyph(iui_context *ctx,
+                                   const float *advance,
+                                   const char *text,
+                                   size_t len,
+                                   size_t *pos,
+                                   size_t *ascii_end,
+                                   iui_text_glyph *out)
+{
+    size_t i = *pos;
+    if (i >= *ascii_end)
+        *ascii_end = iui_utf8_ascii_run(text, i, len);
+
+    uint32_t cp = 0;
+    if (i < *ascii_end) {
+        unsigned char c = (unsigned char) text[i];
+        out->gi = iui_glyph_advance_index(c);
+        out->g = iui_get_glyph(c);
+        out->end = NULL;
+        *pos = i + 1;
+    } else {
+        cp = iui_utf8_decode(text, i, len);
+        out->g = iui_glyph_lookup(ctx, cp, &out->end);
+        out->gi = (out->g == iui_glyph_table) ? 0 : -1;
+        *pos = iui_utf8_next(text, i, len);
+    }
+
+    if (out->gi >= 0) {
+        out->key = (uint32_t) out->gi;
+        out->advance = advance[out->gi];
+    } else {
+        out->key = IUI_GLYPH_PACK_KEY(cp);
+        out->advance = iui_glyph_advance_of(ctx, out->g);
     }
 }
 
@@ -630,27 +906,286 @@ void iui_draw_text_vec(iui_context *ctx,
         return;
     float scale = ctx->font_height / IUI_FONT_UNITS_PER_EM;
     const float side = iui_vector_side_bearing(scale, ctx->pen_width);
+    const float *advance = iui_glyph_advances(ctx);
     /* Use measured ascent/descent for stable baseline placement */
     float baseline_y = y + ctx->font_ascent_px;
     /* Snap to pixel grid for crisper strokes */
     baseline_y = floorf(baseline_y + 0.5f);
     float cursor_x = floorf(x + 0.5f);
-
-    for (; *text; ++text) {
-        unsigned char c = (unsigned char) *text;
-        const signed char *g = iui_get_glyph(c);
-        float glyph_w =
-            (float) (IUI_GLYPH_RIGHT(g) - IUI_GLYPH_LEFT(g)) * scale;
-        iui_emit_glyph(ctx, g, cursor_x + side, baseline_y, color);
-        cursor_x += glyph_w + side * 2.f;
+    size_t len = strlen(text), pos = 0, ascii_end = 0;
+    iui_text_glyph tg;
+
+#ifdef CONFIG_FEATURE_FONT_ATLAS
+    /* Baked sizes are blitted from the atlas with no outline work at all */
+    int atlas = (ctx->vector && ctx->vector->draw_glyph_mask)
+                    ? iui_font_atlas_find(ctx->font_height)
+                    : -1;
+    if (atlas >= 0) {
+        while (pos < len) {
+            text_next_glyph(ctx, advance, text, len, &pos, &ascii_end, &tg);
+            iui_glyph_mask_t mask;
+            int dx, dy;
+            if (tg.gi < 0) {
+                /* Pack glyphs are not baked: stroke them individually */
+                iui_emit_glyph(ctx, tg.g, tg.end, tg.key, cursor_x + side,
+                               baseline_y, color, false);
+            } else if (iui_font_atlas_glyph(atlas, tg.gi, &mask, &dx, &dy)) {
+                float ox = cursor_x + side - IUI_GLYPH_LEFT(tg.g) * scale;
+                ctx->vector->draw_glyph_mask(
+                    (int) floorf(ox + 0.5f) + dx, (int) baseline_y + dy,
+                    &mask, color, ctx->renderer.user);
+            }
+            cursor_x += tg.advance;
+        }
+        return;
     }
+#endif /* CONFIG_FEATURE_FONT_ATLAS */
+
+    /* Stroke the whole string once when the backend supports text runs */
+    bool run = ctx->vector && ctx->vector->path_begin_run &&
+               ctx->vector->path_end_run;
+    if (run)
+        ctx->vector->path_begin_run(ctx->pen_width, color, ctx->renderer.user);
+
+    while (pos < len) {
+        text_next_glyph(ctx, advance, text, len, &pos, &ascii_end, &tg);
+        iui_emit_glyph(ctx, tg.g, tg.end, tg.key, cursor_x + side, baseline_y,
+                       color, run);
+        cursor_x += tg.advance;
+    }
+
+    if (run)
+        ctx->vector->path_end_run(ctx->renderer.user);
 }
 
 /* Core Initialization and Input Handling */
 
+/* Layout stacks and the window table live in the caller's buffer right
+ * behind the context, sized from the capacities in iui_config_t (zero picks
+ * the compile-time default).
+ */
+#define IUI_ARENA_ALIGN(n) (((n) + 7) & ~(size_t) 7)
+
+typedef struct {
+    int box_depth, box_children, id_stack, clip_stack, windows, regions;
+    int events, widget_states, widget_map, focusable, textfields, sliders;
+    int scroll_depth, glyph_points, paragraphs;
+} iui_arena_caps;
+
+/* Optional tables: 0 keeps @def, a negative count turns the table off */
+static int optional_cap(int requested, int def)
+{
+    return requested > 0 ? requested : requested < 0 ? 0 : def;
+}
+
+static iui_arena_caps arena_caps(const iui_config_t *config)
+{
+    iui_arena_caps caps = {IUI_MAX_BOX_DEPTH, IUI_MAX_BOX_CHILDREN,
+                           IUI_ID_STACK_SIZE, IUI_CLIP_STACK_SIZE,
+                           IUI_MAX_WINDOWS, IUI_MAX_BLOCKING_REGIONS,
+                           IUI_MAX_INPUT_EVENTS, IUI_MAX_WIDGET_STATES,
+                           IUI_WIDGET_MAP_SIZE, IUI_MAX_FOCUSABLE_WIDGETS,
+                           IUI_MAX_TRACKED_TEXTFIELDS, IUI_MAX_TRACKED_SLIDERS,
+                           IUI_SCROLL_STACK_SIZE, IUI_GLYPH_CACHE_POINTS,
+                           IUI_PARAGRAPH_CACHE_SIZE};
+    if (!config)
+        return caps;
+    if (config->max_box_depth > 0)
+        caps.box_depth = config->max_box_depth;
+    if (config->max_box_children > 0)
+        caps.box_children = config->max_box_children;
+    if (config->id_stack_size > 0)
+        caps.id_stack = config->id_stack_size;
+    if (config->clip_stack_size > 0)
+        caps.clip_stack = config->clip_stack_size;
+    if (config->max_windows > 0)
+        caps.windows = config->max_windows;
+    if (config->max_blocking_regions > 0)
+        caps.regions = config->max_blocking_regions;
+    if (config->max_input_events > 0)
+        caps.events = config->max_input_events;
+    if (config->max_widget_states > 0)
+        caps.widget_states = config->max_widget_states;
+    if (config->max_focusable > 0)
+        caps.focusable = config->max_focusable;
+    if (config->max_tracked_fields > 0)
+        caps.textfields = caps.sliders = config->max_tracked_fields;
+    if (config->max_scroll_depth > 0)
+        caps.scroll_depth = config->max_scroll_depth;
+    caps.widget_map = optional_cap(config->max_widget_map, caps.widget_map);
+    caps.glyph_points =
+        optional_cap(config->glyph_cache_points, caps.glyph_points);
+    caps.paragraphs = optional_cap(config->max_paragraphs, caps.paragraphs);
+    return caps;
+}
+
+/* Lay out the arena after the context. Returns the total size; when @ctx is
+ * given, also points its stacks and tables into @base.
+ */
+static size_t context_arena(iui_context *ctx,
+                            uint8_t *base,
+                            iui_arena_caps caps)
+{
+    size_t depth = (size_t) caps.box_depth;
+    size_t children = (size_t) caps.box_children;
+
+    /* Window hash: power of two, at most half full */
+    size_t hash_slots = 2;
+    while (hash_slots < (size_t) caps.windows * 2)
+        hash_slots <<= 1;
+
+    /* Field tracking sets: power of two, may fill up */
+    size_t textfield_slots = 1, slider_slots = 1;
+    while (textfield_slots < (size_t) caps.textfields)
+        textfield_slots <<= 1;
+    while (slider_slots < (size_t) caps.sliders)
+        slider_slots <<= 1;
+
+    /* Glyph cache slots: power of two, one per IUI_GLYPH_CACHE_SLOT_POINTS */
+    size_t glyph_points = (size_t) caps.glyph_points, glyph_slots = 0;
+    if (glyph_points) {
+        glyph_slots = 8;
+        while (glyph_slots * IUI_GLYPH_CACHE_SLOT_POINTS < glyph_points)
+            glyph_slots <<= 1;
+    }
+
+    /* Widget state table: power of two, at most 3/4 full */
+    size_t state_slots = 2;
+    while (state_slots * 3 < (size_t) caps.widget_states * 4)
+        state_slots <<= 1;
+
+    size_t off = IUI_ARENA_ALIGN(sizeof(iui_context));
+    size_t box_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_box_entry_t) * depth);
+    size_t computed_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(float) * depth * children);
+    size_t clip_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_rect_t) * (size_t) caps.clip_stack);
+    size_t id_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint32_t) * (size_t) caps.id_stack);
+    size_t seq_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint32_t) * ((size_t) caps.id_stack + 1));
+    size_t window_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_window) * (size_t) caps.windows);
+    size_t hash_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint16_t) * hash_slots);
+    size_t regions = (size_t) caps.regions;
+    size_t region_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_block_region_t) * regions * 2);
+    size_t items_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint16_t) * regions * IUI_BLOCK_GRID_SPAN);
+    size_t large_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint16_t) * regions);
+    size_t events_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_input_event) * (size_t) caps.events);
+    size_t states_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_widget_state) * state_slots);
+    size_t map_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_widget_entry) *
+                           (size_t) caps.widget_map);
+    size_t textfields_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(void *) * textfield_slots);
+    size_t textfield_frames_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint32_t) * textfield_slots);
+    size_t sliders_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint32_t) * slider_slots);
+    size_t slider_frames_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint32_t) * slider_slots);
+    size_t focusable = (size_t) caps.focusable;
+    size_t focus_rects_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_rect_t) * focusable);
+    size_t focus_sorted_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint16_t) * focusable);
+    size_t focus_order_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(uint32_t) * focusable);
+    size_t focus_corners_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(float) * focusable);
+    size_t scroll_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_scroll_frame) *
+                           (size_t) caps.scroll_depth);
+    size_t glyph_entries_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_glyph_cache_entry) * glyph_slots);
+    size_t glyph_points_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_glyph_point) * glyph_points);
+    size_t paragraphs_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(iui_paragraph_entry) *
+                           (size_t) caps.paragraphs);
+    size_t frozen_off = off;
+    off += IUI_ARENA_ALIGN(sizeof(bool) * children);
+
+    if (ctx) {
+        ctx->box_stack = (iui_box_entry_t *) (base + box_off);
+        float *computed = (float *) (base + computed_off);
+        for (size_t i = 0; i < depth; i++)
+            ctx->box_stack[i].computed = computed + i * children;
+        ctx->box_frozen = (bool *) (base + frozen_off);
+        ctx->box_capacity = caps.box_depth;
+        ctx->box_children = caps.box_children;
+        ctx->clip.stack = (iui_rect_t *) (base + clip_off);
+        ctx->clip.capacity = caps.clip_stack;
+        ctx->id_stack = (uint32_t *) (base + id_off);
+        ctx->id_seq = (uint32_t *) (base + seq_off);
+        ctx->id_stack_capacity = caps.id_stack;
+        ctx->windows = (iui_window *) (base + window_off);
+        ctx->window_capacity = (uint32_t) caps.windows;
+        ctx->window_hash = (uint16_t *) (base + hash_off);
+        ctx->window_hash_mask = (uint32_t) hash_slots - 1;
+        memset(ctx->window_hash, 0, sizeof(uint16_t) * hash_slots);
+        ctx->window_bottom = ctx->window_top = -1;
+        iui_block_region_t *region = (iui_block_region_t *) (base + region_off);
+        ctx->input_layer.regions[0] = region;
+        ctx->input_layer.regions[1] = region + regions;
+        ctx->input_layer.region_capacity = caps.regions;
+        ctx->input_layer.index.items = (uint16_t *) (base + items_off);
+        ctx->input_layer.index.large = (uint16_t *) (base + large_off);
+        ctx->events.items = (iui_input_event *) (base + events_off);
+        ctx->events.capacity = caps.events;
+        ctx->widget_states.slots = (iui_widget_state *) (base + states_off);
+        ctx->widget_states.mask = (uint32_t) state_slots - 1;
+        ctx->widget_states.capacity = caps.widget_states;
+        memset(ctx->widget_states.slots, 0,
+               sizeof(iui_widget_state) * state_slots);
+        ctx->widget_map.entries = (iui_widget_entry *) (base + map_off);
+        ctx->widget_map.capacity = caps.widget_map;
+        ctx->focus_rects = (iui_rect_t *) (base + focus_rects_off);
+        ctx->focus_sorted = (uint16_t *) (base + focus_sorted_off);
+        ctx->focus_order = (uint32_t *) (base + focus_order_off);
+        ctx->focus_corners = (float *) (base + focus_corners_off);
+        ctx->focus_capacity = caps.focusable;
+        iui_field_tracking *ft = &ctx->field_tracking;
+        ft->textfield_ids = (void **) (base + textfields_off);
+        ft->textfield_frames = (uint32_t *) (base + textfield_frames_off);
+        ft->slider_ids = (uint32_t *) (base + sliders_off);
+        ft->slider_frames = (uint32_t *) (base + slider_frames_off);
+        ft->textfield_mask = (uint32_t) textfield_slots - 1;
+        ft->slider_mask = (uint32_t) slider_slots - 1;
+        memset(ft->textfield_frames, 0, sizeof(uint32_t) * textfield_slots);
+        memset(ft->slider_frames, 0, sizeof(uint32_t) * slider_slots);
+        ft->frame_number = 1; /* stamps of 0 are never live */
+        ctx->scroll_stack = (iui_scroll_frame *) (base + scroll_off);
+        ctx->scroll_capacity = caps.scroll_depth;
+        iui_glyph_cache_state *gc = &ctx->glyph_cache;
+        gc->entries = NULL;
+        if (glyph_slots)
+            gc->entries = (iui_glyph_cache_entry *) (base + glyph_entries_off);
+        gc->points = (iui_glyph_point *) (base + glyph_points_off);
+        gc->mask = glyph_slots ? (uint32_t) glyph_slots - 1 : 0;
+        gc->capacity = (int) glyph_points;
+        ctx->paragraph_cache.entries =
+            (iui_paragraph_entry *) (base + paragraphs_off);
+        ctx->paragraph_cache.capacity = caps.paragraphs;
+    }
+    return off;
+}
+
 size_t iui_min_memory_size(void)
 {
-    return sizeof(iui_context);
+    return iui_min_memory_size_for(NULL);
+}
+
+size_t iui_min_memory_size_for(const iui_config_t *config)
+{
+    return context_arena(NULL, NULL, arena_caps(config));
 }
 
 iui_config_t iui_make_config(void *buffer,
@@ -698,6 +1233,28 @@ bool iui_config_is_valid(const iui_config_t *config)
     if (config->font_height <= 0.f)
         return false;
 
+    /* Guard: capacities are counts (0 = default); windows and blocking
+     * regions are indexed with 16 bits. A negative count turns an optional
+     * table off.
+     */
+    if (config->max_box_depth < 0 || config->max_box_children < 0 ||
+        config->id_stack_size < 0 || config->clip_stack_size < 0 ||
+        config->max_windows < 0 || config->max_windows >= UINT16_MAX ||
+        config->max_blocking_regions < 0 ||
+        config->max_blocking_regions > UINT16_MAX / IUI_BLOCK_GRID_SPAN ||
+        config->max_input_events < 0 || config->max_widget_states < 0 ||
+        config->max_focusable < 0 || config->max_focusable > UINT16_MAX ||
+        config->max_tracked_fields < 0 ||
+        config->max_tracked_fields > INT32_MAX / 2 ||
+        config->max_scroll_depth < 0 ||
+        config->glyph_cache_points > UINT16_MAX)
+        return false;
+
+    /* Guard: a known buffer size must fit the requested capacities */
+    if (config->buffer_size &&
+        config->buffer_size < iui_min_memory_size_for(config))
+        return false;
+
     return true;
 }
 
@@ -705,7 +1262,8 @@ bool iui_config_is_valid(const iui_config_t *config)
  *
  * Subsystem Initialization Order:
  *   1. Core state: input, font metrics, padding, theme
- *   2. Clip stack: scissor region management
+ *   2. Stacks: box/ID/clip storage carved behind the context, then the
+ *      scissor region
  *   3. Modal system: overlay blocking and z-order
  *   4. Input layer: double-buffered blocking regions
  *   5. Focus system: keyboard navigation and trapping
@@ -741,7 +1299,10 @@ iui_context *iui_init(const iui_config_t *config)
     ctx->row_height = ctx->font_height * 1.5f;
     ctx->vector = config->vector;
 
-    /* Initialize clip stack */
+    /* Carve box, ID and clip stacks and the window table from the rest of the
+     * buffer
+     */
+    context_arena(ctx, (uint8_t *) config->buffer, arena_caps(config));
     ctx->clip.depth = 0;
     ctx->current_clip = (iui_clip_rect) {0, 0, UINT16_MAX, UINT16_MAX};
 
@@ -782,6 +1343,7 @@ iui_context *iui_init(const iui_config_t *config)
     ctx->scroll_viewport = (iui_rect_t) {0, 0, 0, 0};
     ctx->scroll_content_start_y = 0;
     ctx->scroll_content_start_x = 0;
+    ctx->scroll_depth = 0;
     ctx->scroll_wheel_dx = 0;
     ctx->scroll_wheel_dy = 0;
     ctx->scroll_dragging = NULL;
@@ -790,6 +1352,9 @@ iui_context *iui_init(const iui_config_t *config)
     /* Initialize typography scale */
     ctx->typography = iui_typography_scale_default;
 
+    /* Built-in font only until the application attaches glyph packs */
+    iui_glyph_pack_detach_all(ctx);
+
     /* Initialize shape tokens */
     ctx->shapes = iui_shape_tokens_default;
 
@@ -804,7 +1369,12 @@ iui_context *iui_init(const iui_config_t *config)
     /* Initialize performance systems (disabled by default) */
     iui_batch_init(ctx);
     iui_dirty_init(ctx);
+    iui_box_cache_init(ctx);
+    iui_measure_init(ctx);
     iui_text_cache_init(ctx);
+    iui_paragraph_cache_init(ctx);
+    iui_glyph_advance_init(ctx);
+    iui_glyph_cache_init(ctx);
     return ctx;
 }
 
@@ -834,9 +1404,10 @@ void iui_set_theme(iui_context *ctx, const iui_theme_t *theme)
 
 bool iui_push_id(iui_context *ctx, const void *data, size_t size)
 {
-    if (ctx->id_stack_index >= IUI_ID_STACK_SIZE)
+    if (ctx->id_stack_index >= ctx->id_stack_capacity)
         return false;
     ctx->id_stack[ctx->id_stack_index++] = iui_hash(data, size);
+    ctx->id_seq[ctx->id_stack_index] = 0; /* widget ordinals restart */
     return true;
 }
 
@@ -853,7 +1424,7 @@ bool iui_register_focusable(iui_context *ctx,
                             iui_rect_t bounds,
                             float corner)
 {
-    if (ctx->focus_count >= IUI_MAX_FOCUSABLE_WIDGETS)
+    if (ctx->focus_count >= ctx->focus_capacity)
         return false;
 
     /* Don't register if modal is blocking this widget */
@@ -909,6 +1480,7 @@ void iui_focus_next(iui_context *ctx)
 {
     ctx->focus_navigation_pending = true;
     ctx->focus_navigation_direction = 1;
+    ctx->focus_move_dir = -1;
 }
 
 /* Move focus to the previous focusable widget (Shift+Tab) */
@@ -916,6 +1488,17 @@ void iui_focus_prev(iui_context *ctx)
 {
     ctx->focus_navigation_pending = true;
     ctx->focus_navigation_direction = -1;
+    ctx->focus_move_dir = -1;
+}
+
+/* Move focus spatially (D-pad, arrow keys) */
+void iui_focus_move(iui_context *ctx, iui_focus_dir_t dir)
+{
+    if (dir < IUI_FOCUS_LEFT || dir > IUI_FOCUS_DOWN)
+        return;
+    ctx->focus_navigation_pending = true;
+    ctx->focus_navigation_direction = 1; /* entry point when nothing focused */
+    ctx->focus_move_dir = (int) dir;
 }
 
 /* Get the currently focused widget ID (0 if none) */
@@ -930,6 +1513,92 @@ bool iui_has_any_focus(const iui_context *ctx)
     return ctx->focused_widget_id != 0;
 }
 
+static inline float focus_center(const iui_rect_t *r, bool horizontal)
+{
+    return horizontal ? r->x + r->width * .5f : r->y + r->height * .5f;
+}
+
+/* Heap sort of focusable indices by center along one axis */
+static void focus_sift(const iui_rect_t *rects,
+                       bool horizontal,
+                       uint16_t *k,
+                       int root,
+                       int n)
+{
+    uint16_t v = k[root];
+    float vc = focus_center(&rects[v], horizontal);
+    for (int child; (child = 2 * root + 1) < n; root = child) {
+        if (child + 1 < n && focus_center(&rects[k[child + 1]], horizontal) >
+                                 focus_center(&rects[k[child]], horizontal))
+            child++;
+        if (focus_center(&rects[k[child]], horizontal) <= vc)
+            break;
+        k[root] = k[child];
+    }
+    k[root] = v;
+}
+
+static void focus_sort(const iui_rect_t *rects,
+                       bool horizontal,
+                       uint16_t *k,
+                       int n)
+{
+    for (int i = n / 2 - 1; i >= 0; i--)
+        focus_sift(rects, horizontal, k, i, n);
+    for (int i = n - 1; i > 0; i--) {
+        uint16_t t = k[0];
+        k[0] = k[i], k[i] = t;
+        focus_sift(rects, horizontal, k, 0, i);
+    }
+}
+
+/* Nearest focusable in @dir from @from within [lo, hi], or -1. Candidates
+ * are sorted by center along the axis of travel; a binary search finds the
+ * first one past @from, and the scan outward stops once the distance along
+ * the axis alone exceeds the best score, so aligned neighbours in a large
+ * grid are found after a handful of comparisons.
+ */
+static int focus_find(iui_context *ctx, int from, int dir, int lo, int hi)
+{
+    bool horizontal = dir == IUI_FOCUS_LEFT || dir == IUI_FOCUS_RIGHT;
+    bool forward = dir == IUI_FOCUS_RIGHT || dir == IUI_FOCUS_DOWN;
+    const iui_rect_t *rects = ctx->focus_rects;
+    uint16_t *keys = ctx->focus_sorted;
+    int n = 0;
+    for (int i = lo; i <= hi; i++)
+        keys[n++] = (uint16_t) i;
+    focus_sort(rects, horizontal, keys, n);
+
+    float origin = focus_center(&rects[from], horizontal);
+    float side = focus_center(&rects[from], !horizontal);
+
+    /* First key strictly past @origin in the direction of travel */
+    int a = 0, b = n;
+    while (a < b) {
+        int mid = a + (b - a) / 2;
+        float c = focus_center(&rects[keys[mid]], horizontal);
+        if (forward ? c <= origin : c < origin)
+            a = mid + 1;
+        else
+            b = mid;
+    }
+
+    int best = -1, step = forward ? 1 : -1;
+    float best_score = INFINITY;
+    for (int i = forward ? a : a - 1; i >= 0 && i < n; i += step) {
+        const iui_rect_t *r = &rects[keys[i]];
+        float major = fabsf(focus_center(r, horizontal) - origin);
+        if (major >= best_score)
+            break;
+        float score = major + 2.f * fabsf(focus_center(r, !horizontal) - side);
+        if (score < best_score || (score == best_score && keys[i] < best)) {
+            best_score = score;
+            best = keys[i];
+        }
+    }
+    return best;
+}
+
 /* Internal: Process pending focus navigation (called at end of frame).
  * Respects focus trap boundaries when active.
  */
@@ -954,6 +1623,11 @@ void iui_process_focus_navigation(iui_context *ctx)
     if (ctx->focus_index < min_index || ctx->focus_index > max_index) {
         ctx->focus_index =
             (ctx->focus_navigation_direction > 0) ? min_index : max_index;
+    } else if (ctx->focus_move_dir >= 0) {
+        int next = focus_find(ctx, ctx->focus_index, ctx->focus_move_dir,
+                              min_index, max_index);
+        if (next >= 0)
+            ctx->focus_index = next;
     } else {
         /* Move in direction with wrap-around within bounds */
         ctx->focus_index += ctx->focus_navigation_direction;
@@ -1463,6 +2137,92 @@ int iui_a11y_describe(const iui_a11y_hint *hint, char *buf, size_t buf_size)
 
 /* Input layer system */
 
+static inline int block_cell(float offset, float cell)
+{
+    float c = fmaxf(offset, 0.f) / cell;
+    return c < IUI_BLOCK_GRID_DIM ? (int) c : IUI_BLOCK_GRID_DIM - 1;
+}
+
+/* Cell range of @r in the index grid. Returns false when @r misses the grid
+ * entirely; otherwise the range is clamped to it.
+ */
+static bool block_cells(const iui_block_index_t *idx,
+                        const iui_rect_t *r,
+                        int *x0,
+                        int *y0,
+                        int *x1,
+                        int *y1)
+{
+    const float span_x = idx->cell_w * IUI_BLOCK_GRID_DIM;
+    const float span_y = idx->cell_h * IUI_BLOCK_GRID_DIM;
+    if (r->x + r->width < idx->x || r->x > idx->x + span_x ||
+        r->y + r->height < idx->y || r->y > idx->y + span_y)
+        return false;
+
+    *x0 = block_cell(r->x - idx->x, idx->cell_w);
+    *x1 = block_cell(r->x + r->width - idx->x, idx->cell_w);
+    *y0 = block_cell(r->y - idx->y, idx->cell_h);
+    *y1 = block_cell(r->y + r->height - idx->y, idx->cell_h);
+    return true;
+}
+
+/* Bucket the read buffer's regions into the grid (counting sort) */
+static void block_index_build(iui_layer_state_t *layer)
+{
+    iui_block_index_t *idx = &layer->index;
+    const int read_buf = 1 - layer->current_buffer;
+    const iui_block_region_t *regions = layer->regions[read_buf];
+    const int count = layer->region_count[read_buf];
+
+    memset(idx->cell_start, 0, sizeof(idx->cell_start));
+    idx->large_count = 0;
+    if (count == 0)
+        return;
+
+    /* Grid covers the union of all regions */
+    float min_x = regions[0].bounds.x, min_y = regions[0].bounds.y;
+    float max_x = min_x + regions[0].bounds.width;
+    float max_y = min_y + regions[0].bounds.height;
+    for (int i = 1; i < count; i++) {
+        const iui_rect_t *b = &regions[i].bounds;
+        min_x = fminf(min_x, b->x), min_y = fminf(min_y, b->y);
+        max_x = fmaxf(max_x, b->x + b->width);
+        max_y = fmaxf(max_y, b->y + b->height);
+    }
+    idx->x = min_x, idx->y = min_y;
+    idx->cell_w = fmaxf((max_x - min_x) / IUI_BLOCK_GRID_DIM, 1.f);
+    idx->cell_h = fmaxf((max_y - min_y) / IUI_BLOCK_GRID_DIM, 1.f);
+
+    /* Pass 1: count entries per cell (shifted by one for the prefix sum) */
+    int x0, y0, x1, y1;
+    for (int i = 0; i < count; i++) {
+        block_cells(idx, &regions[i].bounds, &x0, &y0, &x1, &y1);
+        if ((x1 - x0 + 1) * (y1 - y0 + 1) > IUI_BLOCK_GRID_SPAN) {
+            idx->large[idx->large_count++] = (uint16_t) i;
+            continue;
+        }
+        for (int cy = y0; cy <= y1; cy++)
+            for (int cx = x0; cx <= x1; cx++)
+                idx->cell_start[cy * IUI_BLOCK_GRID_DIM + cx + 1]++;
+    }
+    for (int c = 0; c < IUI_BLOCK_GRID_DIM * IUI_BLOCK_GRID_DIM; c++)
+        idx->cell_start[c + 1] += idx->cell_start[c];
+
+    /* Pass 2: scatter, advancing each cell's start; then shift back */
+    for (int i = 0; i < count; i++) {
+        block_cells(idx, &regions[i].bounds, &x0, &y0, &x1, &y1);
+        if ((x1 - x0 + 1) * (y1 - y0 + 1) > IUI_BLOCK_GRID_SPAN)
+            continue;
+        for (int cy = y0; cy <= y1; cy++)
+            for (int cx = x0; cx <= x1; cx++)
+                idx->items[idx->cell_start[cy * IUI_BLOCK_GRID_DIM + cx]++] =
+                    (uint16_t) i;
+    }
+    for (int c = IUI_BLOCK_GRID_DIM * IUI_BLOCK_GRID_DIM; c > 0; c--)
+        idx->cell_start[c] = idx->cell_start[c - 1];
+    idx->cell_start[0] = 0;
+}
+
 /* Internal: Swap double buffers at frame start */
 void iui_input_layer_frame_begin(iui_context *ctx)
 {
@@ -1471,6 +2231,8 @@ void iui_input_layer_frame_begin(iui_context *ctx)
     /* Clear the new write buffer for this frame's registrations */
     ctx->input_layer.region_count[ctx->input_layer.current_buffer] = 0;
     ctx->input_layer.next_reg_order = 0;
+    /* Read buffer is fixed for the whole frame: index it once */
+    block_index_build(&ctx->input_layer);
 }
 
 /* Internal: Check if two rects overlap. */
@@ -1525,7 +2287,7 @@ void iui_pop_layer(iui_context *ctx)
 bool iui_register_blocking_region(iui_context *ctx, iui_rect_t bounds)
 {
     int buf = ctx->input_layer.current_buffer;
-    if (ctx->input_layer.region_count[buf] >= IUI_MAX_BLOCKING_REGIONS)
+    if (ctx->input_layer.region_count[buf] >= ctx->input_layer.region_capacity)
         return false; /* Region limit reached */
 
     iui_block_region_t *reg =
@@ -1540,6 +2302,23 @@ bool iui_register_blocking_region(iui_context *ctx, iui_rect_t bounds)
     return true;
 }
 
+/* Keep the topmost blocking region overlapping @bounds in @top.
+ * Non-overlapping regions (e.g., dialog in corner) must not globally block
+ * unrelated widgets elsewhere on screen.
+ */
+static void block_consider(const iui_block_region_t *reg,
+                           const iui_rect_t *bounds,
+                           const iui_block_region_t **top)
+{
+    if (!reg->blocks_input || !iui_rect_ts_overlap(bounds, &reg->bounds))
+        return;
+    const iui_block_region_t *t = *top;
+    if (!t || reg->z_order > t->z_order ||
+        (reg->z_order == t->z_order &&
+         reg->registration_order > t->registration_order))
+        *top = reg;
+}
+
 bool iui_should_process_input(iui_context *ctx, iui_rect_t bounds)
 {
     /* Fast path - no overlays active (common case) */
@@ -1571,39 +2350,35 @@ bool iui_should_process_input(iui_context *ctx, iui_rect_t bounds)
     }
 
     /* Find highest z_order blocking region ONLY among overlapping regions.
-     * Critical: must scan all overlapping regions before deciding - early
+     * Critical: must scan all overlapping candidates before deciding - early
      * return would miss higher z-order overlays that should block input. Use
-     * z_order for priority (higher = on top), registration_order as tie-breaker
+     * z_order for priority (higher = on top), registration_order as
+     * tie-breaker. Candidates come from the grid cells under the widget plus
+     * the wide regions; a region listed in several cells is simply seen again.
      */
-    int highest_z_order = -1;
-    int highest_reg_order = -1;
-    int highest_layer_id = -1;
-
-    for (int i = 0; i < region_count; i++) {
-        const iui_block_region_t *reg = &ctx->input_layer.regions[read_buf][i];
-        if (!reg->blocks_input)
-            continue;
-
-        /* ONLY consider regions that actually overlap with the widget bounds.
-         * Non-overlapping regions (e.g., dialog in corner) should not globally
-         * block unrelated widgets elsewhere on screen.
-         */
-        if (!iui_rect_ts_overlap(&bounds, &reg->bounds))
-            continue;
-
-        /* Track highest blocking region among overlapping only */
-        if (reg->z_order > highest_z_order ||
-            (reg->z_order == highest_z_order &&
-             reg->registration_order > highest_reg_order)) {
-            highest_z_order = reg->z_order;
-            highest_reg_order = reg->registration_order;
-            highest_layer_id = reg->layer_id;
+    const iui_block_region_t *regions = ctx->input_layer.regions[read_buf];
+    const iui_block_index_t *idx = &ctx->input_layer.index;
+    const iui_block_region_t *top = NULL;
+
+    for (int i = 0; i < idx->large_count; i++)
+        block_consider(&regions[idx->large[i]], &bounds, &top);
+
+    int x0, y0, x1, y1;
+    if (block_cells(idx, &bounds, &x0, &y0, &x1, &y1)) {
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                int c = cy * IUI_BLOCK_GRID_DIM + cx;
+                for (int k = idx->cell_start[c]; k < idx->cell_start[c + 1];
+                     k++)
+                    block_consider(&regions[idx->items[k]], &bounds, &top);
+            }
         }
     }
 
     /* No overlapping blocking regions = allow input */
-    if (highest_layer_id < 0)
+    if (!top)
         return true;
+    int highest_layer_id = top->layer_id;
 
     /* Allow input only if current layer is the highest overlapping layer.
      * This ensures that lower layers cannot process input when a higher z-order
@@ -1635,13 +2410,18 @@ int iui_get_layer_depth(const iui_context *ctx)
 
 void iui_field_tracking_frame_begin(iui_context *ctx)
 {
-    memset(ctx->field_tracking.textfield_ids, 0,
-           sizeof(ctx->field_tracking.textfield_ids));
-    memset(ctx->field_tracking.slider_ids, 0,
-           sizeof(ctx->field_tracking.slider_ids));
-    ctx->field_tracking.textfield_count = 0;
-    ctx->field_tracking.slider_count = 0;
-    ctx->field_tracking.frame_number++;
+    /* Every stamp from earlier frames stops being live */
+    iui_field_tracking *ft = &ctx->field_tracking;
+    ft->textfield_count = 0;
+    ft->slider_count = 0;
+    ft->textfield_overflow = ft->slider_overflow = false;
+    if (++ft->frame_number == 0) {
+        /* Wrapped: old stamps could alias the new frame, so wipe them */
+        memset(ft->textfield_frames, 0,
+               sizeof(uint32_t) * (ft->textfield_mask + 1));
+        memset(ft->slider_frames, 0, sizeof(uint32_t) * (ft->slider_mask + 1));
+        ft->frame_number = 1;
+    }
 }
 
 /* Hash pointer to table index using multiplicative hash.
@@ -1655,29 +2435,49 @@ static inline uint32_t iui_ptr_hash_idx(const void *ptr, uint32_t mask)
     return h & mask;
 }
 
+/* Linear probe: the live slot holding @buffer, else the first slot not live
+ * this frame (where it belongs). -1 once every slot is live with other keys.
+ */
+static int textfield_slot(const iui_field_tracking *ft, const void *buffer)
+{
+    uint32_t idx = iui_ptr_hash_idx(buffer, ft->textfield_mask);
+    for (uint32_t probe = 0; probe <= ft->textfield_mask; probe++) {
+        if (ft->textfield_frames[idx] != ft->frame_number ||
+            ft->textfield_ids[idx] == buffer)
+            return (int) idx;
+        idx = (idx + 1) & ft->textfield_mask;
+    }
+    return -1;
+}
+
+static int slider_slot(const iui_field_tracking *ft, uint32_t slider_id)
+{
+    uint32_t idx = slider_id & ft->slider_mask;
+    for (uint32_t probe = 0; probe <= ft->slider_mask; probe++) {
+        if (ft->slider_frames[idx] != ft->frame_number ||
+            ft->slider_ids[idx] == slider_id)
+            return (int) idx;
+        idx = (idx + 1) & ft->slider_mask;
+    }
+    return -1;
+}
+
 void iui_register_textfield(iui_context *ctx, void *buffer)
 {
     if (!buffer)
         return;
 
-    /* Hash index with linear probing for collisions */
-    uint32_t idx = iui_ptr_hash_idx(buffer, IUI_MAX_TRACKED_TEXTFIELDS - 1);
-
-    /* Probe entire table until finding empty slot or duplicate */
-    for (int probe = 0; probe < IUI_MAX_TRACKED_TEXTFIELDS; probe++) {
-        void *cached = ctx->field_tracking.textfield_ids[idx];
-        if (!cached) {
-            /* Found empty slot, insert here */
-            ctx->field_tracking.textfield_ids[idx] = buffer;
-            ctx->field_tracking.textfield_count++;
-            return;
-        }
-        if (cached == buffer) /* Already registered, done */
-            return;
-
-        /* Collision, continue probing */
-        idx = (idx + 1) & (IUI_MAX_TRACKED_TEXTFIELDS - 1);
+    iui_field_tracking *ft = &ctx->field_tracking;
+    int idx = textfield_slot(ft, buffer);
+    if (idx < 0) {
+        ft->textfield_overflow = true;
+        return;
     }
+    if (ft->textfield_frames[idx] == ft->frame_number)
+        return; /* already registered */
+    ft->textfield_ids[idx] = buffer;
+    ft->textfield_frames[idx] = ft->frame_number;
+    ft->textfield_count++;
 }
 
 void iui_register_slider(iui_context *ctx, uint32_t slider_id)
@@ -1685,25 +2485,17 @@ void iui_register_slider(iui_context *ctx, uint32_t slider_id)
     if (slider_id == 0)
         return;
 
-    /* Direct hash index with linear probing for collisions */
-    uint32_t idx = slider_id & (IUI_MAX_TRACKED_SLIDERS - 1);
-
-    /* Probe entire table until finding empty slot or duplicate */
-    for (int probe = 0; probe < IUI_MAX_TRACKED_SLIDERS; probe++) {
-        uint32_t cached = ctx->field_tracking.slider_ids[idx];
-        if (!cached) {
-            /* Found empty slot, insert here */
-            ctx->field_tracking.slider_ids[idx] = slider_id;
-            ctx->field_tracking.slider_count++;
-            return;
-        }
-        if (cached == slider_id) {
-            /* Already registered, done */
-            return;
-        }
-        /* Collision, continue probing */
-        idx = (idx + 1) & (IUI_MAX_TRACKED_SLIDERS - 1);
+    iui_field_tracking *ft = &ctx->field_tracking;
+    int idx = slider_slot(ft, slider_id);
+    if (idx < 0) {
+        ft->slider_overflow = true;
+        return;
     }
+    if (ft->slider_frames[idx] == ft->frame_number)
+        return; /* already registered */
+    ft->slider_ids[idx] = slider_id;
+    ft->slider_frames[idx] = ft->frame_number;
+    ft->slider_count++;
 }
 
 bool iui_textfield_is_registered(const iui_context *ctx, const void *buffer)
@@ -1711,18 +2503,9 @@ bool iui_textfield_is_registered(const iui_context *ctx, const void *buffer)
     if (!buffer)
         return false;
 
-    uint32_t idx = iui_ptr_hash_idx(buffer, IUI_MAX_TRACKED_TEXTFIELDS - 1);
-
-    /* Probe entire table looking for match or empty slot */
-    for (int probe = 0; probe < IUI_MAX_TRACKED_TEXTFIELDS; probe++) {
-        void *cached = ctx->field_tracking.textfield_ids[idx];
-        if (cached == buffer)
-            return true;
-        if (!cached)
-            return false;
-        idx = (idx + 1) & (IUI_MAX_TRACKED_TEXTFIELDS - 1);
-    }
-    return false;
+    const iui_field_tracking *ft = &ctx->field_tracking;
+    int idx = textfield_slot(ft, buffer);
+    return idx >= 0 && ft->textfield_frames[idx] == ft->frame_number;
 }
 
 bool iui_slider_is_registered(const iui_context *ctx, uint32_t slider_id)
@@ -1730,33 +2513,33 @@ bool iui_slider_is_registered(const iui_context *ctx, uint32_t slider_id)
     if (slider_id == 0)
         return false;
 
-    uint32_t idx = slider_id & (IUI_MAX_TRACKED_SLIDERS - 1);
-
-    /* Probe entire table looking for match or empty slot */
-    for (int probe = 0; probe < IUI_MAX_TRACKED_SLIDERS; probe++) {
-        uint32_t cached = ctx->field_tracking.slider_ids[idx];
-        if (cached == slider_id)
-            return true;
-        if (!cached)
-            return false;
-        idx = (idx + 1) & (IUI_MAX_TRACKED_SLIDERS - 1);
-    }
-    return false;
+    const iui_field_tracking *ft = &ctx->field_tracking;
+    int idx = slider_slot(ft, slider_id);
+    return idx >= 0 && ft->slider_frames[idx] == ft->frame_number;
 }
 
 void iui_field_tracking_frame_end(iui_context *ctx)
 {
-    /* Clear focused_edit if the text field was not rendered this frame */
-    if (ctx->focused_edit &&
+    const iui_field_tracking *ft = &ctx->field_tracking;
+
+    /* Clear focused_edit if the text field was not rendered this frame. A
+     * full set may have dropped it, so an overflowed frame keeps focus.
+     */
+    if (ctx->focused_edit && !ft->textfield_overflow &&
         !iui_textfield_is_registered(ctx, ctx->focused_edit))
         ctx->focused_edit = NULL;
 
+    /* The prefix-width index only follows the focused field */
+    if (ctx->field_tracking.text_index.owner != ctx->focused_edit)
+        ctx->field_tracking.text_index.owner = NULL;
+
     /* Clear slider state if the active slider was not rendered this frame.
      * Use IUI_SLIDER_ID_MASK to extract the 31-bit slider ID (ignoring
      * the animation flag in bit 31) for comparison against tracked sliders.
      */
     uint32_t active_slider = ctx->slider.active_id & IUI_SLIDER_ID_MASK;
-    if (active_slider != 0 && !iui_slider_is_registered(ctx, active_slider)) {
+    if (active_slider != 0 && !ft->slider_overflow &&
+        !iui_slider_is_registered(ctx, active_slider)) {
         ctx->slider.active_id = 0;
         ctx->slider.drag_offset = 0.f;
         ctx->slider.anim_t = 0.f;
@@ -1913,15 +2696,10 @@ void iui_commit_composition(iui_context *ctx, const char *text)
 
     /* Insert the committed text as if it were typed */
     if (text) {
+        /* Queue every codepoint; the focused field replays them in order */
         size_t len = strlen(text);
-        for (size_t i = 0; i < len; i++) {
-            /* Queue each character for input processing */
-            ctx->char_input = (unsigned char) text[i];
-            /* Note: The text field will process this in the next frame.
-             * For immediate processing, the platform layer should handle
-             * multi-character insertion directly.
-             */
-        }
+        for (size_t i = 0; i < len; i = iui_utf8_next(text, i, len))
+            iui_update_char(ctx, (int) iui_utf8_decode(text, i, len));
     }
 
     /* Clear composition state */
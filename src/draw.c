@@ -138,7 +138,7 @@ float iui_get_text_width(iui_context *ctx, const char *text)
     if (ctx->renderer.text_width)
         width = ctx->renderer.text_width(text, ctx->renderer.user);
     else
-        width = iui_text_width_vec(text, ctx->font_height);
+        width = iui_text_width_adv(ctx, text);
 
     /* Store in cache */
     text_cache_put(ctx, text, width);
@@ -178,7 +178,10 @@ float iui_get_codepoint_width(iui_context *ctx, uint32_t cp)
         }
         return ctx->renderer.text_width(tmp, ctx->renderer.user);
     }
-    return iui_codepoint_width_vec(cp, ctx->font_height);
+    if (cp > 0x7E && ctx->glyph_pack_count > 0)
+        return iui_glyph_advance_of(ctx, iui_glyph_lookup(ctx, cp, NULL));
+    return iui_glyph_advances(ctx)[iui_glyph_advance_index(
+        (unsigned char) (cp > 0x7F ? 0 : cp))];
 }
 
 void iui_internal_draw_text(iui_context *ctx,
@@ -238,6 +241,251 @@ void iui_text(iui_context *ctx,
                     ctx->colors.on_surface, alignment);
 }
 
+/* Paragraph layout with memoized line breaks */
+
+void iui_paragraph_cache_init(iui_context *ctx)
+{
+    if (!ctx)
+        return;
+    iui_paragraph_cache_state *pc = &ctx->paragraph_cache;
+    memset(pc->entries, 0, sizeof(iui_paragraph_entry) * (size_t) pc->capacity);
+    pc->clock = 0;
+    pc->hits = pc->misses = 0;
+}
+
+/* Width of text[start, end) measured one codepoint at a time */
+static float paragraph_span_width(iui_context *ctx,
+                                  const char *text,
+                                  size_t start,
+                                  size_t end)
+{
+    float w = 0.f;
+    for (size_t i = start; i < end; i = iui_utf8_next(text, i, end))
+        w += iui_get_codepoint_width(ctx, iui_utf8_decode(text, i, end));
+    return w;
+}
+
+/* Greedy word wrap: find the line starting at @pos, store its byte range
+ * and width, and return where the next line starts.
+ */
+static size_t paragraph_line(iui_context *ctx,
+                             const char *text,
+                             size_t len,
+                             float width,
+                             size_t pos,
+                             size_t *line_end,
+                             float *line_width)
+{
+    size_t start = pos, end = len, next = len, space = 0, i = pos;
+    float w = 0.f, w_space = 0.f;
+    bool has_space = false;
+
+    while (i < len) {
+        if (text[i] == '\n') {
+            end = i, next = i + 1;
+            break;
+        }
+        uint32_t cp = iui_utf8_decode(text, i, len);
+        float cw = iui_get_codepoint_width(ctx, cp);
+        if (w + cw > width && i > start) {
+            /* Prefer the last space; split the word only if it is alone */
+            if (has_space)
+                end = space, next = space + 1, w = w_space;
+            else
+                end = next = i;
+            break;
+        }
+        if (cp == ' ')
+            space = i, w_space = w, has_space = true;
+        w += cw;
+        i = iui_utf8_next(text, i, len);
+    }
+    *line_end = end;
+    *line_width = w;
+
+    /* Wrapped lines do not start with the spaces that caused the wrap */
+    pos = next;
+    if (next > 0 && text[next - 1] != '\n') {
+        while (pos < len && text[pos] == ' ')
+            pos++;
+    }
+    return pos;
+}
+
+/* Cut off: shorten text[start, *end) until "..." fits after it */
+static void paragraph_elide(iui_context *ctx,
+                            const char *text,
+                            float width,
+                            size_t start,
+                            size_t *end,
+                            float *line_width)
+{
+    const float dots = iui_get_text_width(ctx, "...");
+    size_t line_end = *end, cut = start;
+    float w = 0.f;
+    while (cut < line_end) {
+        float cw =
+            iui_get_codepoint_width(ctx, iui_utf8_decode(text, cut, line_end));
+        if (w + cw + dots > width)
+            break;
+        w += cw;
+        cut = iui_utf8_next(text, cut, line_end);
+    }
+    while (cut > start && text[cut - 1] == ' ')
+        cut--;
+    *end = cut;
+    *line_width = paragraph_span_width(ctx, text, start, cut) + dots;
+}
+
+/* Break text into e->line_* (e->width, max_lines and ellipsis must already
+ * be set). Past IUI_PARAGRAPH_MAX_LINES, e->rest marks where uncached lines
+ * continue.
+ */
+static void paragraph_break(iui_context *ctx,
+                            iui_paragraph_entry *e,
+                            const char *text,
+                            size_t len)
+{
+    bool limited = e->max_lines > 0 && e->max_lines <= IUI_PARAGRAPH_MAX_LINES;
+    int cap = limited ? e->max_lines : IUI_PARAGRAPH_MAX_LINES;
+
+    size_t pos = 0;
+    int n = 0;
+    while (pos < len && n < cap) {
+        size_t start = pos, end;
+        float w;
+        pos = paragraph_line(ctx, text, len, e->width, pos, &end, &w);
+        e->line_start[n] = (uint16_t) start;
+        e->line_len[n] = (uint16_t) (end - start);
+        e->line_width[n] = w;
+        n++;
+    }
+    e->line_count = (uint16_t) n;
+    e->elided = false;
+    e->rest = 0;
+
+    if (pos < len && n > 0 && !limited) {
+        e->rest = (uint16_t) pos;
+    } else if (pos < len && n > 0 && e->ellipsis) {
+        size_t start = e->line_start[n - 1];
+        size_t end = start + e->line_len[n - 1];
+        paragraph_elide(ctx, text, e->width, start, &end,
+                        &e->line_width[n - 1]);
+        e->line_len[n - 1] = (uint16_t) (end - start);
+        e->elided = true;
+    }
+}
+
+/* Find the cached breaks for text, re-breaking into the least recently used
+ * slot on a miss. Without a cache, the breaks go to @scratch.
+ */
+static const iui_paragraph_entry *paragraph_layout(iui_context *ctx,
+                                                   iui_paragraph_entry *scratch,
+                                                   const char *text,
+                                                   size_t len,
+                                                   float width,
+                                                   int max_lines,
+                                                   bool ellipsis)
+{
+    iui_paragraph_cache_state *pc = &ctx->paragraph_cache;
+    uint32_t hash = iui_hash(text, len);
+    if (hash == 0)
+        hash = 1;
+
+    iui_paragraph_entry *lru = pc->capacity ? &pc->entries[0] : scratch;
+    for (int i = 0; i < pc->capacity; i++) {
+        iui_paragraph_entry *e = &pc->entries[i];
+        if (e->hash == hash && e->len == len && e->width == width &&
+            e->font_height == ctx->font_height && e->max_lines == max_lines &&
+            e->ellipsis == ellipsis) {
+            e->stamp = ++pc->clock;
+            pc->hits++;
+            return e;
+        }
+        if (e->stamp < lru->stamp)
+            lru = e;
+    }
+
+    pc->misses++;
+    lru->hash = hash, lru->len = (uint32_t) len;
+    lru->width = width, lru->font_height = ctx->font_height;
+    lru->max_lines = (int16_t) max_lines, lru->ellipsis = ellipsis;
+    lru->stamp = ++pc->clock;
+    paragraph_break(ctx, lru, text, len);
+    return lru;
+}
+
+/* Draw text[start, start + n) on the current row, plus "..." if @elided */
+static void paragraph_draw_line(iui_context *ctx,
+                                const char *text,
+                                size_t start,
+                                size_t n,
+                                float line_width,
+                                bool elided,
+                                iui_text_alignment_t align)
+{
+    size_t tail = elided ? 3 : 0;
+    if (n + tail >= IUI_STRING_BUFFER_SIZE)
+        n = IUI_STRING_BUFFER_SIZE - 1 - tail;
+    memcpy(ctx->string_buffer, text + start, n);
+    n = iui_utf8_trim_partial(ctx->string_buffer, n);
+    memcpy(ctx->string_buffer + n, "...", tail);
+    ctx->string_buffer[n + tail] = '\0';
+
+    float x = ctx->layout.x;
+    if (align == IUI_ALIGN_RIGHT)
+        x += ctx->layout.width - line_width;
+    else if (align == IUI_ALIGN_CENTER)
+        x += (ctx->layout.width - line_width) * .5f;
+    iui_internal_draw_text(ctx, x, ctx->layout.y, ctx->string_buffer,
+                           ctx->colors.on_surface);
+    ctx->layout.y += ctx->row_height;
+}
+
+int iui_text_paragraph(iui_context *ctx,
+                       const char *text,
+                       const iui_paragraph_options *options)
+{
+    if (!ctx->current_window || !text)
+        return 0;
+
+    iui_text_alignment_t align = options ? options->alignment : IUI_ALIGN_LEFT;
+    int max_lines = options ? options->max_lines : 0;
+    bool ellipsis = options && options->ellipsis;
+    if (max_lines < 0 || max_lines > INT16_MAX)
+        max_lines = 0;
+
+    /* Line offsets are 16-bit; longer text is laid out up to that point */
+    size_t len = strlen(text);
+    if (len > UINT16_MAX)
+        len = UINT16_MAX;
+
+    const float width = ctx->layout.width;
+    iui_paragraph_entry scratch;
+    const iui_paragraph_entry *e = paragraph_layout(ctx, &scratch, text, len,
+                                                    width, max_lines, ellipsis);
+
+    int n = e->line_count;
+    for (int i = 0; i < n; i++)
+        paragraph_draw_line(ctx, text, e->line_start[i], e->line_len[i],
+                            e->line_width[i], e->elided && i == n - 1, align);
+
+    /* Lines past the cached ones are broken as they are drawn */
+    for (size_t pos = e->rest; pos && pos < len;) {
+        if (max_lines > 0 && n >= max_lines)
+            break;
+        size_t start = pos, end;
+        float w;
+        pos = paragraph_line(ctx, text, len, width, pos, &end, &w);
+        bool elided = pos < len && ellipsis && n + 1 == max_lines;
+        if (elided)
+            paragraph_elide(ctx, text, width, start, &end, &w);
+        paragraph_draw_line(ctx, text, start, end - start, w, elided, align);
+        n++;
+    }
+    return n;
+}
+
 /* Helper function to draw text with specific font size */
 static void iui_text_with_size(iui_context *ctx,
                                iui_text_alignment_t alignment,
@@ -558,10 +806,189 @@ bool iui_draw_arc(iui_context *ctx,
 }
 
 /* Component state helper implementations */
+/* Interactive widget map */
+
+uint32_t iui_last_component_id(const iui_context *ctx)
+{
+    return ctx->widget_map.last_id;
+}
+
+/* Resolve last frame's map against the current pointer, then start a new
+ * map. A reverse scan finds the topmost hit: highest layer z_order first,
+ * later registration (drawn on top) breaking ties.
+ */
+void iui_widget_map_frame_begin(iui_context *ctx)
+{
+    iui_widget_map *map = &ctx->widget_map;
+    const iui_widget_entry *hot = NULL;
+
+    /* An overflowing map misses widgets that may be on top: no hot widget */
+    for (int i = map->count - 1; i >= 0 && !map->overflow; i--) {
+        const iui_widget_entry *e = &map->entries[i];
+        if (in_rect(&e->bounds, ctx->mouse_pos) &&
+            (!hot || e->z_order > hot->z_order))
+            hot = e;
+    }
+    map->hot_id = hot ? hot->id : 0;
+    map->count = 0;
+    map->overflow = false;
+    ctx->id_seq[0] = 0;
+}
+
+/* Next ID in the current window and ID stack scope: the scope hash combined
+ * with the caller's ordinal in that scope
+ */
+uint32_t iui_next_scope_id(iui_context *ctx)
+{
+    uint32_t key[2] = {ctx->current_window ? ctx->current_window->id : 0,
+                       ctx->id_seq[ctx->id_stack_index]++};
+    for (int i = 0; i < ctx->id_stack_index; i++)
+        key[0] = (key[0] ^ ctx->id_stack[i]) * 16777619u;
+    uint32_t id = iui_hash(key, sizeof(key));
+    return id ? id : 1; /* 0 means no widget */
+}
+
+/* Record the visible part of @bounds; returns false if fully clipped */
+static bool widget_map_add(iui_context *ctx, uint32_t id, iui_rect_t *bounds)
+{
+    if (ctx->clip.depth > 0) {
+        iui_rect_t clip = ctx->clip.stack[ctx->clip.depth - 1];
+        float right = fminf(bounds->x + bounds->width, clip.x + clip.width);
+        float bottom = fminf(bounds->y + bounds->height, clip.y + clip.height);
+        bounds->x = fmaxf(bounds->x, clip.x);
+        bounds->y = fmaxf(bounds->y, clip.y);
+        bounds->width = right - bounds->x;
+        bounds->height = bottom - bounds->y;
+    }
+    if (bounds->width <= 0.f || bounds->height <= 0.f)
+        return false;
+
+    iui_widget_map *map = &ctx->widget_map;
+    if (map->count >= map->capacity) {
+        map->overflow = true;
+        return true;
+    }
+    map->entries[map->count++] = (iui_widget_entry) {
+        .id = id,
+        .z_order = ctx->input_layer.current_z_order,
+        .bounds = *bounds,
+    };
+    return true;
+}
+
+bool iui_is_hot(const iui_context *ctx, uint32_t id)
+{
+    return id != 0 && ctx->widget_map.hot_id == id;
+}
+
+/* Per-widget state table */
+
+/* Empty slot @i, pulling later members of its probe chain back so lookups
+ * still stop at the first empty slot.
+ */
+static void widget_state_delete(iui_widget_state_table *t, uint32_t i)
+{
+    for (uint32_t j = i;;) {
+        j = (j + 1) & t->mask;
+        if (t->slots[j].id == 0)
+            break;
+        /* Entries whose home lies cyclically in (i, j] stay put */
+        uint32_t home = t->slots[j].id & t->mask;
+        if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+            continue;
+        t->slots[i] = t->slots[j];
+        i = j;
+    }
+    t->slots[i].id = 0;
+}
+
+/* Evict the least recently touched record, preferring one whose
+ * transitions have settled, to make room in a full table
+ */
+static void widget_state_evict(iui_widget_state_table *t)
+{
+    uint32_t victim = 0;
+    int best = -1;
+    for (uint32_t i = 0; i <= t->mask; i++) {
+        const iui_widget_state *ws = &t->slots[i];
+        if (ws->id == 0)
+            continue;
+        int score = (ws->frame != t->frame) * 2 +
+                    (ws->anim_t >= 1.f && ws->hover_t <= 0.f);
+        if (score > best)
+            victim = i, best = score;
+    }
+    if (best < 0)
+        return;
+    if (t->slots[victim].frame == t->frame)
+        t->touched--;
+    widget_state_delete(t, victim);
+    t->count--;
+}
+
+iui_widget_state *iui_widget_state_touch(iui_context *ctx,
+                                         uint32_t id,
+                                         iui_rect_t bounds)
+{
+    iui_widget_state_table *t = &ctx->widget_states;
+    if (id == 0 || !t->slots)
+        return NULL;
+
+    uint32_t i = id & t->mask;
+    while (t->slots[i].id != 0 && t->slots[i].id != id)
+        i = (i + 1) & t->mask;
+
+    iui_widget_state *ws = &t->slots[i];
+    if (ws->id == 0) {
+        if (t->count >= t->capacity) {
+            widget_state_evict(t);
+            for (i = id & t->mask; t->slots[i].id != 0;)
+                i = (i + 1) & t->mask;
+            ws = &t->slots[i];
+        }
+        *ws = (iui_widget_state) {.id = id, .frame = t->frame, .anim_t = 1.f};
+        t->count++, t->touched++;
+    } else if (ws->frame != t->frame) {
+        /* First touch this frame: advance the press transition */
+        ws->anim_t =
+            fminf(1.f, ws->anim_t + ctx->delta_time / IUI_DURATION_SHORT_4);
+        ws->frame = t->frame;
+        t->touched++;
+    }
+    ws->bounds = bounds;
+    return ws;
+}
+
+/* Evict records not touched this frame and start the next generation */
+void iui_widget_state_frame_end(iui_context *ctx)
+{
+    iui_widget_state_table *t = &ctx->widget_states;
+    if (t->touched < t->count) {
+        for (uint32_t i = 0; i <= t->mask;) {
+            iui_widget_state *ws = &t->slots[i];
+            if (ws->id != 0 && ws->frame != t->frame) {
+                widget_state_delete(t, i);
+                t->count--;
+                continue; /* slot @i may hold a shifted record now */
+            }
+            i++;
+        }
+    }
+    t->touched = 0;
+    t->frame++;
+}
+
 iui_state_t iui_get_component_state(iui_context *ctx,
                                     iui_rect_t bounds,
                                     bool disabled)
 {
+    /* Disabled widgets still occlude whatever is drawn below them. The ID
+     * is taken even when clipped so later widgets keep theirs.
+     */
+    uint32_t id = iui_next_scope_id(ctx);
+    ctx->widget_map.last_id = id;
+    bool visible = widget_map_add(ctx, id, &bounds);
+
     if (disabled)
         return IUI_STATE_DISABLED;
 
@@ -574,7 +1001,9 @@ iui_state_t iui_get_component_state(iui_context *ctx,
     if (ctx->modal.active && !ctx->modal.rendering)
         return IUI_STATE_DEFAULT; /* No hover, no press - input blocked */
 
-    bool hovered = in_rect(&bounds, ctx->mouse_pos);
+    uint32_t hot = ctx->widget_map.hot_id;
+    bool hovered =
+        hot ? id == hot : visible && in_rect(&bounds, ctx->mouse_pos);
 
     if (hovered) {
         if (ctx->modal.rendering && (ctx->mouse_pressed & IUI_MOUSE_LEFT))
@@ -800,7 +1229,7 @@ void iui_draw_elevated_box(iui_context *ctx,
 /* Clip stack functions */
 bool iui_push_clip(iui_context *ctx, iui_rect_t rect)
 {
-    if (ctx->clip.depth >= IUI_CLIP_STACK_SIZE)
+    if (ctx->clip.depth >= ctx->clip.capacity)
         return false; /* Stack overflow - return error */
 
     /* Intersect with current clip if any */
@@ -2,12 +2,41 @@
 
 #include "internal.h"
 
+/* Queue a slot for an event of @type stamped with the latest timestamp and
+ * the current modifiers. Pointer motion coalesces with a directly preceding
+ * motion event. Returns NULL when the queue is full.
+ */
+static iui_input_event *event_enqueue(iui_context *ctx, uint8_t type)
+{
+    iui_event_queue *q = &ctx->events;
+    iui_input_event *e;
+    if (type == IUI_EVENT_MOTION && q->count > 0 &&
+        q->items[q->count - 1].type == IUI_EVENT_MOTION) {
+        e = &q->items[q->count - 1];
+    } else {
+        if (q->count >= q->capacity)
+            return NULL;
+        e = &q->items[q->count++];
+        if (type == IUI_EVENT_KEY || type == IUI_EVENT_CHAR)
+            q->text_count++;
+    }
+    *e = (iui_input_event) {
+        .type = type,
+        .modifiers = ctx->modifiers,
+        .time_ms = q->time_ms,
+    };
+    return e;
+}
+
 /* Mouse position update */
 void iui_update_mouse_pos(iui_context *ctx, float x, float y)
 {
     if (!ctx)
         return;
     ctx->mouse_pos = (iui_vec2) {x, y};
+    iui_input_event *e = event_enqueue(ctx, IUI_EVENT_MOTION);
+    if (e)
+        e->x = x, e->y = y;
 }
 
 /* Multi-button mouse update */
@@ -23,6 +52,11 @@ void iui_update_mouse_buttons(
     /* Update held buttons: add newly pressed, remove newly released */
     ctx->mouse_held |= pressed;
     ctx->mouse_held &= ~released;
+    if (pressed | released) {
+        iui_input_event *e = event_enqueue(ctx, IUI_EVENT_BUTTON);
+        if (e)
+            e->pressed = pressed, e->released = released;
+    }
 
     /* Auto-release input capture when left mouse button is released */
     if ((released & IUI_MOUSE_LEFT) && ctx->input_capture.active)
@@ -35,6 +69,9 @@ void iui_update_key(iui_context *ctx, int key)
     if (!ctx)
         return;
     ctx->key_pressed = key;
+    iui_input_event *e = key ? event_enqueue(ctx, IUI_EVENT_KEY) : NULL;
+    if (e)
+        e->code = key;
 }
 
 /* Text character input */
@@ -43,6 +80,9 @@ void iui_update_char(iui_context *ctx, int codepoint)
     if (!ctx)
         return;
     ctx->char_input = codepoint;
+    iui_input_event *e = codepoint ? event_enqueue(ctx, IUI_EVENT_CHAR) : NULL;
+    if (e)
+        e->code = codepoint;
 }
 
 /* Modifier keys update (Ctrl/Shift/Alt) */
@@ -63,6 +103,116 @@ void iui_update_scroll(iui_context *ctx, float dx, float dy)
      */
     ctx->scroll_wheel_dx += dx;
     ctx->scroll_wheel_dy += dy;
+    iui_input_event *e =
+        (dx != 0.f || dy != 0.f) ? event_enqueue(ctx, IUI_EVENT_SCROLL) : NULL;
+    if (e)
+        e->x = dx, e->y = dy;
+}
+
+bool iui_push_event(iui_context *ctx, const iui_input_event *event)
+{
+    if (!ctx || !event)
+        return false;
+
+    iui_event_queue *q = &ctx->events;
+    int count = q->count;
+    bool coalesce = event->type == IUI_EVENT_MOTION && count > 0 &&
+                    q->items[count - 1].type == IUI_EVENT_MOTION;
+    q->time_ms = event->time_ms;
+    ctx->modifiers = event->modifiers;
+
+    switch (event->type) {
+    case IUI_EVENT_KEY:
+        iui_update_key(ctx, event->code);
+        break;
+    case IUI_EVENT_CHAR:
+        iui_update_char(ctx, event->code);
+        break;
+    case IUI_EVENT_BUTTON:
+        /* Edges accumulate over the frame, unlike iui_update_mouse_buttons */
+        iui_update_mouse_buttons(ctx, ctx->mouse_pressed | event->pressed,
+                                 ctx->mouse_released | event->released);
+        ctx->mouse_held |= event->pressed;
+        ctx->mouse_held &= ~event->released;
+        if (q->count > count) {
+            iui_input_event *e = &q->items[q->count - 1];
+            e->pressed = event->pressed, e->released = event->released;
+        }
+        break;
+    case IUI_EVENT_MOTION:
+        iui_update_mouse_pos(ctx, event->x, event->y);
+        break;
+    case IUI_EVENT_SCROLL:
+        iui_update_scroll(ctx, event->x, event->y);
+        break;
+    default:
+        return false;
+    }
+    return coalesce || q->count > count;
+}
+
+int iui_event_count(const iui_context *ctx)
+{
+    return ctx ? ctx->events.count : 0;
+}
+
+const iui_input_event *iui_event_get(const iui_context *ctx, int index)
+{
+    if (!ctx || index < 0 || index >= ctx->events.count)
+        return NULL;
+    return &ctx->events.items[index];
+}
+
+/* Put back the modifiers that were live before the replay */
+static void text_replay_end(iui_context *ctx)
+{
+    iui_event_queue *q = &ctx->events;
+    if (q->replaying) {
+        ctx->modifiers = q->live_modifiers;
+        q->replaying = false;
+    }
+}
+
+bool iui_text_event_next(iui_context *ctx, int *it)
+{
+    iui_event_queue *q = &ctx->events;
+
+    /* Nothing queued, or the frame's input was already claimed by another
+     * widget clearing the one-slot fields: a single pass over those fields.
+     */
+    if (*it == 0 && (q->text_count == 0 ||
+                     (ctx->key_pressed == IUI_KEY_NONE && !ctx->char_input)))
+        *it = -1;
+    if (*it < 0)
+        return (*it)-- == -1;
+
+    if (*it == 0 && !q->replaying) {
+        q->replaying = true;
+        q->live_modifiers = ctx->modifiers;
+    }
+    while (*it < q->count) {
+        const iui_input_event *e = &q->items[(*it)++];
+        if (e->type == IUI_EVENT_KEY) {
+            ctx->key_pressed = e->code, ctx->char_input = 0;
+            ctx->modifiers = e->modifiers;
+            return true;
+        }
+        if (e->type == IUI_EVENT_CHAR) {
+            ctx->key_pressed = IUI_KEY_NONE, ctx->char_input = e->code;
+            ctx->modifiers = e->modifiers;
+            return true;
+        }
+    }
+    text_replay_end(ctx);
+    return false;
+}
+
+void iui_text_events_consume(iui_context *ctx)
+{
+    ctx->key_pressed = IUI_KEY_NONE;
+    ctx->char_input = 0;
+    ctx->events.text_count = 0;
+    text_replay_end(ctx);
 }
 
 /* Frame start: clear per-frame input state
@@ -76,5 +226,8 @@ void iui_input_frame_begin(iui_context *ctx)
     ctx->mouse_released = 0;
     ctx->key_pressed = IUI_KEY_NONE;
     ctx->char_input = 0;
+    ctx->events.count = 0;
+    ctx->events.text_count = 0;
+    text_replay_end(ctx); /* a replay loop left early */
     /* Note: scroll_wheel_dx/dy cleared after scroll regions process them */
 }
@@ -35,3 +35,138 @@ const signed char *iui_get_glyph(unsigned char c)
         c = 0;
     return iui_glyph_table + iui_glyph_offsets[c];
 }
+
+/* Extended glyph packs */
+
+#define IUI_GLYPH_PACK_HEADER 16 /* magic, version, reserved, count, size */
+#define IUI_GLYPH_PACK_ENTRY 8   /* codepoint, offset */
+
+static inline uint32_t pack_u32(const uint8_t *p)
+{
+    return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 |
+           (uint32_t) p[3] << 24;
+}
+
+bool iui_glyph_pack_attach(iui_context *ctx, const void *data, size_t size)
+{
+    if (!ctx || !data || ctx->glyph_pack_count >= IUI_GLYPH_PACK_SLOTS)
+        return false;
+
+    const uint8_t *p = (const uint8_t *) data;
+    if (size < IUI_GLYPH_PACK_HEADER || memcmp(p, "IUGP", 4) != 0 ||
+        (p[4] | p[5] << 8) != 1)
+        return false;
+
+    /* Only the header is checked; the index is trusted to be sorted */
+    uint32_t count = pack_u32(p + 8), data_size = pack_u32(p + 12);
+    size_t index_size = (size_t) count * IUI_GLYPH_PACK_ENTRY;
+    if (count > (size - IUI_GLYPH_PACK_HEADER) / IUI_GLYPH_PACK_ENTRY ||
+        data_size > size - IUI_GLYPH_PACK_HEADER - index_size)
+        return false;
+
+    iui_glyph_pack *pack = &ctx->glyph_packs[ctx->glyph_pack_count++];
+    pack->index = p + IUI_GLYPH_PACK_HEADER;
+    pack->glyphs =
+        (const signed char *) (p + IUI_GLYPH_PACK_HEADER + index_size);
+    pack->count = count, pack->data_size = data_size;
+    iui_glyph_cache_init(ctx); /* cached outlines are keyed by codepoint */
+    ctx->field_tracking.text_index.owner = NULL; /* advances may change */
+    return true;
+}
+
+void iui_glyph_pack_detach_all(iui_context *ctx)
+{
+    if (!ctx)
+        return;
+    memset(ctx->glyph_packs, 0, sizeof(ctx->glyph_packs));
+    ctx->glyph_pack_count = 0;
+    iui_glyph_cache_init(ctx);
+    ctx->field_tracking.text_index.owner = NULL;
+}
+
+/* Binary search of one pack's sorted codepoint index; *end is set to the
+ * end of the pack data, the limit for reading the glyph's bytecode
+ */
+static const signed char *pack_find(const iui_glyph_pack *pack,
+                                    uint32_t cp,
+                                    const signed char **end)
+{
+    uint32_t lo = 0, hi = pack->count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const uint8_t *e = pack->index + (size_t) mid * IUI_GLYPH_PACK_ENTRY;
+        uint32_t key = pack_u32(e);
+        if (key < cp) {
+            lo = mid + 1;
+        } else if (key > cp) {
+            hi = mid;
+        } else {
+            uint32_t offset = pack_u32(e + 4);
+            /* A glyph needs at least its 6-byte header inside the data */
+            if (offset > pack->data_size || pack->data_size - offset < 6)
+                return NULL;
+            *end = pack->glyphs + pack->data_size;
+            return pack->glyphs + offset;
+        }
+    }
+    return NULL;
+}
+
+const signed char *iui_glyph_lookup(const iui_context *ctx,
+                                    uint32_t cp,
+                                    const signed char **end)
+{
+    const signed char *limit = NULL;
+    if (!end)
+        end = &limit;
+    *end = NULL;
+
+    /* ASCII (including the box for control bytes) is always built-in */
+    if (cp < 0x80)
+        return iui_get_glyph((unsigned char) cp);
+
+    for (int i = 0; i < ctx->glyph_pack_count; i++) {
+        const signed char *g = pack_find(&ctx->glyph_packs[i], cp, end);
+        if (g)
+            return g;
+    }
+    return iui_glyph_table; /* box */
+}
+
+#ifdef CONFIG_FEATURE_FONT_ATLAS
+/* Glyph rectangle in the baked atlas, offset from the glyph origin */
+typedef struct {
+    uint16_t x, y;
+    uint8_t width, height;
+    int8_t dx, dy;
+} iui_font_atlas_rect;
+
+#include "font-atlas-gen.inc"
+
+int iui_font_atlas_find(float font_height)
+{
+    for (int i = 0; i < IUI_FONT_ATLAS_SIZES; i++) {
+        if (iui_font_atlas_heights[i] == font_height)
+            return i;
+    }
+    return -1;
+}
+
+bool iui_font_atlas_glyph(int size,
+                          int gi,
+                          iui_glyph_mask_t *mask,
+                          int *dx,
+                          int *dy)
+{
+    const iui_font_atlas_rect *g = &iui_font_atlas_glyphs[size][gi];
+    if (g->width == 0)
+        return false;
+    mask->pixels = iui_font_atlas_pixels;
+    mask->stride = IUI_FONT_ATLAS_WIDTH * IUI_FONT_ATLAS_BPP / 8;
+    mask->x = g->x, mask->y = g->y;
+    mask->width = g->width, mask->height = g->height;
+    mask->bpp = IUI_FONT_ATLAS_BPP;
+    *dx = g->dx, *dy = g->dy;
+    return true;
+}
+#endif /* CONFIG_FEATURE_FONT_ATLAS */
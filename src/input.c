@@ -91,6 +91,85 @@ static void textfield_draw_icons(iui_context *ctx,
     }
 }
 
+/* Fill idx->x over buffer[from, to), starting from the offset at @from */
+static void textfield_index_measure(iui_context *ctx,
+                                    iui_text_index *idx,
+                                    const char *buffer,
+                                    size_t from,
+                                    size_t to)
+{
+    for (size_t pos = from; pos < to;) {
+        uint32_t cp = iui_utf8_decode(buffer, pos, to);
+        size_t next = iui_utf8_next(buffer, pos, to);
+        float w = iui_get_codepoint_width(ctx, cp);
+        for (size_t k = pos + 1; k < next; k++)
+            idx->x[k] = idx->x[pos];
+        idx->x[next] = idx->x[pos] + w;
+        pos = next;
+    }
+}
+
+/* Return the focused field's prefix-width index, rebuilding it when the
+ * field, font size or length no longer match. Edits made by the widget keep
+ * it current through textfield_index_edit(), so a steady frame is O(1).
+ *
+ * Returns NULL when buffer is not the focused field or is longer than
+ * IUI_TEXT_INDEX_CAPACITY.
+ */
+static const float *textfield_index_get(iui_context *ctx,
+                                        const char *buffer,
+                                        size_t len)
+{
+    iui_text_index *idx = &ctx->field_tracking.text_index;
+    if (buffer != ctx->focused_edit || len > IUI_TEXT_INDEX_CAPACITY) {
+        if (idx->owner == buffer)
+            idx->owner = NULL;
+        return NULL;
+    }
+
+    if (idx->owner != buffer || idx->font_height != ctx->font_height ||
+        idx->len != len) {
+        idx->x[0] = 0.f;
+        textfield_index_measure(ctx, idx, buffer, 0, len);
+        idx->len = len;
+        idx->owner = buffer;
+        idx->font_height = ctx->font_height;
+    }
+    return idx->x;
+}
+
+/* Patch the index after @removed bytes at @pos were replaced by @inserted
+ * bytes (buffer already holds the result). Only the inserted code points are
+ * measured; the suffix moves over and shifts by the width delta.
+ */
+static void textfield_index_edit(iui_context *ctx,
+                                 const char *buffer,
+                                 size_t pos,
+                                 size_t removed,
+                                 size_t inserted)
+{
+    iui_text_index *idx = &ctx->field_tracking.text_index;
+    if (idx->owner != buffer)
+        return;
+    size_t old_len = idx->len;
+    if (pos + removed > old_len ||
+        old_len - removed + inserted > IUI_TEXT_INDEX_CAPACITY) {
+        idx->owner = NULL;
+        return;
+    }
+
+    size_t len = old_len - removed + inserted;
+    float start = idx->x[pos], base = idx->x[pos + removed];
+    memmove(&idx->x[pos + inserted], &idx->x[pos + removed],
+            (old_len - pos - removed + 1) * sizeof(float));
+    idx->x[pos] = start;
+    textfield_index_measure(ctx, idx, buffer, pos, pos + inserted);
+    float shift = idx->x[pos + inserted] - base;
+    for (size_t k = pos + inserted + 1; k <= len; k++)
+        idx->x[k] += shift;
+    idx->len = len;
+}
+
 /* Get text width up to position, handling password masking */
 static float textfield_get_width_to_pos(iui_context *ctx,
                                         const char *buffer,
@@ -105,8 +184,14 @@ static float textfield_get_width_to_pos(iui_context *ctx,
     /* Clamp pos to actual buffer length to prevent OOB read */
     if (pos > buf_len)
         pos = buf_len;
-    size_t len = pos < sizeof(tmp) - 1 ? pos : sizeof(tmp) - 1;
 
+    if (!password_mode) {
+        const float *x = textfield_index_get(ctx, buffer, buf_len);
+        if (x)
+            return x[pos];
+    }
+
+    size_t len = pos < sizeof(tmp) - 1 ? pos : sizeof(tmp) - 1;
     if (password_mode) {
         for (size_t i = 0; i < len; i++)
             tmp[i] = '*';
@@ -117,48 +202,49 @@ static float textfield_get_width_to_pos(iui_context *ctx,
     return iui_get_text_width(ctx, tmp);
 }
 
-iui_textfield_result iui_textfield(iui_context *ctx,
-                                   char *buffer,
-                                   size_t size,
-                                   size_t *cursor,
-                                   const iui_textfield_options *options)
-{
-    iui_textfield_result result = {0};
-
-    if (!ctx->current_window || !buffer || !cursor || size == 0)
-        return result;
-
-    /* Register this text field for per-frame tracking */
-    iui_register_textfield(ctx, buffer);
+/* Geometry and focus of a plain text field for the current frame */
+typedef struct {
+    iui_rect_t edit_rect, leading_icon_rect, trailing_icon_rect;
+    float icon_size, text_x, text_y;
+    bool has_focus, editable;
+} textfield_frame_t;
 
-    /* Default options if NULL */
-    iui_textfield_options opts = {0};
-    if (options)
-        opts = *options;
+/* Lay out the field at the cursor, resolve icon clicks and focus changes for
+ * the field identified by @id
+ */
+static textfield_frame_t textfield_frame_begin(
+    iui_context *ctx,
+    void *id,
+    const iui_textfield_options *opts,
+    iui_textfield_result *result)
+{
+    textfield_frame_t f;
 
     /* Calculate icon dimensions */
     float icon_size = ctx->font_height, icon_padding = ctx->padding;
-    float leading_icon_width = (opts.leading_icon != IUI_TEXTFIELD_ICON_NONE)
+    float leading_icon_width = (opts->leading_icon != IUI_TEXTFIELD_ICON_NONE)
                                    ? (icon_size + icon_padding)
                                    : 0.f;
+    f.icon_size = icon_size;
 
     /* MD3 spec: TextField height = 56dp */
-    iui_rect_t edit_rect = {
+    f.edit_rect = (iui_rect_t) {
         .x = ctx->layout.x,
         .y = ctx->layout.y,
         .width = ctx->layout.width,
         .height = IUI_TEXTFIELD_HEIGHT,
     };
+    iui_rect_t edit_rect = f.edit_rect;
 
     /* Icon hit areas */
-    iui_rect_t leading_icon_rect = {
+    f.leading_icon_rect = (iui_rect_t) {
         .x = edit_rect.x + icon_padding * 0.5f,
         .y = edit_rect.y + (edit_rect.height - icon_size) * 0.5f,
         .width = icon_size,
         .height = icon_size,
     };
 
-    iui_rect_t trailing_icon_rect = {
+    f.trailing_icon_rect = (iui_rect_t) {
         .x = edit_rect.x + edit_rect.width - icon_size - icon_padding * 0.5f,
         .y = edit_rect.y + (edit_rect.height - icon_size) * 0.5f,
         .width = icon_size,
@@ -166,27 +252,28 @@ iui_textfield_result iui_textfield(iui_context *ctx,
     };
 
     /* Text area start position (between icons) */
-    float text_x_start = edit_rect.x + ctx->padding + leading_icon_width;
+    f.text_x = edit_rect.x + ctx->padding + leading_icon_width;
+    f.text_y = edit_rect.y + (edit_rect.height - ctx->font_height) * 0.5f;
 
     /* Check icon clicks first (only if not disabled) */
-    if (!opts.disabled && (ctx->mouse_pressed & IUI_MOUSE_LEFT)) {
-        if (opts.leading_icon != IUI_TEXTFIELD_ICON_NONE &&
-            in_rect(&leading_icon_rect, ctx->mouse_pos)) {
-            result.leading_icon_clicked = true;
+    if (!opts->disabled && (ctx->mouse_pressed & IUI_MOUSE_LEFT)) {
+        if (opts->leading_icon != IUI_TEXTFIELD_ICON_NONE &&
+            in_rect(&f.leading_icon_rect, ctx->mouse_pos)) {
+            result->leading_icon_clicked = true;
         }
-        if (opts.trailing_icon != IUI_TEXTFIELD_ICON_NONE &&
-            in_rect(&trailing_icon_rect, ctx->mouse_pos)) {
-            result.trailing_icon_clicked = true;
+        if (opts->trailing_icon != IUI_TEXTFIELD_ICON_NONE &&
+            in_rect(&f.trailing_icon_rect, ctx->mouse_pos)) {
+            result->trailing_icon_clicked = true;
         }
     }
 
     /* Focus handling (skip if disabled or read-only) */
-    bool has_focus = (ctx->focused_edit == buffer);
-    if (!opts.disabled && !opts.read_only) {
+    bool has_focus = (ctx->focused_edit == id);
+    if (!opts->disabled && !opts->read_only) {
         if ((ctx->mouse_pressed & IUI_MOUSE_LEFT) &&
             in_rect(&edit_rect, ctx->mouse_pos) &&
-            !result.leading_icon_clicked && !result.trailing_icon_clicked) {
-            ctx->focused_edit = buffer;
+            !result->leading_icon_clicked && !result->trailing_icon_clicked) {
+            ctx->focused_edit = id;
             has_focus = true;
             ctx->cursor_blink = 0.f;
         } else if ((ctx->mouse_pressed & IUI_MOUSE_LEFT) &&
@@ -194,40 +281,122 @@ iui_textfield_result iui_textfield(iui_context *ctx,
             ctx->focused_edit = NULL;
             has_focus = false;
         }
-    } else if ((opts.read_only || opts.disabled) && has_focus) {
+    } else if ((opts->read_only || opts->disabled) && has_focus) {
         /* Clear focus if field became read-only or disabled while focused */
         ctx->focused_edit = NULL;
         has_focus = false;
     }
+    f.has_focus = has_focus;
+    f.editable = has_focus && !opts->read_only && !opts->disabled;
+    return f;
+}
 
-    /* Handle keyboard input when focused (skip if read_only or disabled) */
-    if (has_focus && !opts.read_only && !opts.disabled) {
-        /* Handle Enter key (submit) first */
-        if (ctx->key_pressed == IUI_KEY_ENTER)
-            result.submitted = true;
+/* Draw background and icons; returns the colors for text */
+static textfield_colors_t textfield_frame_draw(
+    iui_context *ctx,
+    const textfield_frame_t *f,
+    const iui_textfield_options *opts)
+{
+    bool hovered = in_rect(&f->edit_rect, ctx->mouse_pos);
 
-        result.value_changed =
-            iui_process_text_input(ctx, buffer, size, cursor, true);
+    /* Calculate colors and draw background */
+    textfield_colors_t colors =
+        textfield_calc_colors(ctx, f->has_focus, hovered, opts->disabled);
+    textfield_draw_background(ctx, f->edit_rect, opts->style, &colors);
+    textfield_draw_icons(ctx, opts, f->leading_icon_rect, f->trailing_icon_rect,
+                         f->icon_size, colors.icon);
+    return colors;
+}
 
-        /* Reset cursor blink on navigation */
-        if (ctx->key_pressed == IUI_KEY_LEFT ||
-            ctx->key_pressed == IUI_KEY_RIGHT ||
-            ctx->key_pressed == IUI_KEY_HOME || ctx->key_pressed == IUI_KEY_END)
-            ctx->cursor_blink = 0.f;
-    }
+/* Whether the blinking cursor is drawn this frame */
+static bool textfield_cursor_due(const iui_context *ctx,
+                                 const textfield_frame_t *f,
+                                 const iui_textfield_options *opts)
+{
+    return f->has_focus && !opts->disabled && ctx->cursor_blink < 0.5f;
+}
 
-    bool hovered = in_rect(&edit_rect, ctx->mouse_pos);
+static void textfield_draw_cursor(iui_context *ctx,
+                                  const textfield_frame_t *f,
+                                  float cursor_x)
+{
+    ctx->renderer.draw_box((iui_rect_t) {cursor_x, f->text_y,
+                                         IUI_TEXTFIELD_CURSOR_WIDTH,
+                                         ctx->font_height},
+                           0.f, ctx->colors.primary, ctx->renderer.user);
+}
 
-    /* Calculate colors and draw background */
-    textfield_colors_t colors =
-        textfield_calc_colors(ctx, has_focus, hovered, opts.disabled);
-    textfield_draw_background(ctx, edit_rect, opts.style, &colors);
-    textfield_draw_icons(ctx, &opts, leading_icon_rect, trailing_icon_rect,
-                         icon_size, colors.icon);
+static void textfield_frame_end(iui_context *ctx, const textfield_frame_t *f)
+{
+    iui_newline(ctx);
+    /* Only clear input if this field consumed it (has focus and is editable) */
+    if (f->editable)
+        iui_text_events_consume(ctx);
+
+    /* MD3 runtime validation: track rendered textfield dimensions */
+    IUI_MD3_TRACK_TEXTFIELD(f->edit_rect, ctx->corner);
+}
+
+/* Reset cursor blink on navigation */
+static void textfield_blink_on_nav(iui_context *ctx)
+{
+    if (ctx->key_pressed == IUI_KEY_LEFT || ctx->key_pressed == IUI_KEY_RIGHT ||
+        ctx->key_pressed == IUI_KEY_HOME || ctx->key_pressed == IUI_KEY_END)
+        ctx->cursor_blink = 0.f;
+}
+
+iui_textfield_result iui_textfield(iui_context *ctx,
+                                   char *buffer,
+                                   size_t size,
+                                   size_t *cursor,
+                                   const iui_textfield_options *options)
+{
+    iui_textfield_result result = {0};
+
+    if (!ctx->current_window || !buffer || !cursor || size == 0)
+        return result;
+
+    /* Register this text field for per-frame tracking */
+    iui_register_textfield(ctx, buffer);
+
+    /* Default options if NULL */
+    iui_textfield_options opts = {0};
+    if (options)
+        opts = *options;
+
+    textfield_frame_t f = textfield_frame_begin(ctx, buffer, &opts, &result);
+
+    /* Handle keyboard input when focused (skip if read_only or disabled) */
+    if (f.editable) {
+        /* Replay every key and character queued since the last frame */
+        for (int it = 0; iui_text_event_next(ctx, &it);) {
+            /* Handle Enter key (submit) first */
+            if (ctx->key_pressed == IUI_KEY_ENTER)
+                result.submitted = true;
+
+            /* One event makes at most one edit, ending at the cursor for an
+             * insert and starting there for a delete
+             */
+            size_t old_len = strlen(buffer);
+            if (iui_process_text_input(ctx, buffer, size, cursor, true)) {
+                result.value_changed = true;
+                size_t len = strlen(buffer);
+                if (len > old_len)
+                    textfield_index_edit(ctx, buffer, *cursor - (len - old_len),
+                                         0, len - old_len);
+                else
+                    textfield_index_edit(ctx, buffer, *cursor, old_len - len,
+                                         0);
+            }
+
+            textfield_blink_on_nav(ctx);
+        }
+    }
+
+    textfield_colors_t colors = textfield_frame_draw(ctx, &f, &opts);
 
     /* Draw text or placeholder */
-    float text_x = text_x_start,
-          text_y = edit_rect.y + (edit_rect.height - ctx->font_height) * 0.5f;
+    float text_x = f.text_x, text_y = f.text_y;
 
     if (buffer[0] == '\0' && opts.placeholder) {
         /* Placeholder text */
@@ -251,28 +420,424 @@ iui_textfield_result iui_textfield(iui_context *ctx,
     }
 
     /* Draw cursor when focused */
-    if (has_focus && !opts.disabled && ctx->cursor_blink < 0.5f) {
+    if (textfield_cursor_due(ctx, &f, &opts)) {
         size_t len = strlen(buffer), pos = *cursor;
         if (pos > len)
             pos = len;
         float cursor_x = text_x + textfield_get_width_to_pos(
                                       ctx, buffer, pos, opts.password_mode);
-        ctx->renderer.draw_box(
-            (iui_rect_t) {cursor_x, text_y, IUI_TEXTFIELD_CURSOR_WIDTH,
-                          ctx->font_height},
-            0.f, ctx->colors.primary, ctx->renderer.user);
+        textfield_draw_cursor(ctx, &f, cursor_x);
     }
 
-    iui_newline(ctx);
-    /* Only clear input if this field consumed it (has focus and is editable) */
-    if (has_focus && !opts.read_only && !opts.disabled) {
-        ctx->key_pressed = 0;
-        ctx->char_input = 0;
+    textfield_frame_end(ctx, &f);
+    return result;
+}
+
+/* Gap Buffer Text Storage */
+
+/* Byte at text offset @i (< length), skipping over the gap */
+static inline char text_buffer_at(const iui_text_buffer_t *tb, size_t i)
+{
+    return tb->data[i < tb->gap ? i : i + tb->gap_len];
+}
+
+/* Code point stepping and decoding at text offsets. The gap always sits on
+ * a code point boundary, so no sequence straddles it.
+ */
+static size_t text_buffer_next(const iui_text_buffer_t *tb, size_t pos)
+{
+    if (pos < tb->gap)
+        return iui_utf8_next(tb->data, pos, tb->gap);
+    size_t after = tb->gap + tb->gap_len;
+    return tb->gap + iui_utf8_next(tb->data + after, pos - tb->gap,
+                                   tb->capacity - 1 - after);
+}
+
+static size_t text_buffer_prev(const iui_text_buffer_t *tb, size_t pos)
+{
+    if (pos <= tb->gap)
+        return iui_utf8_prev(tb->data, pos);
+    return tb->gap + iui_utf8_prev(tb->data + tb->gap + tb->gap_len,
+                                   pos - tb->gap);
+}
+
+static uint32_t text_buffer_decode(const iui_text_buffer_t *tb, size_t pos)
+{
+    if (pos < tb->gap)
+        return iui_utf8_decode(tb->data, pos, tb->gap);
+    size_t after = tb->gap + tb->gap_len;
+    return iui_utf8_decode(tb->data + after, pos - tb->gap,
+                           tb->capacity - 1 - after);
+}
+
+/* Read-only view of a flat string as a gap buffer with the gap at its end */
+static iui_text_buffer_t text_view(const char *buffer, size_t len)
+{
+    return (iui_text_buffer_t) {
+        .data = (char *) buffer,
+        .capacity = len + 1,
+        .gap = len,
+    };
+}
+
+bool iui_text_buffer_init(iui_text_buffer_t *tb,
+                          char *storage,
+                          size_t capacity,
+                          const char *text)
+{
+    if (!tb)
+        return false;
+    *tb = (iui_text_buffer_t) {0};
+    if (!storage || capacity == 0)
+        return false;
+
+    /* Truncate on a code point boundary */
+    size_t room = capacity - 1, n = text ? strlen(text) : 0;
+    bool fits = n <= room;
+    if (!fits) {
+        n = room;
+        while (n > 0 && iui_utf8_is_continuation((uint8_t) text[n]))
+            n--;
     }
+    if (n)
+        memcpy(storage, text, n);
+    storage[room] = '\0';
+    tb->data = storage;
+    tb->capacity = capacity;
+    tb->gap = n;
+    tb->gap_len = room - n;
+    return fits;
+}
 
-    /* MD3 runtime validation: track rendered textfield dimensions */
-    IUI_MD3_TRACK_TEXTFIELD(edit_rect, ctx->corner);
+size_t iui_text_buffer_length(const iui_text_buffer_t *tb)
+{
+    return tb && tb->capacity ? tb->capacity - 1 - tb->gap_len : 0;
+}
+
+void iui_text_buffer_move(iui_text_buffer_t *tb, size_t pos)
+{
+    size_t len = iui_text_buffer_length(tb);
+    if (!len)
+        return;
+    if (pos > len)
+        pos = len;
+    while (pos > 0 && pos < len &&
+           iui_utf8_is_continuation((uint8_t) text_buffer_at(tb, pos)))
+        pos--;
+
+    /* Carry the bytes between the old and new cursor across the gap */
+    char *d = tb->data;
+    if (pos < tb->gap)
+        memmove(d + pos + tb->gap_len, d + pos, tb->gap - pos);
+    else
+        memmove(d + tb->gap, d + tb->gap + tb->gap_len, pos - tb->gap);
+    tb->gap = pos;
+}
+
+bool iui_text_buffer_insert(iui_text_buffer_t *tb, const char *text, size_t n)
+{
+    if (!tb || !text || n > tb->gap_len)
+        return false;
+    memcpy(tb->data + tb->gap, text, n);
+    tb->gap += n;
+    tb->gap_len -= n;
+    tb->version++;
+    return true;
+}
+
+void iui_text_buffer_erase(iui_text_buffer_t *tb, size_t before, size_t after)
+{
+    if (!tb || !tb->capacity)
+        return;
+    size_t tail = tb->capacity - 1 - tb->gap - tb->gap_len;
+    if (before > tb->gap)
+        before = tb->gap;
+    if (after > tail)
+        after = tail;
+    if (!before && !after)
+        return;
+    tb->gap -= before;
+    tb->gap_len += before + after;
+    tb->version++;
+}
+
+size_t iui_text_buffer_copy(const iui_text_buffer_t *tb,
+                            char *out,
+                            size_t size)
+{
+    size_t len = iui_text_buffer_length(tb);
+    if (!out || size == 0)
+        return len;
+    size_t head = 0, tail = 0;
+    if (len) {
+        size_t after = len - tb->gap;
+        head = tb->gap < size - 1 ? tb->gap : size - 1;
+        tail = after < size - 1 - head ? after : size - 1 - head;
+        memcpy(out, tb->data, head);
+        memcpy(out + head, tb->data + tb->gap + tb->gap_len, tail);
+    }
+    out[head + tail] = '\0';
+    return len;
+}
+
+/* Code point just before / after the cursor, 0 at either end */
+static uint32_t text_buffer_peek_left(const iui_text_buffer_t *tb)
+{
+    if (tb->gap == 0)
+        return 0;
+    return iui_utf8_decode(tb->data, iui_utf8_prev(tb->data, tb->gap),
+                           tb->gap);
+}
+
+static uint32_t text_buffer_peek_right(const iui_text_buffer_t *tb)
+{
+    size_t after = tb->gap + tb->gap_len, end = tb->capacity - 1;
+    return after < end ? iui_utf8_decode(tb->data, after, end) : 0;
+}
+
+/* Move the cursor over one code point */
+static void text_buffer_step_left(iui_text_buffer_t *tb)
+{
+    iui_text_buffer_move(tb, iui_utf8_prev(tb->data, tb->gap));
+}
+
+static void text_buffer_step_right(iui_text_buffer_t *tb)
+{
+    size_t after = tb->gap + tb->gap_len, end = tb->capacity - 1;
+    size_t n = iui_utf8_next(tb->data, after, end) - after;
+    iui_text_buffer_move(tb, tb->gap + n);
+}
+
+static inline bool text_is_blank(uint32_t cp)
+{
+    return cp == ' ' || cp == '\t';
+}
+
+/* Gap-buffer counterpart of iui_process_text_input: the same keys, but
+ * inserts and deletions at the cursor touch only the gap
+ */
+static bool text_buffer_process_input(iui_context *ctx, iui_text_buffer_t *tb)
+{
+    bool modified = false;
+
+    if (ctx->char_input >= 32) {
+        char utf8_buf[4];
+        size_t cp_len = iui_utf8_encode(ctx->char_input, utf8_buf);
+        modified = iui_text_buffer_insert(tb, utf8_buf, cp_len);
+    }
+
+    bool word = (ctx->modifiers & IUI_MOD_CTRL) != 0;
+    size_t after = tb->gap + tb->gap_len, end = tb->capacity - 1;
+    switch (ctx->key_pressed) {
+    case IUI_KEY_BACKSPACE:
+        if (tb->gap > 0) {
+            iui_text_buffer_erase(
+                tb, tb->gap - iui_utf8_prev(tb->data, tb->gap), 0);
+            modified = true;
+        }
+        break;
+    case IUI_KEY_DELETE:
+        if (after < end) {
+            iui_text_buffer_erase(
+                tb, 0, iui_utf8_next(tb->data, after, end) - after);
+            modified = true;
+        }
+        break;
+    case IUI_KEY_LEFT:
+        if (!word) {
+            if (tb->gap > 0)
+                text_buffer_step_left(tb);
+            break;
+        }
+        /* Ctrl+Left: skip whitespace then word */
+        while (text_is_blank(text_buffer_peek_left(tb)))
+            text_buffer_step_left(tb);
+        while (tb->gap > 0 && iui_utf8_is_word_char(text_buffer_peek_left(tb)))
+            text_buffer_step_left(tb);
+        break;
+    case IUI_KEY_RIGHT:
+        if (!word) {
+            if (after < end)
+                text_buffer_step_right(tb);
+            break;
+        }
+        /* Ctrl+Right: skip word then whitespace */
+        while (tb->gap + tb->gap_len < end &&
+               iui_utf8_is_word_char(text_buffer_peek_right(tb)))
+            text_buffer_step_right(tb);
+        while (text_is_blank(text_buffer_peek_right(tb)))
+            text_buffer_step_right(tb);
+        break;
+    case IUI_KEY_HOME:
+        iui_text_buffer_move(tb, 0);
+        break;
+    case IUI_KEY_END:
+        iui_text_buffer_move(tb, iui_text_buffer_length(tb));
+        break;
+    default:
+        break;
+    }
+    return modified;
+}
+
+/* Width and code point count of text offsets [from, to) */
+static float text_buffer_span(iui_context *ctx,
+                              const iui_text_buffer_t *tb,
+                              size_t from,
+                              size_t to,
+                              size_t *count)
+{
+    float w = 0.f;
+    size_t n = 0;
+    for (size_t p = from; p < to; p = text_buffer_next(tb, p), n++)
+        w += iui_get_codepoint_width(ctx, text_buffer_decode(tb, p));
+    *count = n;
+    return w;
+}
+
+/* Bring tb->measured up to date. A new version or font size re-measures the
+ * text once; a cursor move with the text unchanged only measures the span
+ * the gap crossed, so a steady frame costs nothing.
+ */
+static void text_buffer_measure(iui_context *ctx, iui_text_buffer_t *tb)
+{
+    size_t n;
+    if (tb->measured.version != tb->version ||
+        tb->measured.font_height != ctx->font_height) {
+        size_t len = iui_text_buffer_length(tb);
+        tb->measured.head_width = text_buffer_span(ctx, tb, 0, tb->gap, &n);
+        tb->measured.head_count = n;
+        tb->measured.width = tb->measured.head_width +
+                             text_buffer_span(ctx, tb, tb->gap, len, &n);
+        tb->measured.count = tb->measured.head_count + n;
+    } else if (tb->measured.gap < tb->gap) {
+        tb->measured.head_width +=
+            text_buffer_span(ctx, tb, tb->measured.gap, tb->gap, &n);
+        tb->measured.head_count += n;
+    } else if (tb->measured.gap > tb->gap) {
+        tb->measured.head_width -=
+            text_buffer_span(ctx, tb, tb->gap, tb->measured.gap, &n);
+        tb->measured.head_count -= n;
+    }
+    tb->measured.version = tb->version;
+    tb->measured.gap = tb->gap;
+    tb->measured.font_height = ctx->font_height;
+}
+
+/* Width of the text before offset @pos, each code point masked as '*' in
+ * password mode. Measured from the gap, so the cursor and the full width
+ * cost nothing and a selection end costs its distance from the cursor.
+ */
+static float text_buffer_width_to(iui_context *ctx,
+                                  iui_text_buffer_t *tb,
+                                  size_t pos,
+                                  bool password_mode)
+{
+    text_buffer_measure(ctx, tb);
+    size_t count = tb->measured.head_count, n;
+    float w = tb->measured.head_width;
+    if (pos >= iui_text_buffer_length(tb)) {
+        count = tb->measured.count;
+        w = tb->measured.width;
+    } else if (pos < tb->gap) {
+        w -= text_buffer_span(ctx, tb, pos, tb->gap, &n);
+        count -= n;
+    } else {
+        w += text_buffer_span(ctx, tb, tb->gap, pos, &n);
+        count += n;
+    }
+    return password_mode ? (float) count * iui_get_codepoint_width(ctx, '*')
+                         : w;
+}
+
+/* Draw the runs before and after the gap at @x, the second one @head_width
+ * further right; tb->measured must be current. A full buffer has no gap
+ * byte to terminate the first run, but then the text is contiguous up to
+ * the reserved terminator anyway.
+ */
+static void text_buffer_draw(iui_context *ctx,
+                             iui_text_buffer_t *tb,
+                             float x,
+                             float y,
+                             float head_width,
+                             bool password_mode,
+                             uint32_t color)
+{
+    char *d = tb->data;
+    if (password_mode) {
+        /* One mask character per code point, not per byte, drawn in chunks
+         * of the string buffer so the mask spans the whole text, as the
+         * cursor and hit-testing measure it
+         */
+        char masked[IUI_STRING_BUFFER_SIZE];
+        size_t count = tb->measured.count, chunk = sizeof(masked) - 1;
+        float mask_width = iui_get_codepoint_width(ctx, '*');
+        memset(masked, '*', chunk);
+        for (size_t i = 0; i < count; i += chunk) {
+            size_t n = count - i < chunk ? count - i : chunk;
+            masked[n] = '\0';
+            iui_internal_draw_text(ctx, x + (float) i * mask_width, y, masked,
+                                   color);
+            masked[n] = '*';
+        }
+    } else if (tb->gap_len == 0) {
+        iui_internal_draw_text(ctx, x, y, d, color);
+    } else {
+        const char *tail = d + tb->gap + tb->gap_len;
+        d[tb->gap] = '\0'; /* inside the gap */
+        if (tb->gap)
+            iui_internal_draw_text(ctx, x, y, d, color);
+        if (*tail)
+            iui_internal_draw_text(ctx, x + head_width, y, tail, color);
+    }
+}
+
+iui_textfield_result iui_textfield_buffer(iui_context *ctx,
+                                          iui_text_buffer_t *tb,
+                                          const iui_textfield_options *options)
+{
+    iui_textfield_result result = {0};
+
+    if (!ctx->current_window || !tb || !tb->data || tb->capacity == 0)
+        return result;
+
+    iui_register_textfield(ctx, tb);
 
+    iui_textfield_options opts = {0};
+    if (options)
+        opts = *options;
+
+    textfield_frame_t f = textfield_frame_begin(ctx, tb, &opts, &result);
+
+    if (f.editable) {
+        for (int it = 0; iui_text_event_next(ctx, &it);) {
+            if (ctx->key_pressed == IUI_KEY_ENTER)
+                result.submitted = true;
+            if (text_buffer_process_input(ctx, tb))
+                result.value_changed = true;
+            textfield_blink_on_nav(ctx);
+        }
+    }
+
+    textfield_colors_t colors = textfield_frame_draw(ctx, &f, &opts);
+
+    /* The cursor sits at the gap, right after the first run */
+    float cursor_dx = 0.f;
+    if (iui_text_buffer_length(tb) == 0 && opts.placeholder) {
+        iui_internal_draw_text(
+            ctx, f.text_x, f.text_y, opts.placeholder,
+            iui_state_layer(ctx->colors.on_surface, IUI_PLACEHOLDER_ALPHA));
+    } else {
+        cursor_dx =
+            text_buffer_width_to(ctx, tb, tb->gap, opts.password_mode);
+        text_buffer_draw(ctx, tb, f.text_x, f.text_y, cursor_dx,
+                         opts.password_mode, colors.text);
+    }
+
+    if (textfield_cursor_due(ctx, &f, &opts))
+        textfield_draw_cursor(ctx, &f, f.text_x + cursor_dx);
+
+    textfield_frame_end(ctx, &f);
     return result;
 }
 
@@ -285,7 +850,8 @@ iui_textfield_result iui_textfield(iui_context *ctx,
  * @click_x:      X coordinate of mouse click
  *
  * Returns byte position in buffer closest to click_x.
- * Uses incremental width computation for O(n) complexity.
+ * The focused field binary-searches its prefix-width index; other fields use
+ * incremental width computation for O(n) complexity.
  * Iterates by UTF-8 codepoint to ensure cursor lands on valid boundaries.
  */
 static size_t iui_find_cursor_from_x(iui_context *ctx,
@@ -297,6 +863,25 @@ static size_t iui_find_cursor_from_x(iui_context *ctx,
     if (len == 0)
         return 0;
 
+    const float *xs = textfield_index_get(ctx, buffer, len);
+    if (xs) {
+        /* First boundary at or right of the click, then its left neighbour */
+        float target = click_x - text_x_start;
+        size_t lo = 0, hi = len;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (xs[mid] < target)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo == 0)
+            return 0;
+        size_t prev = iui_utf8_prev(buffer, lo);
+        return (fabsf(target - xs[prev]) <= fabsf(xs[lo] - target)) ? prev
+                                                                      : lo;
+    }
+
     float best_dist = fabsf(click_x - text_x_start);
     float cumulative_x = text_x_start;
     size_t pos = 0;
@@ -324,12 +909,12 @@ static size_t iui_find_cursor_from_x(iui_context *ctx,
 /* Find word boundaries around a position (UTF-8 aware).
  * Returns byte positions for start and end of word containing pos.
  */
-static void iui_find_word_boundaries(const char *buffer,
+static void iui_find_word_boundaries(const iui_text_buffer_t *text,
                                      size_t pos,
                                      size_t *start,
                                      size_t *end)
 {
-    size_t len = strlen(buffer);
+    size_t len = iui_text_buffer_length(text);
     if (len == 0) {
         *start = *end = 0;
         return;
@@ -338,15 +923,15 @@ static void iui_find_word_boundaries(const char *buffer,
     /* Clamp pos to valid range and ensure at code point boundary */
     if (pos >= len)
         pos = len - 1;
-    while (pos > 0 && iui_utf8_is_continuation((unsigned char) buffer[pos]))
+    while (pos > 0 &&
+           iui_utf8_is_continuation((unsigned char) text_buffer_at(text, pos)))
         pos--;
 
     /* Find start: scan backward to find word boundary (UTF-8 aware) */
     *start = pos;
     while (*start > 0) {
-        size_t prev = iui_utf8_prev(buffer, *start);
-        uint32_t cp = iui_utf8_decode(buffer, prev, len);
-        if (!iui_utf8_is_word_char(cp))
+        size_t prev = text_buffer_prev(text, *start);
+        if (!iui_utf8_is_word_char(text_buffer_decode(text, prev)))
             break;
         *start = prev;
     }
@@ -354,15 +939,14 @@ static void iui_find_word_boundaries(const char *buffer,
     /* Find end: scan forward to find word boundary (UTF-8 aware) */
     *end = pos;
     while (*end < len) {
-        uint32_t cp = iui_utf8_decode(buffer, *end, len);
-        if (!iui_utf8_is_word_char(cp))
+        if (!iui_utf8_is_word_char(text_buffer_decode(text, *end)))
             break;
-        *end = iui_utf8_next(buffer, *end, len);
+        *end = text_buffer_next(text, *end);
     }
 
     /* If landed on non-word char, select the single code point */
     if (*start == *end && len > 0)
-        *end = iui_utf8_next(buffer, *start, len);
+        *end = text_buffer_next(text, *start);
 }
 
 /* Normalize selection: ensure start <= end */
@@ -376,7 +960,9 @@ static void iui_normalize_selection(iui_edit_state *state)
 }
 
 /* Delete selected text, returns true if text was deleted */
-static bool iui_delete_selection(char *buffer, iui_edit_state *state)
+static bool iui_delete_selection(iui_context *ctx,
+                                 char *buffer,
+                                 iui_edit_state *state)
 {
     iui_normalize_selection(state);
     if (state->selection_start == state->selection_end)
@@ -387,6 +973,8 @@ static bool iui_delete_selection(char *buffer, iui_edit_state *state)
     /* Move text after selection to fill gap */
     memmove(buffer + state->selection_start, buffer + state->selection_end,
             len - state->selection_end + 1);
+    textfield_index_edit(ctx, buffer, state->selection_start,
+                         state->selection_end - state->selection_start, 0);
 
     /* Update cursor to selection start */
     state->cursor = state->selection_start;
@@ -434,6 +1022,7 @@ static bool textfield_insert_char(iui_context *ctx,
         memmove(buffer + state->cursor + cp_len, buffer + state->cursor,
                 len - state->cursor + 1);
         memcpy(buffer + state->cursor, utf8_buf, cp_len);
+        textfield_index_edit(ctx, buffer, state->cursor, 0, cp_len);
         state->cursor += cp_len;
         state->selection_start = state->selection_end = state->cursor;
         return true;
@@ -442,69 +1031,58 @@ static bool textfield_insert_char(iui_context *ctx,
 }
 
 /* Move cursor left with Ctrl+word skip support */
-static void textfield_move_left(const char *buffer,
-                                size_t len,
+static void textfield_move_left(const iui_text_buffer_t *text,
                                 iui_edit_state *state,
                                 bool ctrl_held)
 {
-    if (!buffer || !state)
-        return;
     if (ctrl_held) {
         size_t prev = state->cursor;
         while (prev > 0) {
-            prev = iui_utf8_prev(buffer, prev);
-            uint32_t cp = iui_utf8_decode(buffer, prev, len);
-            if (cp != ' ' && cp != '\t')
+            prev = text_buffer_prev(text, prev);
+            if (!text_is_blank(text_buffer_decode(text, prev)))
                 break;
             state->cursor = prev;
         }
         while (state->cursor > 0) {
-            size_t prev = iui_utf8_prev(buffer, state->cursor);
-            uint32_t cp = iui_utf8_decode(buffer, prev, len);
-            if (!iui_utf8_is_word_char(cp))
+            size_t prev = text_buffer_prev(text, state->cursor);
+            if (!iui_utf8_is_word_char(text_buffer_decode(text, prev)))
                 break;
             state->cursor = prev;
         }
     } else {
-        state->cursor = iui_utf8_prev(buffer, state->cursor);
+        state->cursor = text_buffer_prev(text, state->cursor);
     }
 }
 
 /* Move cursor right with Ctrl+word skip support */
-static void textfield_move_right(const char *buffer,
+static void textfield_move_right(const iui_text_buffer_t *text,
                                  size_t len,
                                  iui_edit_state *state,
                                  bool ctrl_held)
 {
-    if (!buffer || !state)
-        return;
     if (ctrl_held) {
-        while (state->cursor < len) {
-            uint32_t cp = iui_utf8_decode(buffer, state->cursor, len);
-            if (!iui_utf8_is_word_char(cp))
-                break;
-            state->cursor = iui_utf8_next(buffer, state->cursor, len);
-        }
-        while (state->cursor < len) {
-            uint32_t cp = iui_utf8_decode(buffer, state->cursor, len);
-            if (cp != ' ' && cp != '\t')
-                break;
-            state->cursor = iui_utf8_next(buffer, state->cursor, len);
-        }
+        while (state->cursor < len &&
+               iui_utf8_is_word_char(text_buffer_decode(text, state->cursor)))
+            state->cursor = text_buffer_next(text, state->cursor);
+        while (state->cursor < len &&
+               text_is_blank(text_buffer_decode(text, state->cursor)))
+            state->cursor = text_buffer_next(text, state->cursor);
     } else {
-        state->cursor = iui_utf8_next(buffer, state->cursor, len);
+        state->cursor = text_buffer_next(text, state->cursor);
     }
 }
 
-/* Handle cursor movement with selection extension */
-static void textfield_handle_cursor_movement(const char *buffer,
+/* Handle cursor movement with selection extension; @text is a flat string
+ * view (text_view) or a gap buffer
+ */
+static void textfield_handle_cursor_movement(const iui_text_buffer_t *text,
                                              size_t len,
                                              iui_edit_state *state,
                                              bool shift_held,
                                              bool ctrl_held,
                                              enum iui_key_code key)
 {
-    if (!buffer || !state)
+    if (!state)
         return;
     if (key == IUI_KEY_LEFT) {
         if (shift_held) {
@@ -512,7 +1090,7 @@ static void textfield_handle_cursor_movement(const char *buffer,
                 if (!iui_has_selection(state))
                     state->selection_start = state->selection_end =
                         state->cursor;
-                textfield_move_left(buffer, len, state, ctrl_held);
+                textfield_move_left(text, state, ctrl_held);
                 if (state->cursor < state->selection_start)
                     state->selection_start = state->cursor;
                 else
@@ -523,7 +1101,7 @@ static void textfield_handle_cursor_movement(const char *buffer,
                 iui_normalize_selection(state);
                 state->cursor = state->selection_start;
             } else if (state->cursor > 0) {
-                textfield_move_left(buffer, len, state, ctrl_held);
+                textfield_move_left(text, state, ctrl_held);
             }
             state->selection_start = state->selection_end = state->cursor;
         }
@@ -533,7 +1111,7 @@ static void textfield_handle_cursor_movement(const char *buffer,
                 if (!iui_has_selection(state))
                     state->selection_start = state->selection_end =
                         state->cursor;
-                textfield_move_right(buffer, len, state, ctrl_held);
+                textfield_move_right(text, len, state, ctrl_held);
                 if (state->cursor > state->selection_end)
                     state->selection_end = state->cursor;
                 else
@@ -544,7 +1122,7 @@ static void textfield_handle_cursor_movement(const char *buffer,
                 iui_normalize_selection(state);
                 state->cursor = state->selection_end;
             } else if (state->cursor < len) {
-                textfield_move_right(buffer, len, state, ctrl_held);
+                textfield_move_right(text, len, state, ctrl_held);
             }
             state->selection_start = state->selection_end = state->cursor;
         }
@@ -571,6 +1149,77 @@ static void textfield_handle_cursor_movement(const char *buffer,
     }
 }
 
+/* Apply a press at @click_pos: single click places the cursor and starts a
+ * drag, a second click selects the word, a third selects everything
+ */
+static void textfield_select_click(const iui_text_buffer_t *text,
+                                   iui_edit_state *state,
+                                   size_t click_pos)
+{
+    bool near = fabsf((float) click_pos - (float) state->last_click_pos) < 3;
+    if (state->last_click_count >= 2 && near) {
+        /* Triple click: select all */
+        size_t len = iui_text_buffer_length(text);
+        state->selection_start = 0;
+        state->selection_end = len;
+        state->cursor = len;
+        state->last_click_count = 0;
+    } else if (state->last_click_count == 1 && near) {
+        /* Double click: select word */
+        iui_find_word_boundaries(text, click_pos, &state->selection_start,
+                                 &state->selection_end);
+        state->cursor = state->selection_end;
+        state->last_click_count = 2;
+    } else {
+        /* Single click: position cursor */
+        state->cursor = click_pos;
+        state->selection_start = click_pos;
+        state->selection_end = click_pos;
+        state->last_click_count = 1;
+        state->last_click_pos = click_pos;
+        state->is_dragging = true;
+    }
+    /* Reset timing for next click detection */
+    state->last_click_time = 0.f;
+}
+
+/* Extend the selection from the drag anchor to @drag_pos */
+static void textfield_select_drag(iui_edit_state *state, size_t drag_pos)
+{
+    state->cursor = drag_pos;
+    if (drag_pos < state->last_click_pos) {
+        state->selection_start = drag_pos;
+        state->selection_end = state->last_click_pos;
+    } else {
+        state->selection_start = state->last_click_pos;
+        state->selection_end = drag_pos;
+    }
+}
+
+/* Draw the selection highlight between text offsets @x0 and @x1, clipped to
+ * the text area (MD3: primary @ 40% focused, 20% unfocused)
+ */
+static void textfield_draw_selection(iui_context *ctx,
+                                     float x0,
+                                     float x1,
+                                     float clip_x,
+                                     float clip_width,
+                                     float y,
+                                     bool has_focus)
+{
+    float visible_start = fmaxf(x0, clip_x);
+    float visible_end = fminf(x1, clip_x + clip_width);
+    if (visible_end <= visible_start)
+        return;
+    uint8_t sel_alpha =
+        has_focus ? IUI_SELECTION_ALPHA : (IUI_SELECTION_ALPHA / 2);
+    ctx->renderer.draw_box(
+        (iui_rect_t) {visible_start, y, visible_end - visible_start,
+                      ctx->font_height},
+        0.f, iui_state_layer(ctx->colors.primary, sel_alpha),
+        ctx->renderer.user);
+}
+
 /* Process text input with selection support (UTF-8 aware) */
 static bool iui_process_text_input_selection(iui_context *ctx,
                                              char *buffer,
@@ -588,7 +1237,7 @@ static bool iui_process_text_input_selection(iui_context *ctx,
     /* Character input - replace selection if active (UTF-8 aware) */
     if (ctx->char_input >= 32) {
         if (iui_has_selection(state)) {
-            iui_delete_selection(buffer, state);
+            iui_delete_selection(ctx, buffer, state);
             len = strlen(buffer);
             modified = true;
         }
@@ -602,19 +1251,23 @@ static bool iui_process_text_input_selection(iui_context *ctx,
     case IUI_KEY_LEFT:
     case IUI_KEY_RIGHT:
     case IUI_KEY_HOME:
-    case IUI_KEY_END:
-        textfield_handle_cursor_movement(buffer, len, state, shift_held,
+    case IUI_KEY_END: {
+        iui_text_buffer_t view = text_view(buffer, len);
+        textfield_handle_cursor_movement(&view, len, state, shift_held,
                                          ctrl_held, ctx->key_pressed);
         break;
+    }
 
     case IUI_KEY_BACKSPACE:
         if (iui_has_selection(state)) {
-            modified = iui_delete_selection(buffer, state);
+            modified = iui_delete_selection(ctx, buffer, state);
         } else if (state->cursor > 0 && len > 0) {
             /* Delete previous UTF-8 code point */
             size_t prev_pos = iui_utf8_prev(buffer, state->cursor);
             memmove(buffer + prev_pos, buffer + state->cursor,
                     len - state->cursor + 1);
+            textfield_index_edit(ctx, buffer, prev_pos,
+                                 state->cursor - prev_pos, 0);
             state->cursor = prev_pos;
             modified = true;
         }
@@ -623,12 +1276,14 @@ static bool iui_process_text_input_selection(iui_context *ctx,
 
     case IUI_KEY_DELETE:
         if (iui_has_selection(state)) {
-            modified = iui_delete_selection(buffer, state);
+            modified = iui_delete_selection(ctx, buffer, state);
         } else if (state->cursor < len) {
             /* Delete current UTF-8 code point */
             size_t next_pos = iui_utf8_next(buffer, state->cursor, len);
             memmove(buffer + state->cursor, buffer + next_pos,
                     len - next_pos + 1);
+            textfield_index_edit(ctx, buffer, state->cursor,
+                                 next_pos - state->cursor, 0);
             modified = true;
         }
         state->selection_start = state->selection_end = state->cursor;
@@ -705,34 +1360,8 @@ bool iui_edit_with_selection(iui_context *ctx,
         /* Calculate click position in text */
         float click_x = ctx->mouse_pos.x + state->scroll_offset;
         size_t click_pos = iui_find_cursor_from_x(ctx, buffer, text_x, click_x);
-
-        /* Double/triple click detection based on click count and position */
-        if (state->last_click_count >= 2 &&
-            fabsf((float) click_pos - (float) state->last_click_pos) < 3) {
-            /* Triple click: select all */
-            state->selection_start = 0;
-            state->selection_end = len;
-            state->cursor = len;
-            state->last_click_count = 0;
-        } else if (state->last_click_count == 1 &&
-                   fabsf((float) click_pos - (float) state->last_click_pos) <
-                       3) {
-            /* Double click: select word */
-            iui_find_word_boundaries(buffer, click_pos, &state->selection_start,
-                                     &state->selection_end);
-            state->cursor = state->selection_end;
-            state->last_click_count = 2;
-        } else {
-            /* Single click: position cursor */
-            state->cursor = click_pos;
-            state->selection_start = click_pos;
-            state->selection_end = click_pos;
-            state->last_click_count = 1;
-            state->last_click_pos = click_pos;
-            state->is_dragging = true;
-        }
-        /* Reset timing for next click detection */
-        state->last_click_time = 0.f;
+        iui_text_buffer_t view = text_view(buffer, len);
+        textfield_select_click(&view, state, click_pos);
     } else if ((ctx->mouse_pressed & IUI_MOUSE_LEFT) && !hovered && has_focus) {
         /* Click outside: lose focus */
         ctx->focused_edit = NULL;
@@ -744,16 +1373,7 @@ bool iui_edit_with_selection(iui_context *ctx,
     if (state->is_dragging && (ctx->mouse_held & IUI_MOUSE_LEFT)) {
         float drag_x = ctx->mouse_pos.x + state->scroll_offset;
         size_t drag_pos = iui_find_cursor_from_x(ctx, buffer, text_x, drag_x);
-        state->cursor = drag_pos;
-
-        /* Update selection range */
-        if (drag_pos < state->last_click_pos) {
-            state->selection_start = drag_pos;
-            state->selection_end = state->last_click_pos;
-        } else {
-            state->selection_start = state->last_click_pos;
-            state->selection_end = drag_pos;
-        }
+        textfield_select_drag(state, drag_pos);
     }
 
     /* End drag on mouse release */
@@ -764,11 +1384,14 @@ bool iui_edit_with_selection(iui_context *ctx,
     /* Handle keyboard input when focused and auto-scroll to keep cursor visible
      */
     if (has_focus) {
-        modified =
-            iui_process_text_input_selection(ctx, buffer, buffer_size, state);
-        /* Reset cursor blink on any key activity */
-        if (ctx->key_pressed != IUI_KEY_NONE || ctx->char_input != 0)
-            ctx->cursor_blink = 0.f;
+        for (int it = 0; iui_text_event_next(ctx, &it);) {
+            if (iui_process_text_input_selection(ctx, buffer, buffer_size,
+                                                 state))
+                modified = true;
+            /* Reset cursor blink on any key activity */
+            if (ctx->key_pressed != IUI_KEY_NONE || ctx->char_input != 0)
+                ctx->cursor_blink = 0.f;
+        }
 
         /* Auto-scroll to keep cursor visible */
         float cursor_x_in_text =
@@ -792,29 +1415,17 @@ bool iui_edit_with_selection(iui_context *ctx,
         .height = edit_rect.height,
     };
 
-    /* Draw selection highlight (MD3: primary @ 40% focused, 20% unfocused) */
+    /* Draw selection highlight */
     float draw_text_x = text_x - state->scroll_offset;
     iui_normalize_selection(state);
     if (state->selection_start != state->selection_end) {
-        float sel_start_x =
+        textfield_draw_selection(
+            ctx,
             draw_text_x + textfield_get_width_to_pos(
-                              ctx, buffer, state->selection_start, false);
-        float sel_end_x =
+                              ctx, buffer, state->selection_start, false),
             draw_text_x + textfield_get_width_to_pos(
-                              ctx, buffer, state->selection_end, false);
-        float visible_start = fmaxf(sel_start_x, text_clip.x);
-        float visible_end = fminf(sel_end_x, text_clip.x + text_clip.width);
-
-        if (visible_end > visible_start) {
-            uint8_t sel_alpha =
-                has_focus ? IUI_SELECTION_ALPHA : (IUI_SELECTION_ALPHA / 2);
-            uint32_t selection_color =
-                iui_state_layer(ctx->colors.primary, sel_alpha);
-            ctx->renderer.draw_box(
-                (iui_rect_t) {visible_start, text_y,
-                              visible_end - visible_start, ctx->font_height},
-                0.f, selection_color, ctx->renderer.user);
-        }
+                              ctx, buffer, state->selection_end, false),
+            text_clip.x, text_clip.width, text_y, has_focus);
     }
 
     /* Draw text (with scroll offset) */
@@ -837,10 +1448,8 @@ bool iui_edit_with_selection(iui_context *ctx,
     iui_newline(ctx);
 
     /* Only clear input if this field consumed it */
-    if (has_focus) {
-        ctx->key_pressed = 0;
-        ctx->char_input = 0;
-    }
+    if (has_focus)
+        iui_text_events_consume(ctx);
 
     return modified;
 }
@@ -966,36 +1575,9 @@ iui_textfield_result iui_textfield_with_selection(
             float click_x = ctx->mouse_pos.x + state->scroll_offset;
             size_t click_pos =
                 iui_find_cursor_from_x(ctx, buffer, text_x_start, click_x);
-
-            /* Double/triple click detection */
-            if (state->last_click_count >= 2 &&
-                fabsf((float) click_pos - (float) state->last_click_pos) < 3) {
-                /* Triple click: select all */
-                state->selection_start = 0;
-                state->selection_end = len;
-                state->cursor = len;
-                state->last_click_count = 0;
-            } else if (state->last_click_count == 1 &&
-                       fabsf((float) click_pos -
-                             (float) state->last_click_pos) < 3) {
-                /* Double click: select word */
-                iui_find_word_boundaries(buffer, click_pos,
-                                         &state->selection_start,
-                                         &state->selection_end);
-                state->cursor = state->selection_end;
-                state->last_click_count = 2;
-            } else {
-                /* Single click */
-                state->cursor = click_pos;
-                state->selection_start = click_pos;
-                state->selection_end = click_pos;
-                state->last_click_count = 1;
-                state->last_click_pos = click_pos;
-                state->is_dragging =
-                    true; /* Allow drag selection in read-only */
-            }
-            /* Reset timing for next click detection */
-            state->last_click_time = 0.f;
+            /* Drag selection stays available in read-only mode */
+            iui_text_buffer_t view = text_view(buffer, len);
+            textfield_select_click(&view, state, click_pos);
         } else if ((ctx->mouse_pressed & IUI_MOUSE_LEFT) && !hovered &&
                    has_focus) {
             ctx->focused_edit = NULL;
@@ -1013,15 +1595,7 @@ iui_textfield_result iui_textfield_with_selection(
         float drag_x = ctx->mouse_pos.x + state->scroll_offset;
         size_t drag_pos =
             iui_find_cursor_from_x(ctx, buffer, text_x_start, drag_x);
-        state->cursor = drag_pos;
-
-        if (drag_pos < state->last_click_pos) {
-            state->selection_start = drag_pos;
-            state->selection_end = state->last_click_pos;
-        } else {
-            state->selection_start = state->last_click_pos;
-            state->selection_end = drag_pos;
-        }
+        textfield_select_drag(state, drag_pos);
     }
 
     if (ctx->mouse_released & IUI_MOUSE_LEFT) {
@@ -1030,15 +1604,17 @@ iui_textfield_result iui_textfield_with_selection(
 
     /* Handle keyboard input when focused (skip if read_only or disabled) */
     if (has_focus && !opts.read_only && !opts.disabled) {
-        /* Handle Enter key (submit) first */
-        if (ctx->key_pressed == IUI_KEY_ENTER)
-            result.submitted = true;
+        for (int it = 0; iui_text_event_next(ctx, &it);) {
+            /* Handle Enter key (submit) first */
+            if (ctx->key_pressed == IUI_KEY_ENTER)
+                result.submitted = true;
 
-        result.value_changed =
-            iui_process_text_input_selection(ctx, buffer, size, state);
+            if (iui_process_text_input_selection(ctx, buffer, size, state))
+                result.value_changed = true;
 
-        if (ctx->key_pressed != IUI_KEY_NONE || ctx->char_input != 0)
-            ctx->cursor_blink = 0.f;
+            if (ctx->key_pressed != IUI_KEY_NONE || ctx->char_input != 0)
+                ctx->cursor_blink = 0.f;
+        }
     }
 
     /* Auto-scroll to keep cursor visible */
@@ -1062,29 +1638,18 @@ iui_textfield_result iui_textfield_with_selection(
     float text_y = edit_rect.y + (edit_rect.height - ctx->font_height) * 0.5f;
     float draw_text_x = text_x_start - state->scroll_offset;
 
-    /* Draw selection highlight (MD3: primary @ 40% focused, 20% unfocused) */
+    /* Draw selection highlight */
     iui_normalize_selection(state);
     if (state->selection_start != state->selection_end) {
-        float sel_start_x =
+        textfield_draw_selection(
+            ctx,
             draw_text_x + textfield_get_width_to_pos(ctx, buffer,
                                                      state->selection_start,
-                                                     opts.password_mode);
-        float sel_end_x = draw_text_x + textfield_get_width_to_pos(
-                                            ctx, buffer, state->selection_end,
-                                            opts.password_mode);
-        float visible_start = fmaxf(sel_start_x, text_x_start);
-        float visible_end = fminf(sel_end_x, text_x_start + text_area_width);
-
-        if (visible_end > visible_start) {
-            uint8_t sel_alpha =
-                has_focus ? IUI_SELECTION_ALPHA : (IUI_SELECTION_ALPHA / 2);
-            uint32_t selection_color =
-                iui_state_layer(ctx->colors.primary, sel_alpha);
-            ctx->renderer.draw_box(
-                (iui_rect_t) {visible_start, text_y,
-                              visible_end - visible_start, ctx->font_height},
-                0.f, selection_color, ctx->renderer.user);
-        }
+                                                     opts.password_mode),
+            draw_text_x + textfield_get_width_to_pos(ctx, buffer,
+                                                     state->selection_end,
+                                                     opts.password_mode),
+            text_x_start, text_area_width, text_y, has_focus);
     }
 
     /* Draw text or placeholder */
@@ -1119,10 +1684,8 @@ iui_textfield_result iui_textfield_with_selection(
 
     iui_newline(ctx);
 
-    if (has_focus && !opts.read_only && !opts.disabled) {
-        ctx->key_pressed = 0;
-        ctx->char_input = 0;
-    }
+    if (has_focus && !opts.read_only && !opts.disabled)
+        iui_text_events_consume(ctx);
 
     /* MD3 runtime validation: track rendered textfield dimensions */
     IUI_MD3_TRACK_TEXTFIELD(edit_rect, ctx->corner);
@@ -1130,6 +1693,250 @@ iui_textfield_result iui_textfield_with_selection(
     return result;
 }
 
+/* Gap-buffer TextField with Selection Support */
+
+/* Code point boundary nearest to @dx, measured from the start of the text */
+static size_t text_buffer_hit(iui_context *ctx,
+                              const iui_text_buffer_t *tb,
+                              bool password_mode,
+                              float dx)
+{
+    size_t len = iui_text_buffer_length(tb), best = 0;
+    float x = 0.f, best_dist = fabsf(dx),
+          mask = iui_get_codepoint_width(ctx, '*');
+    for (size_t p = 0; p < len && x < dx;) {
+        x += password_mode
+                 ? mask
+                 : iui_get_codepoint_width(ctx, text_buffer_decode(tb, p));
+        p = text_buffer_next(tb, p);
+        if (fabsf(dx - x) < best_dist) {
+            best_dist = fabsf(dx - x);
+            best = p;
+        }
+    }
+    return best;
+}
+
+/* Clamp cursor and selection to the text and back onto code points */
+static void text_buffer_clamp_state(const iui_text_buffer_t *tb,
+                                    iui_edit_state *state)
+{
+    size_t len = iui_text_buffer_length(tb);
+    if (state->cursor > len)
+        state->cursor = len;
+    while (state->cursor > 0 && state->cursor < len &&
+           iui_utf8_is_continuation(
+               (unsigned char) text_buffer_at(tb, state->cursor)))
+        state->cursor--;
+    if (state->selection_start > len)
+        state->selection_start = len;
+    if (state->selection_end > len)
+        state->selection_end = len;
+}
+
+/* Erase the selected bytes in one gap adjustment */
+static bool text_buffer_delete_selection(iui_text_buffer_t *tb,
+                                         iui_edit_state *state)
+{
+    iui_normalize_selection(state);
+    if (!iui_has_selection(state))
+        return false;
+    iui_text_buffer_move(tb, state->selection_end);
+    iui_text_buffer_erase(tb, state->selection_end - state->selection_start,
+                          0);
+    state->cursor = state->selection_end = state->selection_start;
+    return true;
+}
+
+/* Gap-buffer counterpart of iui_process_text_input_selection; edits happen
+ * at the gap, which is left at the cursor
+ */
+static bool text_buffer_process_selection(iui_context *ctx,
+                                          iui_text_buffer_t *tb,
+                                          iui_edit_state *state)
+{
+    bool modified = false;
+    bool shift_held = (ctx->modifiers & IUI_MOD_SHIFT) != 0;
+    bool ctrl_held = (ctx->modifiers & IUI_MOD_CTRL) != 0;
+
+    /* Character input - replace selection if active */
+    if (ctx->char_input >= 32) {
+        modified = text_buffer_delete_selection(tb, state);
+        char utf8_buf[4];
+        size_t cp_len = iui_utf8_encode(ctx->char_input, utf8_buf);
+        iui_text_buffer_move(tb, state->cursor);
+        if (iui_text_buffer_insert(tb, utf8_buf, cp_len)) {
+            state->cursor = tb->gap;
+            modified = true;
+        }
+        state->selection_start = state->selection_end = state->cursor;
+    }
+
+    size_t len = iui_text_buffer_length(tb);
+    switch (ctx->key_pressed) {
+    case IUI_KEY_LEFT:
+    case IUI_KEY_RIGHT:
+    case IUI_KEY_HOME:
+    case IUI_KEY_END:
+        textfield_handle_cursor_movement(tb, len, state, shift_held, ctrl_held,
+                                         ctx->key_pressed);
+        break;
+
+    case IUI_KEY_BACKSPACE:
+        if (text_buffer_delete_selection(tb, state)) {
+            modified = true;
+        } else if (state->cursor > 0) {
+            size_t prev_pos = text_buffer_prev(tb, state->cursor);
+            iui_text_buffer_move(tb, state->cursor);
+            iui_text_buffer_erase(tb, state->cursor - prev_pos, 0);
+            state->cursor = prev_pos;
+            modified = true;
+        }
+        state->selection_start = state->selection_end = state->cursor;
+        break;
+
+    case IUI_KEY_DELETE:
+        if (text_buffer_delete_selection(tb, state)) {
+            modified = true;
+        } else if (state->cursor < len) {
+            size_t next_pos = text_buffer_next(tb, state->cursor);
+            iui_text_buffer_move(tb, state->cursor);
+            iui_text_buffer_erase(tb, 0, next_pos - state->cursor);
+            modified = true;
+        }
+        state->selection_start = state->selection_end = state->cursor;
+        break;
+
+    default:
+        break;
+    }
+
+    iui_text_buffer_move(tb, state->cursor);
+    return modified;
+}
+
+iui_textfield_result iui_textfield_buffer_with_selection(
+    iui_context *ctx,
+    iui_text_buffer_t *tb,
+    iui_edit_state *state,
+    const iui_textfield_options *options)
+{
+    iui_textfield_result result = {0};
+
+    if (!ctx->current_window || !tb || !tb->data || tb->capacity == 0 ||
+        !state)
+        return result;
+
+    iui_register_textfield(ctx, tb);
+
+    iui_textfield_options opts = {0};
+    if (options)
+        opts = *options;
+
+    text_buffer_clamp_state(tb, state);
+
+    /* Track time since last click for multi-click detection */
+    state->last_click_time += ctx->delta_time;
+    if (state->last_click_time > IUI_DOUBLE_CLICK_TIME)
+        state->last_click_count = 0;
+
+    /* Read-only fields still take focus so their text can be selected */
+    iui_textfield_options focus_opts = opts;
+    focus_opts.read_only = false;
+    textfield_frame_t f = textfield_frame_begin(ctx, tb, &focus_opts, &result);
+    f.editable = f.has_focus && !opts.read_only && !opts.disabled;
+
+    float trailing_icon_width = (opts.trailing_icon != IUI_TEXTFIELD_ICON_NONE)
+                                    ? (f.icon_size + ctx->padding)
+                                    : 0.f;
+    float text_area_width = f.edit_rect.x + f.edit_rect.width -
+                            ctx->padding - trailing_icon_width - f.text_x;
+
+    /* Clamp scroll offset */
+    float max_scroll =
+        fmaxf(0.f, text_buffer_width_to(ctx, tb, iui_text_buffer_length(tb),
+                                        opts.password_mode) -
+                       text_area_width);
+    if (state->scroll_offset > max_scroll)
+        state->scroll_offset = max_scroll;
+    if (state->scroll_offset < 0.f)
+        state->scroll_offset = 0.f;
+
+    /* Click and drag selection (also in read-only mode) */
+    bool hovered = in_rect(&f.edit_rect, ctx->mouse_pos);
+    if (ctx->mouse_pressed & IUI_MOUSE_LEFT) {
+        if (f.has_focus && hovered && !result.leading_icon_clicked &&
+            !result.trailing_icon_clicked) {
+            float dx = ctx->mouse_pos.x + state->scroll_offset - f.text_x;
+            textfield_select_click(
+                tb, state, text_buffer_hit(ctx, tb, opts.password_mode, dx));
+        } else if (!hovered) {
+            state->is_dragging = false;
+        }
+    }
+    if (state->is_dragging && (ctx->mouse_held & IUI_MOUSE_LEFT)) {
+        float dx = ctx->mouse_pos.x + state->scroll_offset - f.text_x;
+        textfield_select_drag(state,
+                              text_buffer_hit(ctx, tb, opts.password_mode, dx));
+    }
+    if (ctx->mouse_released & IUI_MOUSE_LEFT)
+        state->is_dragging = false;
+
+    if (f.editable) {
+        for (int it = 0; iui_text_event_next(ctx, &it);) {
+            if (ctx->key_pressed == IUI_KEY_ENTER)
+                result.submitted = true;
+            if (text_buffer_process_selection(ctx, tb, state))
+                result.value_changed = true;
+            if (ctx->key_pressed != IUI_KEY_NONE || ctx->char_input != 0)
+                ctx->cursor_blink = 0.f;
+        }
+    }
+
+    /* Auto-scroll to keep cursor visible */
+    float cursor_dx =
+        text_buffer_width_to(ctx, tb, state->cursor, opts.password_mode);
+    if (f.has_focus) {
+        if (cursor_dx < state->scroll_offset)
+            state->scroll_offset = cursor_dx;
+        if (cursor_dx > state->scroll_offset + text_area_width)
+            state->scroll_offset = cursor_dx - text_area_width;
+    }
+
+    textfield_colors_t colors = textfield_frame_draw(ctx, &f, &opts);
+    float draw_text_x = f.text_x - state->scroll_offset;
+
+    iui_normalize_selection(state);
+    if (iui_has_selection(state)) {
+        textfield_draw_selection(
+            ctx,
+            draw_text_x + text_buffer_width_to(ctx, tb, state->selection_start,
+                                               opts.password_mode),
+            draw_text_x + text_buffer_width_to(ctx, tb, state->selection_end,
+                                               opts.password_mode),
+            f.text_x, text_area_width, f.text_y, f.has_focus);
+    }
+
+    if (iui_text_buffer_length(tb) == 0 && opts.placeholder) {
+        iui_internal_draw_text(
+            ctx, f.text_x, f.text_y, opts.placeholder,
+            iui_state_layer(ctx->colors.on_surface, IUI_PLACEHOLDER_ALPHA));
+    } else {
+        text_buffer_draw(
+            ctx, tb, draw_text_x, f.text_y,
+            text_buffer_width_to(ctx, tb, tb->gap, opts.password_mode),
+            opts.password_mode, colors.text);
+    }
+
+    float cursor_x = draw_text_x + cursor_dx;
+    if (textfield_cursor_due(ctx, &f, &opts) && cursor_x >= f.text_x &&
+        cursor_x <= f.text_x + text_area_width)
+        textfield_draw_cursor(ctx, &f, cursor_x);
+
+    textfield_frame_end(ctx, &f);
+    return result;
+}
+
 /* Toggle Widget Helper - shared logic for checkbox and radio */
 
 typedef void (*iui_toggle_draw_fn)(iui_context *ctx,
@@ -32,6 +32,9 @@
 #ifndef IUI_SCROLLBAR_W
 #define IUI_SCROLLBAR_W 8.f /* vertical scrollbar width in pixels */
 #endif
+#ifndef IUI_SCROLL_LAYER_BAND
+#define IUI_SCROLL_LAYER_BAND 64.f /* content rows per layer hash band */
+#endif
 
 /* Performance optimization constants */
 #ifndef IUI_DRAW_CMD_BUFFER_SIZE
@@ -50,6 +53,28 @@
 #define IUI_TEXT_CACHE_DECAY_COUNT 4 /* entries to age per frame */
 #endif
 
+#ifndef IUI_GLYPH_PACK_SLOTS
+#define IUI_GLYPH_PACK_SLOTS 4 /* extended glyph packs per context */
+#endif
+#ifndef IUI_BOX_CACHE_SIZE
+#define IUI_BOX_CACHE_SIZE 8 /* memoized box size resolutions (power of 2) */
+#endif
+#ifndef IUI_MEASURE_SLOTS
+#define IUI_MEASURE_SLOTS 32 /* content measurement records (power of 2) */
+#endif
+#ifndef IUI_MEASURE_DEPTH
+#define IUI_MEASURE_DEPTH 4 /* nested measure scopes */
+#endif
+#ifndef IUI_BLOCK_GRID_DIM
+#define IUI_BLOCK_GRID_DIM 8 /* blocking region index cells per axis */
+#endif
+#ifndef IUI_BLOCK_GRID_SPAN
+#define IUI_BLOCK_GRID_SPAN 4 /* max cells per region; wider ones listed */
+#endif
+#ifndef IUI_PARAGRAPH_MAX_LINES
+#define IUI_PARAGRAPH_MAX_LINES 32 /* lines cached per paragraph */
+#endif
+
 /* Per-frame field tracking constants */
 #ifndef IUI_MAX_TRACKED_TEXTFIELDS
 #define IUI_MAX_TRACKED_TEXTFIELDS 32 /* max text fields per frame */
@@ -57,6 +82,9 @@
 #ifndef IUI_MAX_TRACKED_SLIDERS
 #define IUI_MAX_TRACKED_SLIDERS 32 /* max sliders per frame */
 #endif
+#ifndef IUI_TEXT_INDEX_CAPACITY
+#define IUI_TEXT_INDEX_CAPACITY 256 /* bytes indexed for the focused field */
+#endif
 
 /* Slider state encoding constants (shared by basic.c and core.c).
  * Bit 31 distinguishes drag (0) from animation (1) states.
@@ -103,6 +131,27 @@ static inline uint32_t iui_slider_masked_id(uint32_t slider_id)
 #define IUI_FONT_SIDE_BEARING_EXTRA 0.4f /* additional margin */
 #endif
 
+/* Glyph advance tables: slot 0 is the fallback box glyph, slots 1-95 map to
+ * printable ASCII 0x20-0x7E. A few font sizes are kept resident so the MD3
+ * typography scale does not rebuild a table on every size switch.
+ */
+#define IUI_GLYPH_ADVANCE_COUNT 96
+#ifndef IUI_GLYPH_ADVANCE_SIZES
+#define IUI_GLYPH_ADVANCE_SIZES 4 /* resident font sizes (round-robin) */
+#endif
+
+/* Glyph outline cache: flattened outlines per (glyph, font size) live in a
+ * shared point arena carved from the config buffer (glyph_cache_points),
+ * with one slot per IUI_GLYPH_CACHE_SLOT_POINTS points. When the arena or a
+ * probe window fills up, the whole cache is dropped and refilled lazily.
+ * Without a cache each glyph is flattened into a stack buffer per draw.
+ */
+#define IUI_GLYPH_CACHE_SLOT_POINTS 16    /* arena points per entry slot */
+#define IUI_GLYPH_SCRATCH_POINTS 256      /* uncached glyph outline limit */
+#define IUI_GLYPH_CACHE_PROBE_LEN 8       /* linear probing length */
+#define IUI_GLYPH_CACHE_BREAK INT16_MIN   /* marks the start of a subpath */
+#define IUI_GLYPH_CACHE_FINE_MAX 1024.f   /* largest size stored at 1/16 px */
+
 /* Touch target expansion helpers
  * MD3 requires minimum 48dp touch targets for accessibility.
  * These helpers expand a rect to meet touch target requirements.
@@ -170,6 +219,7 @@ typedef struct {
     float min_width, min_height;
     uint32_t options;
     bool closed;
+    int below, above; /* z-order neighbours (-1 = none) */
 } iui_window;
 
 typedef struct {
@@ -181,13 +231,8 @@ typedef struct {
 } iui_animation;
 
 typedef struct {
-    void *widget;
-    float t;
-} iui_hover;
-
-typedef struct {
-    iui_rect_t stack[IUI_CLIP_STACK_SIZE];
-    int depth;
+    iui_rect_t *stack; /* capacity entries, carved at iui_init */
+    int depth, capacity;
 } iui_clip_state;
 
 /* Blocking region for input layer system */
@@ -204,11 +249,26 @@ typedef struct {
     int z_order;  /* Z-order value (higher = on top) */
 } iui_layer_entry_t;
 
+/* Uniform grid over the previous frame's blocking regions, rebuilt when the
+ * buffers swap. Cell c lists items[cell_start[c] .. cell_start[c + 1]);
+ * regions covering more than IUI_BLOCK_GRID_SPAN cells (screen scrims) go to
+ * the large list, which every query checks.
+ */
+typedef struct {
+    float x, y, cell_w, cell_h; /* grid origin and cell size */
+    uint16_t cell_start[IUI_BLOCK_GRID_DIM * IUI_BLOCK_GRID_DIM + 1];
+    uint16_t *items; /* region indices by cell, SPAN x capacity (arena) */
+    uint16_t *large; /* indices of wide regions, capacity (arena) */
+    int large_count;
+} iui_block_index_t;
+
 /* Input layer state (internal, managed by context) */
 typedef struct {
     /* Double-buffered regions: write to current, read from previous */
-    iui_block_region_t regions[2][IUI_MAX_BLOCKING_REGIONS];
+    iui_block_region_t *regions[2]; /* region_capacity each (arena) */
+    int region_capacity;
     int region_count[2]; /* Count per buffer */
+    iui_block_index_t index; /* over the read buffer */
     int current_buffer;  /* 0 or 1, swapped each frame */
     int next_reg_order;  /* Registration order counter */
 
@@ -278,13 +338,103 @@ typedef struct {
     iui_box_config_t config;
     float origin_x, origin_y;             /* content area origin */
     float content_w, content_h;           /* available content area */
-    float computed[IUI_MAX_BOX_CHILDREN]; /* resolved main-axis sizes */
+    float *computed;                      /* resolved main-axis sizes */
     int child_index;                      /* current child */
     float next_pos;                       /* cursor along main axis */
     float resolved_cross;                 /* cross-axis size used at begin */
     iui_rect_t saved_layout;              /* parent layout to restore */
 } iui_box_entry_t;
 
+/* Memoized box_resolve_sizes() result. The solver output depends only on the
+ * main-axis container size, gap and sizing specs; the hash picks the slot and
+ * a hit compares all of them, so a collision cannot return stale sizes.
+ * Boxes with more than IUI_MAX_BOX_CHILDREN children bypass the cache.
+ */
+typedef struct {
+    uint32_t hash;                            /* input hash (0 = unused slot) */
+    int child_count;                          /* compared on every hit */
+    float container_main, gap;                /* ditto */
+    bool default_sizes;                       /* sizes was NULL (all GROW(1)) */
+    iui_sizing_t sizes[IUI_MAX_BOX_CHILDREN]; /* ditto, when not NULL */
+    float computed[IUI_MAX_BOX_CHILDREN];     /* resolved main-axis sizes */
+} iui_box_cache_entry;
+
+typedef struct {
+    iui_box_cache_entry entries[IUI_BOX_CACHE_SIZE];
+    int hits, misses; /* this frame, reported through iui_get_frame_stats */
+} iui_box_cache_state;
+
+/* Content extent recorded under a caller ID; survives across frames so a
+ * container can size itself before emitting its content.
+ */
+typedef struct {
+    uint32_t id;    /* 0 = unused slot */
+    uint32_t frame; /* frame of the last write, for eviction */
+    float width, height;
+} iui_measure_record;
+
+typedef struct {
+    uint32_t id;   /* record key (0 = measure only) */
+    float start_y; /* layout cursor at iui_measure_begin */
+    float width;   /* widest iui_require_content_width() inside */
+} iui_measure_scope;
+
+typedef struct {
+    iui_measure_record records[IUI_MEASURE_SLOTS];
+    iui_measure_scope scopes[IUI_MEASURE_DEPTH];
+    int depth; /* may exceed IUI_MEASURE_DEPTH; extra scopes are ignored */
+    uint32_t frame;
+    int card_depth;         /* open cards, fixed or auto height */
+    uint32_t card_measured; /* bit per open card: it opened a scope */
+} iui_measure_state;
+
+/* Interactive widget recorded by iui_get_component_state(); the array order
+ * is draw order, so later entries are on top within a layer.
+ */
+typedef struct {
+    uint32_t id;       /* ID stack scope and ordinal (widget_map_id) */
+    int z_order;       /* input layer z_order at registration */
+    iui_rect_t bounds; /* visible part: bounds within the clip rect */
+} iui_widget_entry;
+
+/* Hover resolved once per frame from the previous frame's widget map. IDs
+ * are keyed on the ID stack rather than on bounds, so a widget that moves
+ * (scrolling, animation) keeps its ID and identical rects never collide.
+ * With no recorded widget under the pointer, or after an overflowing frame,
+ * hot_id is 0 and widgets fall back to a point-in-rect test.
+ */
+typedef struct {
+    iui_widget_entry *entries; /* arena */
+    int count, capacity;
+    bool overflow;   /* entries dropped this frame */
+    uint32_t hot_id; /* topmost widget under the pointer (0 = none) */
+    uint32_t last_id; /* ID of the latest iui_get_component_state() */
+} iui_widget_map;
+
+/* Per-widget state, keyed by widget ID (iui_widget_id). Lets any number of
+ * widgets run their own press and hover transitions at once.
+ */
+typedef struct {
+    uint32_t id;       /* 0 = empty slot */
+    uint32_t frame;    /* generation of the last touch */
+    iui_rect_t bounds; /* bounds at the last touch */
+    float anim_t;      /* press transition progress, 0..1 (1 = settled) */
+    float hover_t;     /* hover state-layer progress, 0..1 */
+} iui_widget_state;
+
+/* Open-addressed (linear probing) table of iui_widget_state carved from the
+ * arena. Records not touched during a frame are evicted by iui_end_frame()
+ * with backward-shift deletion, so probe chains never hold tombstones. A
+ * full table makes room by evicting its least recently touched record.
+ */
+typedef struct {
+    iui_widget_state *slots;
+    uint32_t mask;      /* slot count - 1 */
+    int capacity;       /* live record limit, at most 3/4 of the slots */
+    int count, touched; /* live records, and those touched this frame */
+    uint32_t frame;     /* current generation */
+} iui_widget_state_table;
+
 /* Performance optimization structures */
 
 /* Draw command types for batching */
@@ -356,18 +506,157 @@ typedef struct {
     bool enabled;
 } iui_text_cache_state;
 
+/* Glyph cache key of a pack glyph; built-in glyphs use their advance index */
+#define IUI_GLYPH_PACK_KEY(cp) ((uint32_t) IUI_GLYPH_ADVANCE_COUNT + (cp))
+
+/* Attached extended glyph pack (see iui_glyph_pack_attach). Points into the
+ * caller's mapping; nothing is copied or decoded up front.
+ */
+typedef struct {
+    const uint8_t *index;      /* glyph_count x {u32 codepoint, u32 offset} */
+    const signed char *glyphs; /* bytecode area */
+    uint32_t count, data_size;
+} iui_glyph_pack;
+
+/* Memoized line breaks of one paragraph. Lines are byte ranges into the
+ * caller's text; the entry is reused while (hash, len, width, font_height,
+ * max_lines, ellipsis) all match, so layout of an unchanged paragraph is a
+ * lookup rather than a re-measure.
+ */
+typedef struct {
+    uint32_t hash;     /* text hash (0 = unused slot) */
+    uint32_t len;      /* text length in bytes */
+    float width;       /* wrap width */
+    float font_height; /* font size the breaks were measured with */
+    uint32_t stamp;    /* last use, for LRU eviction */
+    int16_t max_lines; /* requested limit (0 = unlimited) */
+    bool ellipsis;     /* requested "..." on cut-off text */
+    bool elided;       /* last line ends with "..." */
+    uint16_t line_count;
+    uint16_t rest; /* offset of the first uncached line (0 = none) */
+    uint16_t line_start[IUI_PARAGRAPH_MAX_LINES];
+    uint16_t line_len[IUI_PARAGRAPH_MAX_LINES];
+    float line_width[IUI_PARAGRAPH_MAX_LINES];
+} iui_paragraph_entry;
+
+typedef struct {
+    iui_paragraph_entry *entries; /* capacity entries (arena) */
+    int capacity;
+    uint32_t clock;               /* LRU time stamp source */
+    int hits, misses;             /* statistics */
+} iui_paragraph_cache_state;
+
+/* Per-font-size advance table for the built-in vector font. Each entry holds
+ * the full pen advance (glyph width plus both side bearings), so measuring a
+ * string is a plain table sum.
+ */
+typedef struct {
+    float font_height; /* size this table was built for (0 = unused) */
+    float advance[IUI_GLYPH_ADVANCE_COUNT];
+} iui_glyph_advance_table;
+
+typedef struct {
+    iui_glyph_advance_table tables[IUI_GLYPH_ADVANCE_SIZES];
+    int current; /* table matching ctx->font_height at last lookup */
+    int next;    /* round-robin slot for the next rebuild */
+} iui_glyph_advance_state;
+
+/* Flattened outline point, relative to the glyph origin in fixed point */
+typedef struct {
+    int16_t x, y;
+} iui_glyph_point;
+
+typedef struct {
+    float font_height; /* 0 = empty slot */
+    uint16_t start;    /* first point in the arena */
+    uint16_t count;    /* points including subpath markers */
+    uint32_t glyph;    /* advance table index, or IUI_GLYPH_PACK_KEY(cp) */
+} iui_glyph_cache_entry;
+
+typedef struct {
+    iui_glyph_cache_entry *entries; /* arena; NULL when disabled */
+    iui_glyph_point *points;        /* arena */
+    uint32_t mask;                  /* entry slots - 1 */
+    int capacity;                   /* arena points */
+    int used;                       /* arena points in use */
+    int hits, misses;               /* statistics */
+} iui_glyph_cache_state;
+
+/* Map a byte to its advance table slot (box glyph for non-printables) */
+static inline int iui_glyph_advance_index(unsigned char c)
+{
+    return (c < 32 || c > 126) ? 0 : (int) c - 31;
+}
+
+/* Prefix-width index for the focused text field. x[i] is the pen offset of
+ * byte position i (continuation bytes repeat the offset of their code point),
+ * so cursor, selection and click-to-cursor placement become table lookups.
+ * The widget's insert and delete paths patch it in place, re-measuring only
+ * the inserted code points; a focus, font or length change from elsewhere
+ * rebuilds it. Same-length edits made outside the widget are not seen.
+ */
+typedef struct {
+    const void *owner; /* buffer this index describes (NULL = unused) */
+    float font_height; /* font size the widths were measured at */
+    size_t len;        /* indexed length in bytes */
+    float x[IUI_TEXT_INDEX_CAPACITY + 1];
+} iui_text_index;
+
 /* Per-frame field ID tracking - prevents stale state for conditionally hidden
  * widgets. Text fields and sliders register themselves each frame. State is
  * cleared for fields not seen during the current frame.
+ *
+ * Both sets are open-addressed tables in the arena. A slot is live only when
+ * its stamp equals frame_number, so bumping the counter empties them in
+ * O(1). Nothing is removed mid-frame, so probes stop at the first slot not
+ * stamped this frame. A set that fills up marks the frame as overflowed, and
+ * its stale-state cleanup is skipped since a live field may be missing.
  */
 typedef struct {
-    void *textfield_ids[IUI_MAX_TRACKED_TEXTFIELDS]; /* buffer pointers */
-    uint32_t slider_ids[IUI_MAX_TRACKED_SLIDERS];    /* slider hashes */
+    void **textfield_ids;       /* buffer pointers */
+    uint32_t *textfield_frames; /* stamp per textfield slot */
+    uint32_t *slider_ids;       /* slider hashes */
+    uint32_t *slider_frames;    /* stamp per slider slot */
+    uint32_t textfield_mask, slider_mask; /* slot counts - 1 */
     int textfield_count;   /* fields seen this frame */
     int slider_count;      /* sliders seen this frame */
+    bool textfield_overflow, slider_overflow; /* registrations dropped */
     uint32_t frame_number; /* current frame counter */
+    iui_text_index text_index; /* widths for the focused field */
 } iui_field_tracking;
 
+/* Per-frame input event queue (event.c). Filled between frames and emptied
+ * by iui_end_frame(), so a flat array carved from the arena is enough.
+ */
+typedef struct {
+    iui_input_event *items;
+    int capacity, count;
+    int text_count;   /* key/char events not yet consumed by a text field */
+    uint32_t time_ms; /* timestamp of the latest pushed event */
+    bool replaying;   /* iui_text_event_next() has swapped in modifiers */
+    uint8_t live_modifiers; /* ctx->modifiers to restore after replay */
+} iui_event_queue;
+
+/* Enclosing scroll region, saved while a nested one is open. The stack is
+ * carved from the arena (max_scroll_depth entries).
+ */
+typedef struct {
+    iui_scroll_state *state;
+    iui_rect_t viewport;
+    float start_x, start_y, start_width;
+    float virtual_h;
+} iui_scroll_frame;
+
+/* Wheel routing for one axis: the innermost hovered region that could
+ * scroll along it last frame receives the deltas while the mouse stays in
+ * its viewport; next collects this frame's candidate.
+ */
+typedef struct {
+    iui_scroll_state *target, *next;
+    iui_rect_t view, next_view;
+    int next_depth;
+} iui_scroll_wheel;
+
 /* Full iui_context definition
  *
  * Layout optimized for cache locality based on access frequency analysis.
@@ -387,6 +676,7 @@ struct iui_context {
     iui_vec2 mouse_pos;
     int key_pressed, char_input;
     uint8_t mouse_pressed, mouse_held, mouse_released, modifiers;
+    iui_event_queue events;
 
     /* WARM PATH - Modal and Input Layer */
     iui_modal_state modal;
@@ -396,7 +686,7 @@ struct iui_context {
 
     /* WARM PATH - Animation and Interaction */
     iui_animation animation;
-    iui_hover hover;
+    iui_widget_state_table widget_states;
     void *dragging_object;
     iui_vec2 dragging_offset;
 
@@ -412,11 +702,16 @@ struct iui_context {
     /* WARM PATH - Focus System (counters only, arrays moved to COLD) */
     uint32_t focused_widget_id;
     int focus_count, focus_index, focus_navigation_direction;
+    int focus_move_dir; /* pending iui_focus_dir_t, -1 = Tab order */
 
     /* COOL PATH - Layout Systems */
     iui_grid_state grid;
-    iui_box_entry_t box_stack[IUI_MAX_BOX_DEPTH];
-    int box_depth; /* 0 = no active box */
+    iui_box_entry_t *box_stack; /* box_capacity entries (arena) */
+    bool *box_frozen;           /* solver scratch, box_children entries */
+    int box_depth;              /* 0 = no active box */
+    int box_capacity, box_children;
+    iui_box_cache_state box_cache;
+    iui_measure_state measure;
     float
         window_content_min_width; /* Max content width requirement this frame */
 
@@ -453,6 +748,11 @@ struct iui_context {
     float scroll_content_start_x, scroll_content_start_y,
         scroll_content_start_width;
     float scroll_wheel_dx, scroll_wheel_dy, scroll_drag_offset;
+    float scroll_virtual_h; /* content height claimed by a virtual list */
+    iui_scroll_layer *scroll_layer; /* cached layer of the open region */
+    iui_scroll_frame *scroll_stack; /* enclosing regions (arena) */
+    int scroll_depth, scroll_capacity;
+    iui_scroll_wheel scroll_wheel[2]; /* x, y */
 
     /* COLD PATH - Typography and Token Systems */
     const iui_vector_t *vector;
@@ -460,6 +760,8 @@ struct iui_context {
     iui_shape_tokens shapes;
     iui_spacing_tokens spacing;
     float pen_width, font_ascent_px, font_descent_px;
+    iui_glyph_pack glyph_packs[IUI_GLYPH_PACK_SLOTS];
+    int glyph_pack_count;
 
     /* COLD PATH - Accessibility */
     iui_a11y_callbacks a11y_callbacks;
@@ -472,25 +774,36 @@ struct iui_context {
     iui_clipboard_t clipboard;
 
     /* COLD PATH - Window Management */
-    iui_window windows[IUI_MAX_WINDOWS];
+    iui_window *windows;   /* window_capacity slots, in creation order */
+    uint16_t *window_hash; /* by id: slot index + 1 (0 = empty) */
+    uint32_t window_hash_mask;
+    uint32_t num_windows, window_capacity;
+    int window_bottom, window_top; /* z-order list ends (-1 = no windows) */
+    uint32_t window_hit_id;        /* topmost window under a press (0 = none) */
     iui_window *resizing_window;
-    uint32_t num_windows;
 
-    /* COLD PATH - Large Arrays (focus navigation, ~1.5KB) */
-    uint32_t focus_order[IUI_MAX_FOCUSABLE_WIDGETS];
-    iui_rect_t focus_rects[IUI_MAX_FOCUSABLE_WIDGETS];
-    float focus_corners[IUI_MAX_FOCUSABLE_WIDGETS];
+    /* COLD PATH - Focus navigation, focus_capacity entries each (arena) */
+    uint32_t *focus_order;
+    iui_rect_t *focus_rects;
+    float *focus_corners;
+    uint16_t *focus_sorted; /* iui_focus_move() scratch: indices by center */
+    int focus_capacity;
 
     /* COLD PATH - ID Stack and String Buffer */
-    uint32_t id_stack[IUI_ID_STACK_SIZE];
-    int id_stack_index;
+    uint32_t *id_stack; /* id_stack_capacity entries (arena) */
+    uint32_t *id_seq;   /* widget ordinals per ID stack level (arena) */
+    int id_stack_index, id_stack_capacity;
     char string_buffer[IUI_STRING_BUFFER_SIZE];
 
     /* PERFORMANCE SYSTEMS - Optimization Caches */
     iui_dirty_state dirty;
     iui_text_cache_state text_cache;
+    iui_paragraph_cache_state paragraph_cache;
+    iui_glyph_advance_state glyph_advance;
+    iui_glyph_cache_state glyph_cache;
     iui_draw_batch batch;
     iui_field_tracking field_tracking;
+    iui_widget_map widget_map;
 };
 
 /* Inline helper functions */
@@ -749,6 +1062,21 @@ static inline size_t iui_utf8_prev(const char *buffer, size_t pos)
     return pos;
 }
 
+/* Drop a code point left incomplete at the end of buffer[0, len) by a
+ * byte-limited copy, and NUL-terminate. Returns the new length.
+ */
+static inline size_t iui_utf8_trim_partial(char *buffer, size_t len)
+{
+    if (len > 0) {
+        size_t start = iui_utf8_prev(buffer, len);
+        if (start + iui_utf8_codepoint_len((unsigned char) buffer[start]) >
+            len)
+            len = start;
+    }
+    buffer[len] = '\0';
+    return len;
+}
+
 /* Decode a UTF-8 code point at position with bounds checking.
  * Returns Unicode code point, or U+FFFD for invalid/truncated sequences. */
 static inline uint32_t iui_utf8_decode(const char *buffer,
@@ -780,6 +1108,32 @@ static inline uint32_t iui_utf8_decode(const char *buffer,
     return 0xFFFD; /* Invalid lead byte */
 }
 
+/* End of the pure-ASCII run starting at pos. Tests 16, then 8 bytes at a time
+ * for a set high bit before falling back to single bytes, so ASCII text
+ * skips per-byte UTF-8 decoding.
+ */
+static inline size_t iui_utf8_ascii_run(const char *buffer,
+                                        size_t pos,
+                                        size_t len)
+{
+    const uint64_t high = 0x8080808080808080ull;
+    uint64_t a, b;
+    for (; pos + 16 <= len; pos += 16) {
+        memcpy(&a, buffer + pos, 8);
+        memcpy(&b, buffer + pos + 8, 8);
+        if ((a | b) & high)
+            break;
+    }
+    if (pos + 8 <= len) {
+        memcpy(&a, buffer + pos, 8);
+        if (!(a & high))
+            pos += 8;
+    }
+    while (pos < len && !((unsigned char) buffer[pos] & 0x80))
+        pos++;
+    return pos;
+}
+
 /* Check if a Unicode code point is a word character (letters, digits, _).
  * Handles basic Latin, extended Latin, and common Unicode letter ranges. */
 static inline bool iui_utf8_is_word_char(uint32_t cp)
@@ -1011,6 +1365,46 @@ void iui_compute_vector_metrics(float font_height,
 float iui_vector_pen_for_height(float font_height);
 float iui_codepoint_width_vec(uint32_t cp, float font_height);
 
+/* Glyph lookup across the built-in font and attached packs (font.c).
+ * Codepoints found nowhere map to the box glyph. If @end is not NULL it
+ * receives the end of the pack data holding a pack glyph, or NULL for the
+ * trusted built-in font.
+ */
+const signed char *iui_glyph_lookup(const iui_context *ctx,
+                                    uint32_t cp,
+                                    const signed char **end);
+/* Advance of any glyph at ctx->font_height (core.c); for glyphs outside the
+ * ASCII advance tables.
+ */
+float iui_glyph_advance_of(const iui_context *ctx, const signed char *g);
+
+/* Glyph advance tables (implemented in core.c). iui_glyph_advances returns the
+ * table for ctx->font_height, building it on first use of a new size.
+ */
+void iui_glyph_advance_init(iui_context *ctx);
+const float *iui_glyph_advances(iui_context *ctx);
+/* UTF-8 string width from the advance table; non-ASCII codepoints resolve
+ * through attached glyph packs.
+ */
+float iui_text_width_adv(iui_context *ctx, const char *text);
+
+/* Glyph outline cache (implemented in core.c) */
+void iui_glyph_cache_init(iui_context *ctx);
+
+#ifdef CONFIG_FEATURE_FONT_ATLAS
+/* Baked font atlas (implemented in font.c from font-atlas-gen.inc).
+ * iui_font_atlas_find returns the baked size index for font_height or -1.
+ * iui_font_atlas_glyph fills the mask of advance-table glyph gi and its offset
+ * from the glyph origin; false means the glyph has no ink (e.g. space).
+ */
+int iui_font_atlas_find(float font_height);
+bool iui_font_atlas_glyph(int size,
+                          int gi,
+                          iui_glyph_mask_t *mask,
+                          int *dx,
+                          int *dy);
+#endif /* CONFIG_FEATURE_FONT_ATLAS */
+
 /* Theme globals (defined in iui_core.c) */
 extern const iui_theme_t g_theme_light;
 extern const iui_theme_t g_theme_dark;
@@ -1076,6 +1470,17 @@ void iui_draw_arc_soft(iui_context *ctx,
 /* Frame start: clear per-frame input state */
 void iui_input_frame_begin(iui_context *ctx);
 
+/* Replays the queued key/char events one at a time through key_pressed,
+ * char_input and the modifiers recorded with each event; @it starts at 0.
+ * The live modifiers return when the replay ends or the input is consumed.
+ * Without queued events (fields written directly) it yields the current
+ * one-slot state once.
+ */
+bool iui_text_event_next(iui_context *ctx, int *it);
+
+/* Marks this frame's key and char input as handled by a text field */
+void iui_text_events_consume(iui_context *ctx);
+
 /* Input layer system functions (core.c) */
 
 /* Frame start: swap double buffers and reset registration counter */
@@ -1143,6 +1548,27 @@ bool iui_dirty_is_enabled(const iui_context *ctx);
 void iui_dirty_clear(iui_context *ctx);
 bool iui_dirty_get_region(const iui_context *ctx, int index, iui_rect_t *out);
 
+/* Box size resolution cache (layout.c) */
+void iui_box_cache_init(iui_context *ctx);
+
+/* Per-frame interactive widget map (draw.c) */
+void iui_widget_map_frame_begin(iui_context *ctx);
+uint32_t iui_next_scope_id(iui_context *ctx);
+
+/* Per-widget state table (draw.c). touch() finds or creates the record for
+ * @id and keeps it alive through this frame; NULL when @id is 0. The record
+ * is valid until the next touch.
+ */
+iui_widget_state *iui_widget_state_touch(iui_context *ctx,
+                                         uint32_t id,
+                                         iui_rect_t bounds);
+void iui_widget_state_frame_end(iui_context *ctx);
+
+/* Content measurement records (layout.c) */
+void iui_measure_init(iui_context *ctx);
+void iui_measure_card_begin(iui_context *ctx, uint32_t id);
+void iui_measure_card_end(iui_context *ctx);
+
 /* Text width caching - internal functions (draw.c)
  * Note: iui_text_cache_enable/clear/stats are public, declared in iui.h
  */
@@ -1152,6 +1578,9 @@ bool iui_text_cache_get(iui_context *ctx, const char *text, float *width);
 void iui_text_cache_put(iui_context *ctx, const char *text, float width);
 void iui_text_cache_frame_end(iui_context *ctx);
 
+/* Paragraph line-break cache (draw.c) */
+void iui_paragraph_cache_init(iui_context *ctx);
+
 /* Date/time, Dialog, and Internal widget implementations */
 
 /* Macro for MD3 typography functions */
@@ -95,7 +95,8 @@ static void box_resolve_sizes(float container_main,
                               int count,
                               const iui_sizing_t *sizes,
                               float gap,
-                              float *out)
+                              float *out,
+                              bool *frozen)
 {
     float total_gaps = gap * (float) (count > 1 ? count - 1 : 0);
     float available = fmaxf(0.f, container_main - total_gaps);
@@ -138,7 +139,8 @@ static void box_resolve_sizes(float container_main,
      * stays frozen across iterations (like CSS flexbox freeze semantics).
      * Iterate until no new clamping occurs.
      */
-    bool frozen[IUI_MAX_BOX_CHILDREN] = {false};
+    for (int i = 0; i < count; i++)
+        frozen[i] = false;
     for (int iter = 0; iter < count; iter++) {
         float surplus = 0.f; /* space freed by max-clamped children */
         float deficit = 0.f; /* extra space consumed by min-clamped children */
@@ -206,6 +208,191 @@ static void box_resolve_sizes(float container_main,
     }
 }
 
+/* Box size resolution cache */
+
+void iui_box_cache_init(iui_context *ctx)
+{
+    if (!ctx)
+        return;
+    memset(&ctx->box_cache, 0, sizeof(ctx->box_cache));
+}
+
+/* Resolve through the direct-mapped cache. Dashboards re-emit the same
+ * boxes every frame, so the clamping passes only run when a container was
+ * resized or its sizing specs changed.
+ */
+static void box_resolve_cached(iui_context *ctx,
+                               float container_main,
+                               int count,
+                               const iui_sizing_t *sizes,
+                               float gap,
+                               float *out)
+{
+    if (count > IUI_MAX_BOX_CHILDREN) { /* wider than a cache entry */
+        box_resolve_sizes(container_main, count, sizes, gap, out,
+                          ctx->box_frozen);
+        ctx->box_cache.misses++;
+        return;
+    }
+
+    uint32_t hash = 0x811c9dc5;
+    float key[2] = {container_main, gap};
+    hash = (hash ^ iui_hash(key, sizeof(key))) * 0x01000193;
+    hash = (hash ^ (uint32_t) count) * 0x01000193;
+    if (sizes) /* NULL (all GROW(1)) keeps the bare prefix hash */
+        hash ^= iui_hash(sizes, sizeof(*sizes) * (size_t) count);
+    if (hash == 0)
+        hash = 1;
+
+    iui_box_cache_entry *e =
+        &ctx->box_cache.entries[hash & (IUI_BOX_CACHE_SIZE - 1)];
+    size_t sizes_bytes = sizeof(*sizes) * (size_t) count;
+    if (e->hash == hash && e->child_count == count &&
+        e->container_main == container_main && e->gap == gap &&
+        e->default_sizes == !sizes &&
+        (!sizes || !memcmp(e->sizes, sizes, sizes_bytes))) {
+        memcpy(out, e->computed, sizeof(float) * (size_t) count);
+        ctx->box_cache.hits++;
+        return;
+    }
+
+    box_resolve_sizes(container_main, count, sizes, gap, out, ctx->box_frozen);
+    e->hash = hash, e->child_count = count;
+    e->container_main = container_main, e->gap = gap;
+    e->default_sizes = !sizes;
+    if (sizes)
+        memcpy(e->sizes, sizes, sizes_bytes);
+    memcpy(e->computed, out, sizeof(float) * (size_t) count);
+    ctx->box_cache.misses++;
+}
+
+void iui_get_frame_stats(const iui_context *ctx, iui_frame_stats *stats)
+{
+    if (!ctx || !stats)
+        return;
+    stats->box_cache_hits = ctx->box_cache.hits;
+    stats->box_cache_misses = ctx->box_cache.misses;
+}
+
+/* Content measurement records */
+
+void iui_measure_init(iui_context *ctx)
+{
+    if (!ctx)
+        return;
+    memset(&ctx->measure, 0, sizeof(ctx->measure));
+}
+
+#define IUI_MEASURE_PROBE 4 /* slots probed per lookup */
+
+static const iui_measure_record *measure_find(const iui_measure_state *m,
+                                              uint32_t id)
+{
+    for (uint32_t i = 0; i < IUI_MEASURE_PROBE; i++) {
+        const iui_measure_record *r =
+            &m->records[(id + i) & (IUI_MEASURE_SLOTS - 1)];
+        if (r->id == id)
+            return r;
+    }
+    return NULL;
+}
+
+/* Slot for a new record: an empty probe slot, else the least recently
+ * written one
+ */
+static iui_measure_record *measure_slot(iui_measure_state *m, uint32_t id)
+{
+    iui_measure_record *victim = NULL;
+    for (uint32_t i = 0; i < IUI_MEASURE_PROBE; i++) {
+        iui_measure_record *r = &m->records[(id + i) & (IUI_MEASURE_SLOTS - 1)];
+        if (r->id == id || r->id == 0)
+            return r;
+        if (!victim || m->frame - r->frame > m->frame - victim->frame)
+            victim = r;
+    }
+    return victim;
+}
+
+void iui_measure_begin(iui_context *ctx, uint32_t id)
+{
+    iui_measure_state *m = &ctx->measure;
+    if (m->depth < IUI_MEASURE_DEPTH) {
+        m->scopes[m->depth] = (iui_measure_scope) {
+            .id = id,
+            .start_y = ctx->layout.y,
+        };
+    }
+    m->depth++;
+}
+
+bool iui_measure_end(iui_context *ctx)
+{
+    iui_measure_state *m = &ctx->measure;
+    if (m->depth <= 0)
+        return false;
+    if (--m->depth >= IUI_MEASURE_DEPTH)
+        return false;
+
+    const iui_measure_scope *s = &m->scopes[m->depth];
+    float width = s->width;
+    float height = fmaxf(0.f, ctx->layout.y - s->start_y);
+
+    /* Content width also bounds the enclosing scope */
+    if (m->depth > 0 && width > m->scopes[m->depth - 1].width)
+        m->scopes[m->depth - 1].width = width;
+
+    if (s->id == 0)
+        return false;
+    iui_measure_record *r = measure_slot(m, s->id);
+    bool changed =
+        r->id != s->id || r->width != width || r->height != height;
+    *r = (iui_measure_record) {s->id, m->frame, width, height};
+    return changed;
+}
+
+bool iui_measured_size(const iui_context *ctx,
+                       uint32_t id,
+                       float *width,
+                       float *height)
+{
+    if (!ctx || id == 0)
+        return false;
+    const iui_measure_record *r = measure_find(&ctx->measure, id);
+    if (!r)
+        return false;
+    if (width)
+        *width = r->width;
+    if (height)
+        *height = r->height;
+    return true;
+}
+
+/* Every card is tracked, so iui_card_end closes a measure scope only if
+ * its own iui_card_begin opened one (@id != 0). Cards nested past 32 levels
+ * have no tracking bit and are not measured.
+ */
+void iui_measure_card_begin(iui_context *ctx, uint32_t id)
+{
+    iui_measure_state *m = &ctx->measure;
+    int card = m->card_depth++;
+    if (id == 0 || card >= 32)
+        return;
+    m->card_measured |= 1u << card;
+    iui_measure_begin(ctx, id);
+}
+
+void iui_measure_card_end(iui_context *ctx)
+{
+    iui_measure_state *m = &ctx->measure;
+    if (m->card_depth <= 0)
+        return;
+    int card = --m->card_depth;
+    if (card < 32 && (m->card_measured >> card) & 1u) {
+        m->card_measured &= ~(1u << card);
+        iui_measure_end(ctx);
+    }
+}
+
 /* MD3 spacing tokens */
 
 float iui_spacing_snap(float value)
@@ -219,9 +406,9 @@ iui_rect_t iui_box_begin(iui_context *ctx, const iui_box_config_t *config)
 {
     iui_rect_t empty = {0};
     if (!ctx->current_window || !config || config->child_count <= 0 ||
-        config->child_count > IUI_MAX_BOX_CHILDREN)
+        config->child_count > ctx->box_children)
         return empty;
-    if (ctx->box_depth >= IUI_MAX_BOX_DEPTH)
+    if (ctx->box_depth >= ctx->box_capacity)
         return empty;
 
     iui_box_entry_t *e = &ctx->box_stack[ctx->box_depth++];
@@ -271,8 +458,8 @@ iui_rect_t iui_box_begin(iui_context *ctx, const iui_box_config_t *config)
         (config->direction == IUI_DIR_COLUMN) ? e->content_h : e->content_w;
 
     /* Resolve child sizes */
-    box_resolve_sizes(container_main, config->child_count, config->sizes, gap,
-                      e->computed);
+    box_resolve_cached(ctx, container_main, config->child_count, config->sizes,
+                       gap, e->computed);
 
     /* Report required width for auto-sizing windows (row direction).
      * Sum guaranteed minimum widths: FIXED values plus min constraints
@@ -461,6 +648,70 @@ float iui_layout_gutter(iui_size_class_t sc)
 
 /* Frame and Window Management */
 
+/* Window table
+ * Windows never move once created, so pointers stay valid; lookup goes
+ * through an open-addressed hash of the name hash and z-order is a doubly
+ * linked list threaded through the slots (top = drawn last, hit first).
+ */
+
+static iui_window *window_find(iui_context *ctx, uint32_t id)
+{
+    for (uint32_t h = id;; h++) {
+        uint16_t slot = ctx->window_hash[h & ctx->window_hash_mask];
+        if (slot == 0)
+            return NULL;
+        if (ctx->windows[slot - 1].id == id)
+            return &ctx->windows[slot - 1];
+    }
+}
+
+/* Claim the next free slot for @id; caller checks capacity */
+static iui_window *window_insert(iui_context *ctx, uint32_t id)
+{
+    uint32_t idx = ctx->num_windows++;
+    uint32_t h = id;
+    while (ctx->window_hash[h & ctx->window_hash_mask])
+        h++;
+    ctx->window_hash[h & ctx->window_hash_mask] = (uint16_t) (idx + 1);
+    return &ctx->windows[idx];
+}
+
+static void window_raise(iui_context *ctx, iui_window *w)
+{
+    int idx = (int) (w - ctx->windows);
+    if (ctx->window_top == idx)
+        return;
+
+    /* Unlink (a fresh window has no neighbours and is not the bottom) */
+    if (w->below >= 0)
+        ctx->windows[w->below].above = w->above;
+    else if (ctx->window_bottom == idx)
+        ctx->window_bottom = w->above;
+    if (w->above >= 0)
+        ctx->windows[w->above].below = w->below;
+
+    w->below = ctx->window_top, w->above = -1;
+    if (ctx->window_top >= 0)
+        ctx->windows[ctx->window_top].above = idx;
+    else
+        ctx->window_bottom = idx;
+    ctx->window_top = idx;
+}
+
+/* Topmost open window containing @pos; walks down from the top and stops at
+ * the first hit, once per press rather than once per window
+ */
+static uint32_t window_hit(const iui_context *ctx, iui_vec2 pos)
+{
+    for (int i = ctx->window_top; i >= 0; i = ctx->windows[i].below) {
+        const iui_window *w = &ctx->windows[i];
+        iui_rect_t r = {w->pos.x, w->pos.y, w->width, w->height};
+        if (!w->closed && in_rect(&r, pos))
+            return w->id;
+    }
+    return 0;
+}
+
 void iui_begin_frame(iui_context *ctx, float delta_time)
 {
     ctx->current_window = NULL;
@@ -468,7 +719,6 @@ void iui_begin_frame(iui_context *ctx, float delta_time)
     ctx->delta_time = delta_time;
     ctx->animation.t =
         fminf(1.f, ctx->animation.t + delta_time / IUI_DURATION_SHORT_4);
-    ctx->hover.t = fminf(1.f, ctx->hover.t + delta_time / IUI_DURATION_SHORT_2);
     ctx->cursor_blink += delta_time;
     if (ctx->cursor_blink > 1.0f)
         ctx->cursor_blink -= 1.0f;
@@ -483,6 +733,9 @@ void iui_begin_frame(iui_context *ctx, float delta_time)
     /* Per-frame field tracking: reset registration arrays */
     iui_field_tracking_frame_begin(ctx);
 
+    /* Hover: resolve the topmost widget of last frame's map once */
+    iui_widget_map_frame_begin(ctx);
+
     /* Only reset clicked_inside when no mouse buttons are held.
      * This preserves click origin tracking across frames during drag
      * operations.
@@ -506,8 +759,19 @@ void iui_begin_frame(iui_context *ctx, float delta_time)
      * iui_scroll_begin() during the frame. Reset happens in iui_end_frame().
      */
 
+    /* Resolve which window a press lands on before any window runs */
+    ctx->window_hit_id = (ctx->mouse_pressed & IUI_MOUSE_LEFT)
+                             ? window_hit(ctx, ctx->mouse_pos)
+                             : 0;
+
     /* Reset box layout state for new frame */
     ctx->box_depth = 0;
+    ctx->box_cache.hits = 0, ctx->box_cache.misses = 0;
+
+    /* Measure scopes never span frames */
+    ctx->measure.depth = 0;
+    ctx->measure.card_depth = 0, ctx->measure.card_measured = 0;
+    ctx->measure.frame++;
 
     /* Reset batch command buffer for new frame */
     ctx->batch.count = 0;
@@ -528,17 +792,15 @@ bool iui_begin_window(iui_context *ctx,
     uint32_t id = iui_hash_str(name);
 
     /* already created? */
-    for (uint32_t i = 0; i < ctx->num_windows; ++i)
-        if (ctx->windows[i].id == id)
-            ctx->current_window = &ctx->windows[i];
+    ctx->current_window = window_find(ctx, id);
 
     /* not found, create one */
     if (!ctx->current_window) {
         /* Guard: window limit reached */
-        if (ctx->num_windows >= IUI_MAX_WINDOWS)
+        if (ctx->num_windows >= ctx->window_capacity)
             return false;
 
-        ctx->current_window = &ctx->windows[ctx->num_windows++];
+        ctx->current_window = window_insert(ctx, id);
         *ctx->current_window = (iui_window) {
             .name = name,
             .id = id,
@@ -549,9 +811,15 @@ bool iui_begin_window(iui_context *ctx,
             .height = height,
             .options = options,
             .closed = false,
+            .below = -1,
+            .above = -1,
         };
+        window_raise(ctx, ctx->current_window);
     }
 
+    /* Widget map IDs are per window: ordinals restart at each window */
+    ctx->id_seq[ctx->id_stack_index] = 0;
+
     iui_window *w = ctx->current_window;
 
     /* Reset content width tracker for this frame */
@@ -574,8 +842,11 @@ bool iui_begin_window(iui_context *ctx,
         ctx->corner,
         ctx->corner,
     };
-    if ((ctx->mouse_pressed & IUI_MOUSE_LEFT) &&
-        in_rect(&handle_rect, ctx->mouse_pos) &&
+    /* A press only acts on the topmost window under the cursor */
+    bool pressed = (ctx->mouse_pressed & IUI_MOUSE_LEFT) &&
+                   (ctx->window_hit_id == 0 || ctx->window_hit_id == w->id);
+
+    if (pressed && in_rect(&handle_rect, ctx->mouse_pos) &&
         (w->options & IUI_WINDOW_RESIZABLE)) {
         ctx->resizing_window = w;
         ctx->dragging_offset =
@@ -598,20 +869,11 @@ bool iui_begin_window(iui_context *ctx,
     };
 
     /* bring window to front and move if click on the title bar */
-    if ((ctx->mouse_pressed & IUI_MOUSE_LEFT) &&
-        in_rect(&title_rect, ctx->mouse_pos) &&
+    if (pressed && in_rect(&title_rect, ctx->mouse_pos) &&
         !(w->options & IUI_WINDOW_PINNED) && ctx->resizing_window != w) {
-        uint32_t idx = (uint32_t) (w - ctx->windows);
-        if (idx + 1u != ctx->num_windows) {
-            iui_window tmp = *w;
-            memmove(&ctx->windows[idx], &ctx->windows[idx + 1],
-                    (ctx->num_windows - idx - 1) * sizeof(iui_window));
-            ctx->windows[ctx->num_windows - 1] = tmp;
-            ctx->current_window = &ctx->windows[ctx->num_windows - 1];
-        }
-        ctx->dragging_object = ctx->current_window;
-        ctx->dragging_offset =
-            iui_vec2_sub(ctx->mouse_pos, ctx->current_window->pos);
+        window_raise(ctx, w);
+        ctx->dragging_object = w;
+        ctx->dragging_offset = iui_vec2_sub(ctx->mouse_pos, w->pos);
     }
 
     if (ctx->mouse_held & IUI_MOUSE_LEFT && ctx->dragging_object == w)
@@ -782,6 +1044,12 @@ void iui_require_content_width(iui_context *ctx, float width)
         return;
     if (width > ctx->window_content_min_width)
         ctx->window_content_min_width = width;
+
+    /* Enclosing scopes pick this up when the inner one ends */
+    iui_measure_state *m = &ctx->measure;
+    if (m->depth > 0 && m->depth <= IUI_MEASURE_DEPTH &&
+        width > m->scopes[m->depth - 1].width)
+        m->scopes[m->depth - 1].width = width;
 }
 
 /* Window and Frame Finalization */
@@ -821,6 +1089,8 @@ void iui_end_window(iui_context *ctx)
     /* Reset layout modes to prevent state leaking between windows */
     ctx->in_grid = false;
     ctx->box_depth = 0;
+    ctx->measure.depth = 0;
+    ctx->measure.card_depth = 0, ctx->measure.card_measured = 0;
 }
 
 void iui_end_frame(iui_context *ctx)
@@ -833,6 +1103,7 @@ void iui_end_frame(iui_context *ctx)
         ctx->animation.widget = NULL;
         ctx->animation.t = 1.f;
     }
+    iui_widget_state_frame_end(ctx);
 
     if (ctx->mouse_released & IUI_MOUSE_LEFT) {
         ctx->resizing_window = NULL;
@@ -849,10 +1120,18 @@ void iui_end_frame(iui_context *ctx)
     /* Reset per-frame input edges (event.c) */
     iui_input_frame_begin(ctx);
 
-    /* Reset scroll state for next frame */
+    /* Reset scroll state for next frame; this frame's innermost hovered
+     * regions receive the next wheel deltas
+     */
     ctx->scroll_wheel_dx = 0;
     ctx->scroll_wheel_dy = 0;
+    for (int axis = 0; axis < 2; axis++) {
+        iui_scroll_wheel *w = &ctx->scroll_wheel[axis];
+        w->target = w->next, w->view = w->next_view;
+        w->next = NULL;
+    }
     ctx->active_scroll = NULL;
+    ctx->scroll_depth = 0;
 
     /* Each begin_window/end_window pair must balance its clip push/pop. */
     assert(ctx->clip.depth == 0 && "leaked clip region across frame boundary");
@@ -416,3 +416,180 @@ void iui_list_divider(iui_context *ctx)
     /* Add small vertical spacing */
     ctx->layout.y += 1.f;
 }
+
+iui_list_range iui_list_virtual_begin(iui_context *ctx,
+                                      iui_scroll_state *state,
+                                      int item_count,
+                                      float item_height)
+{
+    iui_list_range range = {0, item_count > 0 ? item_count : 0};
+    if (!ctx || !state || ctx->active_scroll != state || item_height <= 0.f ||
+        range.last == 0)
+        return range;
+
+    /* Work in content space: list top and visible band relative to it */
+    float top = ctx->layout.y + state->scroll_y - ctx->scroll_content_start_y;
+    float view_top = state->scroll_y - top;
+    float view_bottom = view_top + ctx->scroll_viewport.height;
+
+    float first = floorf(view_top / item_height);
+    float last = ceilf(view_bottom / item_height);
+    range.first = (int) clamp_float(0.f, (float) item_count, first);
+    range.last =
+        (int) clamp_float((float) range.first, (float) item_count, last);
+
+    /* Skip the head now; iui_scroll_end accounts for the tail */
+    ctx->layout.y += (float) range.first * item_height;
+    ctx->scroll_virtual_h = top + (float) item_count * item_height;
+    state->content_h = ctx->scroll_virtual_h;
+    return range;
+}
+
+/* Variable-height index: Fenwick tree with 1-based node i at tree[i - 1] */
+
+static void heights_add(iui_list_heights *h, int index, float delta)
+{
+    for (int i = index + 1; i <= h->count; i += i & -i)
+        h->tree[i - 1] += delta;
+}
+
+static float heights_prefix(const iui_list_heights *h, int n)
+{
+    float sum = 0.f;
+    for (int i = n; i > 0; i -= i & -i)
+        sum += h->tree[i - 1];
+    return sum;
+}
+
+bool iui_list_heights_init(iui_list_heights *h,
+                           float *storage,
+                           int capacity,
+                           float estimate)
+{
+    if (!h || !storage || capacity <= 0 || estimate <= 0.f)
+        return false;
+    *h = (iui_list_heights) {
+        .tree = storage,
+        .heights = storage + capacity,
+        .capacity = capacity,
+        .estimate = estimate,
+    };
+    return true;
+}
+
+bool iui_list_heights_resize(iui_list_heights *h, int count)
+{
+    if (!h || count < 0 || count > h->capacity)
+        return false;
+
+    /* Nodes past the old count are rebuilt from the prefix sums below them,
+     * O(log n) each; shrinking just stops querying the tail.
+     */
+    for (int i = h->count + 1; i <= count; i++) {
+        h->heights[i - 1] = h->estimate;
+        h->tree[i - 1] = h->estimate + heights_prefix(h, i - 1) -
+                         heights_prefix(h, i - (i & -i));
+    }
+    h->count = count;
+    if (h->anchor > count)
+        h->anchor = count;
+    return true;
+}
+
+void iui_list_heights_set(iui_list_heights *h, int index, float height)
+{
+    if (!h || index < 0 || index >= h->count || height < 0.f)
+        return;
+
+    float delta = height - h->heights[index];
+    if (delta == 0.f)
+        return;
+    h->heights[index] = height;
+    heights_add(h, index, delta);
+    if (index < h->anchor)
+        h->anchor_shift += delta;
+}
+
+float iui_list_heights_offset(const iui_list_heights *h, int index)
+{
+    if (!h || index <= 0)
+        return 0.f;
+    return heights_prefix(h, index < h->count ? index : h->count);
+}
+
+int iui_list_heights_find(const iui_list_heights *h, float offset)
+{
+    if (!h || h->count == 0)
+        return 0;
+
+    /* Binary lifting: largest prefix whose sum stays within @offset */
+    int step = 1;
+    while (step * 2 <= h->count)
+        step *= 2;
+    int pos = 0;
+    for (; step > 0; step >>= 1) {
+        int next = pos + step;
+        if (next <= h->count && h->tree[next - 1] <= offset) {
+            pos = next;
+            offset -= h->tree[next - 1];
+        }
+    }
+    return pos < h->count ? pos : h->count - 1;
+}
+
+iui_list_range iui_list_virtual_begin_var(iui_context *ctx,
+                                          iui_scroll_state *state,
+                                          iui_list_heights *h)
+{
+    iui_list_range range = {0, h ? h->count : 0};
+    if (!ctx || !state || !h || ctx->active_scroll != state)
+        return range;
+
+    /* Keep the anchor item in place across corrections above it */
+    if (h->anchor_shift != 0.f) {
+        state->scroll_y = fmaxf(0.f, state->scroll_y + h->anchor_shift);
+        ctx->layout.y -= h->anchor_shift;
+        h->anchor_shift = 0.f;
+    }
+
+    float top = ctx->layout.y + state->scroll_y - ctx->scroll_content_start_y;
+    float total = heights_prefix(h, h->count);
+    ctx->scroll_virtual_h = top + total;
+    state->content_h = ctx->scroll_virtual_h;
+    if (h->count == 0) {
+        h->cursor_y = ctx->layout.y;
+        return range;
+    }
+
+    float view_top = state->scroll_y - top;
+    float view_bottom = view_top + ctx->scroll_viewport.height;
+    range.first = view_top > 0.f ? iui_list_heights_find(h, view_top) : 0;
+    range.last = iui_list_heights_find(h, view_bottom);
+    if (iui_list_heights_offset(h, range.last) < view_bottom)
+        range.last++;
+    if (range.last < range.first)
+        range.last = range.first;
+
+    ctx->layout.y += iui_list_heights_offset(h, range.first);
+    h->cursor_y = ctx->layout.y;
+    h->anchor = range.first;
+    return range;
+}
+
+void iui_list_virtual_measure(iui_context *ctx,
+                              iui_list_heights *h,
+                              int index)
+{
+    if (!ctx || !h || index < 0 || index >= h->count)
+        return;
+
+    float height = ctx->layout.y - h->cursor_y;
+    h->cursor_y = ctx->layout.y;
+    if (height <= 0.f)
+        return;
+
+    /* Items at or below the anchor only move the tail of the extent */
+    if (ctx->active_scroll)
+        ctx->scroll_virtual_h += height - h->heights[index];
+    iui_list_heights_set(h, index, height);
+}
@@ -102,16 +102,17 @@ iui_search_bar_result iui_search_bar_ex(iui_context *ctx,
 
     /* Handle keyboard input when focused */
     if (has_focus) {
-        /* Handle Enter key (submit) first */
-        if (ctx->key_pressed == IUI_KEY_ENTER)
-            result.submitted = true;
+        for (int it = 0; iui_text_event_next(ctx, &it);) {
+            /* Handle Enter key (submit) first */
+            if (ctx->key_pressed == IUI_KEY_ENTER)
+                result.submitted = true;
 
-        result.value_changed =
-            iui_process_text_input(ctx, buffer, size, cursor, true);
+            if (iui_process_text_input(ctx, buffer, size, cursor, true))
+                result.value_changed = true;
+        }
 
         /* Clear key/char after processing */
-        ctx->key_pressed = IUI_KEY_NONE;
-        ctx->char_input = 0;
+        iui_text_events_consume(ctx);
     }
 
     /* Get component state for hover effects */
@@ -355,10 +356,10 @@ bool iui_search_view_begin(iui_context *ctx,
     iui_register_textfield(ctx, search->query);
 
     /* Handle text input */
-    iui_process_text_input(ctx, search->query, sizeof(search->query),
-                           &search->cursor, true);
-    ctx->key_pressed = IUI_KEY_NONE;
-    ctx->char_input = 0;
+    for (int it = 0; iui_text_event_next(ctx, &it);)
+        iui_process_text_input(ctx, search->query, sizeof(search->query),
+                               &search->cursor, true);
+    iui_text_events_consume(ctx);
 
     /* Calculate text area */
     float text_x = field_x + padding;
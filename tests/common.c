@@ -196,6 +196,24 @@ iui_context *create_test_context(void *buffer, bool with_vector_prims)
     return iui_init(&config);
 }
 
+iui_context *create_test_context_for(const iui_config_t *caps)
+{
+    iui_config_t config = *caps;
+    config.font_height = 16.0f;
+    config.renderer = (iui_renderer_t) {
+        .draw_box = mock_draw_box,
+        .draw_text = mock_draw_text,
+        .set_clip_rect = mock_set_clip,
+        .text_width = mock_text_width,
+    };
+    config.buffer_size = iui_min_memory_size_for(&config);
+    config.buffer = malloc(config.buffer_size);
+    iui_context *ctx = config.buffer ? iui_init(&config) : NULL;
+    if (!ctx)
+        free(config.buffer);
+    return ctx;
+}
+
 /* Interaction Simulation Helpers */
 
 void test_simulate_click(iui_context *ctx, float x, float y)
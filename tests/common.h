@@ -250,6 +250,12 @@ void reset_counters(void);
 
 iui_context *create_test_context(void *buffer, bool with_vector_prims);
 
+/* Mock-rendered context with the capacities in @caps (its buffer, size,
+ * renderer and font height are filled in). The buffer is allocated to fit
+ * and starts at the returned context: release it with free(ctx).
+ */
+iui_context *create_test_context_for(const iui_config_t *caps);
+
 /* Quick test context initialization (uses static buffer) */
 static inline iui_context *test_init_context(void)
 {
@@ -3564,26 +3564,34 @@ int main(int argc, char *argv[])
 
     g_iui_port.configure(state.port);
 
-    /* Allocate UI buffer */
-    state.iui_buffer = malloc(iui_min_memory_size());
-    if (!state.iui_buffer) {
-        fprintf(stderr, "Failed to allocate UI buffer\n");
-        g_iui_port.shutdown(state.port);
-        return 1;
-    }
-
     /* Get renderer callbacks from port */
     iui_renderer_t renderer = g_iui_port.get_renderer_callbacks(state.port);
     const iui_vector_t *vector = g_iui_port.get_vector_callbacks(state.port);
 
-    /* Initialize libiui */
+    /* The demo draws overlapping widgets, vector text and long paragraphs,
+     * so it enables the optional tables a small target would leave off
+     */
     iui_config_t config = {
-        .buffer = state.iui_buffer,
         .font_height = DEMO_FONT_HEIGHT,
         .renderer = renderer,
         .vector = vector,
+        .max_widget_map = 128,
+        .glyph_cache_points = 2048,
+        .max_paragraphs = 8,
     };
 
+    /* Allocate UI buffer */
+    config.buffer_size = iui_min_memory_size_for(&config);
+    state.iui_buffer = malloc(config.buffer_size);
+    if (!state.iui_buffer) {
+        fprintf(stderr, "Failed to allocate UI buffer\n");
+        g_iui_port.shutdown(state.port);
+        return 1;
+    }
+
+    /* Initialize libiui */
+    config.buffer = state.iui_buffer;
+
     state.ui = iui_init(&config);
     if (!state.ui) {
         fprintf(stderr, "Failed to initialize libiui\n");
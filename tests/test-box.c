@@ -685,6 +685,75 @@ static void test_box_row_end_advance(void)
     END_TEST_WINDOW();
 }
 
+/* Test resolved sizes are reused across frames until the inputs change */
+static void test_box_layout_cache(void)
+{
+    BEGIN_TEST_WINDOW(box_layout_cache);
+
+    iui_sizing_t sizes[] = {IUI_FIXED(100), {IUI_SIZE_GROW, 1, 0, 120}};
+    iui_box_config_t cfg = {.child_count = 2, .sizes = sizes, .gap = 8};
+
+    iui_box_begin(ctx, &cfg);
+    iui_rect_t a1 = iui_box_next(ctx);
+    iui_rect_t b1 = iui_box_next(ctx);
+    iui_box_end(ctx);
+
+    iui_frame_stats stats;
+    iui_get_frame_stats(ctx, &stats);
+    ASSERT_EQ(stats.box_cache_hits, 0);
+    ASSERT_EQ(stats.box_cache_misses, 1);
+
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    /* Next frame: same box, counters reset, resolution served from cache */
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+    iui_box_begin(ctx, &cfg);
+    iui_rect_t a2 = iui_box_next(ctx);
+    iui_rect_t b2 = iui_box_next(ctx);
+    iui_box_end(ctx);
+
+    iui_get_frame_stats(ctx, &stats);
+    ASSERT_EQ(stats.box_cache_hits, 1);
+    ASSERT_EQ(stats.box_cache_misses, 0);
+    ASSERT_NEAR(a2.width, a1.width, 0.01f);
+    ASSERT_NEAR(b2.width, b1.width, 0.01f);
+    ASSERT_NEAR(b2.width, 120.f, 0.01f);
+
+    /* Changing a sizing spec must not return the stale entry */
+    sizes[0] = IUI_FIXED(60);
+    iui_box_begin(ctx, &cfg);
+    iui_rect_t a3 = iui_box_next(ctx);
+    iui_box_next(ctx);
+    iui_box_end(ctx);
+
+    iui_get_frame_stats(ctx, &stats);
+    ASSERT_EQ(stats.box_cache_misses, 1);
+    ASSERT_NEAR(a3.width, 60.f, 0.01f);
+
+    /* A matching hash alone is not a hit: fake a colliding entry whose
+     * stored specs differ from the current ones
+     */
+    for (int i = 0; i < IUI_BOX_CACHE_SIZE; i++) {
+        iui_box_cache_entry *e = &ctx->box_cache.entries[i];
+        if (e->hash && e->child_count == 2) {
+            e->sizes[0] = IUI_FIXED(100);
+            e->computed[0] = 100.f;
+        }
+    }
+    iui_box_begin(ctx, &cfg);
+    iui_rect_t a4 = iui_box_next(ctx);
+    iui_box_next(ctx);
+    iui_box_end(ctx);
+
+    iui_get_frame_stats(ctx, &stats);
+    ASSERT_EQ(stats.box_cache_misses, 2);
+    ASSERT_NEAR(a4.width, 60.f, 0.01f);
+
+    END_TEST_WINDOW();
+}
+
 /* Test Suite Runner */
 void run_box_tests(void)
 {
@@ -712,5 +781,6 @@ void run_box_tests(void)
     test_box_nested_row_inherits_height();
     test_box_column_no_children();
     test_box_row_end_advance();
+    test_box_layout_cache();
     SECTION_END();
 }
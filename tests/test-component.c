@@ -223,6 +223,97 @@ static void test_typography_scale(void)
     PASS();
 }
 
+static void test_text_paragraph(void)
+{
+    TEST(text_paragraph);
+    iui_config_t caps = {.max_paragraphs = 8};
+    iui_context *ctx = create_test_context_for(&caps);
+    ASSERT_NOT_NULL(ctx);
+
+    /* Mock text is 8px per character: 100px layout fits 12 characters */
+    const char *text = "The quick brown fox jumps over the lazy dog";
+    int lines[3];
+    float y0 = 0.f, y1 = 0.f;
+    for (int frame = 0; frame < 3; frame++) {
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 0, 0, 100 + ctx->padding * 4.f, 400, 0);
+        y0 = ctx->layout.y;
+        if (frame < 2)
+            lines[frame] = iui_text_paragraph(ctx, text, NULL);
+        else
+            lines[frame] = iui_text_paragraph(
+                ctx, text,
+                &(iui_paragraph_options) {IUI_ALIGN_LEFT, 2, true});
+        y1 = ctx->layout.y;
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+    }
+
+    /* "The quick" / "brown fox" / "jumps over" / "the lazy dog" */
+    ASSERT_EQ(lines[0], 4);
+    ASSERT_EQ(lines[1], 4);
+    ASSERT_EQ(ctx->paragraph_cache.misses, 2);
+    ASSERT_EQ(ctx->paragraph_cache.hits, 1);
+
+    /* Truncated to two lines ending in an ellipsis */
+    ASSERT_EQ(lines[2], 2);
+    ASSERT_NEAR(y1 - y0, ctx->row_height * 2.f, 0.01f);
+    ASSERT_STR_EQ(g_last_text_content, "brown fox...");
+
+    /* Overlong words are split and explicit newlines are honored */
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 0, 0, 100 + ctx->padding * 4.f, 400, 0);
+    ASSERT_EQ(iui_text_paragraph(ctx, "abcdefghijklmnopqrstuvwxyz", NULL), 3);
+    ASSERT_EQ(iui_text_paragraph(ctx, "a\n\nb", NULL), 3);
+
+    /* Unlimited paragraphs keep wrapping past the cached lines, and a limit
+     * past them still ends in an ellipsis
+     */
+    char many[IUI_PARAGRAPH_MAX_LINES * 24];
+    size_t pos = 0;
+    for (int i = 0; i < IUI_PARAGRAPH_MAX_LINES + 8; i++)
+        pos += (size_t) snprintf(many + pos, sizeof(many) - pos, "w%d\n", i);
+    int all = iui_text_paragraph(ctx, many, NULL);
+    ASSERT_EQ(all, IUI_PARAGRAPH_MAX_LINES + 8);
+    iui_paragraph_options cut = {IUI_ALIGN_LEFT, IUI_PARAGRAPH_MAX_LINES + 2,
+                                 true};
+    ASSERT_EQ(iui_text_paragraph(ctx, many, &cut), cut.max_lines);
+    ASSERT_TRUE(strstr(g_last_text_content, "...") != NULL);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    /* A line longer than the string buffer is cut on a code point */
+    static char wide[IUI_STRING_BUFFER_SIZE * 2];
+    for (size_t i = 0; i + 2 < sizeof(wide); i += 2)
+        memcpy(wide + i, "\xc3\xa9", 2);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 0, 0, 400, 400, 0);
+    ctx->layout.width = 1e6f;
+    ASSERT_EQ(iui_text_paragraph(ctx, wide, NULL), 1);
+    ASSERT_EQ(strlen(ctx->string_buffer), IUI_STRING_BUFFER_SIZE - 2);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    free(ctx);
+
+    /* Without a cache (the default) every layout is a miss, same lines */
+    void *buffer = malloc(iui_min_memory_size());
+    ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+    ASSERT_EQ(ctx->paragraph_cache.capacity, 0);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 0, 0, 100 + ctx->padding * 4.f, 400, 0);
+    for (int i = 0; i < 2; i++)
+        ASSERT_EQ(iui_text_paragraph(ctx, text, NULL), 4);
+    ASSERT_EQ(iui_text_paragraph(ctx, many, &cut), cut.max_lines);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    ASSERT_EQ(ctx->paragraph_cache.misses, 3);
+    ASSERT_EQ(ctx->paragraph_cache.hits, 0);
+
+    free(buffer);
+    PASS();
+}
+
 /* Shape Tokens Tests */
 
 static void test_shape_tokens(void)
@@ -392,6 +483,211 @@ static void test_date_time_picker_functions(void)
     PASS();
 }
 
+/* Data Table Source Tests */
+
+static int table_format_calls;
+
+static void format_table_cell(int row,
+                              int col,
+                              char *buf,
+                              size_t size,
+                              void *user)
+{
+    (void) user;
+    table_format_calls++;
+    snprintf(buf, size, "%d:%d", row, col);
+}
+
+/* 20 two-byte code points: longer than a cache entry holds */
+static void format_wide_cell(int row,
+                             int col,
+                             char *buf,
+                             size_t size,
+                             void *user)
+{
+    (void) row, (void) col, (void) user;
+    snprintf(buf, size, "%s",
+             "\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9"
+             "\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9"
+             "\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9");
+}
+
+static void table_rows_frame(iui_context *ctx,
+                             iui_table_state *table,
+                             iui_scroll_state *scroll,
+                             const iui_table_source *src)
+{
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 0, 0, 400, 400, 0);
+    iui_table_begin(ctx, table, 2, (float[]) {-1, 100});
+    iui_table_header(ctx, table, "Time");
+    iui_table_header(ctx, table, "Value");
+    iui_table_rows(ctx, table, scroll, 260.f, src);
+    iui_table_end(ctx, table);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+}
+
+static void test_table_source_rows(void)
+{
+    TEST(table_source_rows);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    static iui_table_cache_entry cache[64];
+    iui_table_state table = {.sort_column = -1, .selected_row = -1};
+    iui_scroll_state scroll = {0};
+    iui_table_source src = {
+        .row_count = 50000,
+        .cell = format_table_cell,
+        .cache = cache,
+        .cache_size = 64,
+    };
+
+    /* Only the 5 visible rows are formatted; extent covers every row */
+    table_format_calls = 0;
+    table_rows_frame(ctx, &table, &scroll, &src);
+    ASSERT_EQ(table_format_calls, 5 * 2);
+    ASSERT_NEAR(scroll.content_h, 50000 * IUI_TABLE_ROW_HEIGHT, 1.f);
+
+    /* Same rows and version: served from the cache */
+    table_format_calls = 0;
+    table_rows_frame(ctx, &table, &scroll, &src);
+    ASSERT_EQ(table_format_calls, 0);
+
+    /* Scrolled deep and a new version: reformatted once, text is right */
+    iui_scroll_to(&scroll, 0.f, 40000 * IUI_TABLE_ROW_HEIGHT);
+    src.version++;
+    table_format_calls = 0;
+    table_rows_frame(ctx, &table, &scroll, &src);
+    ASSERT_EQ(table_format_calls, 5 * 2);
+    size_t slot = (40000u * 2u + 1u) % 64u;
+    ASSERT_TRUE(cache[slot].valid);
+    ASSERT_STR_EQ(cache[slot].text, "40000:1");
+
+    /* Truncated cached text ends on a code point boundary */
+    src.cell = format_wide_cell;
+    src.version++;
+    table_rows_frame(ctx, &table, &scroll, &src);
+    size_t len = strlen(cache[slot].text);
+    ASSERT_EQ(len, (IUI_TABLE_CACHE_TEXT - 1) & ~1u);
+    ASSERT_EQ((unsigned char) cache[slot].text[len - 2], 0xC3);
+
+    /* A zero-height viewport still closes its scroll region */
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 0, 0, 400, 400, 0);
+    iui_table_begin(ctx, &table, 2, (float[]) {-1, 100});
+    iui_table_rows(ctx, &table, &scroll, -10000.f, &src);
+    ASSERT_NULL(ctx->active_scroll);
+    iui_table_end(ctx, &table);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    free(buffer);
+    PASS();
+}
+
+/* Table Model Tests */
+
+#define MODEL_ROWS 1000
+static int model_keys[MODEL_ROWS];
+static int model_filter_min;
+static int model_compare_calls;
+
+static int compare_model_rows(int a, int b, int col, void *user)
+{
+    (void) col, (void) user;
+    model_compare_calls++;
+    return (model_keys[a] > model_keys[b]) - (model_keys[a] < model_keys[b]);
+}
+
+static bool keep_model_row(int row, void *user)
+{
+    (void) user;
+    return model_keys[row] >= model_filter_min;
+}
+
+/* Visible rows ascend by key, ties in source order, all passing the filter */
+static bool model_view_ok(const iui_table_model *m, bool ascending)
+{
+    int expected = 0;
+    for (int row = 0; row < m->row_count; row++)
+        expected += model_keys[row] >= model_filter_min;
+    if (m->visible_count != expected)
+        return false;
+    for (int i = 0; i < m->visible_count; i++) {
+        int row = iui_table_model_row(m, i);
+        if (model_keys[row] < model_filter_min)
+            return false;
+        if (i == 0)
+            continue;
+        int prev = iui_table_model_row(m, i - 1);
+        int c = ascending ? model_keys[row] - model_keys[prev]
+                          : model_keys[prev] - model_keys[row];
+        if (c < 0 || (c == 0 && row < prev))
+            return false;
+    }
+    return true;
+}
+
+static void test_table_model(void)
+{
+    TEST(table_model);
+
+    static int storage[IUI_TABLE_MODEL_STORAGE(MODEL_ROWS)];
+    iui_table_model m;
+    ASSERT_TRUE(iui_table_model_init(&m, storage, MODEL_ROWS,
+                                     compare_model_rows, keep_model_row,
+                                     NULL));
+    for (int i = 0; i < MODEL_ROWS; i++)
+        model_keys[i] = (i * 7919) % 97; /* many ties */
+    model_filter_min = 0;
+
+    /* Unsorted: source order */
+    iui_table_model_sync(&m, NULL, 600);
+    ASSERT_EQ(m.visible_count, 600);
+    ASSERT_EQ(iui_table_model_row(&m, 599), 599);
+    ASSERT_EQ(iui_table_model_row(&m, 600), -1);
+
+    /* Sort by column 0, then append rows: merged, not re-sorted */
+    iui_table_state table = {.sort_column = 0, .sort_ascending = true};
+    iui_table_model_sync(&m, &table, 600);
+    ASSERT_TRUE(model_view_ok(&m, true));
+    model_compare_calls = 0;
+    iui_table_model_sync(&m, &table, 650);
+    ASSERT_TRUE(model_view_ok(&m, true));
+    ASSERT_TRUE(model_compare_calls < 650 + 50 * 6);
+
+    /* Descending stays stable */
+    table.sort_ascending = false;
+    iui_table_model_sync(&m, &table, 650);
+    ASSERT_TRUE(model_view_ok(&m, false));
+
+    /* Narrowing filter, then widening, then more rows */
+    uint32_t version = m.version;
+    model_filter_min = 40;
+    iui_table_model_filter(&m, true);
+    ASSERT_TRUE(m.version != version);
+    ASSERT_TRUE(model_view_ok(&m, false));
+    model_filter_min = 80;
+    iui_table_model_filter(&m, true);
+    ASSERT_TRUE(model_view_ok(&m, false));
+    model_filter_min = 20;
+    iui_table_model_filter(&m, false);
+    ASSERT_TRUE(model_view_ok(&m, false));
+    iui_table_model_sync(&m, &table, MODEL_ROWS + 10); /* clamped */
+    ASSERT_EQ(m.row_count, MODEL_ROWS);
+    ASSERT_TRUE(model_view_ok(&m, false));
+
+    /* Shrinking rebuilds the permutation */
+    iui_table_model_sync(&m, &table, 100);
+    ASSERT_TRUE(model_view_ok(&m, false));
+
+    PASS();
+}
+#undef MODEL_ROWS
+
 /* Test Suite Runner */
 
 void run_new_component_tests(void)
@@ -403,11 +699,14 @@ void run_new_component_tests(void)
     test_progress_indicators();
     test_button_styled_variants();
     test_typography_scale();
+    test_text_paragraph();
     test_shape_tokens();
     test_typography_scale_values();
     test_fab_extended_functions();
     test_tab_functions();
     test_search_bar_functions();
     test_date_time_picker_functions();
+    test_table_source_rows();
+    test_table_model();
     SECTION_END();
 }
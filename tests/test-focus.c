@@ -342,6 +342,71 @@ static void test_focus_empty_id(void)
     PASS();
 }
 
+/* Register a 20x20 grid of tiles; every other row is shifted by half a tile
+ * so vertical moves must pick the nearest of two overlapping neighbours.
+ */
+static int focus_grid_frame(iui_context *ctx, iui_focus_dir_t dir, bool move)
+{
+    int registered = 0;
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Grid", 0, 0, 1200, 1200, 0);
+    for (int i = 0; i < 400; i++) {
+        int row = i / 20, col = i % 20;
+        iui_rect_t r = {col * 50.0f + (row & 1) * 20.0f, row * 50.0f, 40, 40};
+        if (iui_register_focusable(ctx, (uint32_t) i + 1, r, 4.0f))
+            registered++;
+    }
+    if (move)
+        iui_focus_move(ctx, dir);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    return registered;
+}
+
+static void test_focus_move_directional(void)
+{
+    TEST(focus_move_directional);
+    iui_config_t caps = {.max_focusable = 400};
+    iui_context *ctx = create_test_context_for(&caps);
+    ASSERT_NOT_NULL(ctx);
+
+    /* Nothing focused: a move enters at the first widget */
+    ASSERT_EQ(focus_grid_frame(ctx, IUI_FOCUS_RIGHT, true), 400);
+    ASSERT_EQ(iui_get_focused_id(ctx), 1);
+
+    /* Row 0 at x=0, row 1 shifted right: down lands on row 1 col 0 */
+    focus_grid_frame(ctx, IUI_FOCUS_RIGHT, true);
+    ASSERT_EQ(iui_get_focused_id(ctx), 2);
+    focus_grid_frame(ctx, IUI_FOCUS_DOWN, true);
+    ASSERT_EQ(iui_get_focused_id(ctx), 22);
+    focus_grid_frame(ctx, IUI_FOCUS_DOWN, true);
+    ASSERT_EQ(iui_get_focused_id(ctx), 42);
+    focus_grid_frame(ctx, IUI_FOCUS_LEFT, true);
+    ASSERT_EQ(iui_get_focused_id(ctx), 41);
+
+    /* Edges: nothing further left or up keeps focus in place */
+    focus_grid_frame(ctx, IUI_FOCUS_LEFT, true);
+    ASSERT_EQ(iui_get_focused_id(ctx), 41);
+    for (int i = 0; i < 3; i++)
+        focus_grid_frame(ctx, IUI_FOCUS_UP, true);
+    ASSERT_EQ(iui_get_focused_id(ctx), 1);
+
+    /* Tab order still works alongside */
+    iui_focus_next(ctx);
+    focus_grid_frame(ctx, IUI_FOCUS_UP, false);
+    ASSERT_EQ(iui_get_focused_id(ctx), 2);
+    free(ctx);
+
+    /* The default capacity caps registration */
+    void *buffer = malloc(iui_min_memory_size());
+    ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+    ASSERT_EQ(focus_grid_frame(ctx, IUI_FOCUS_UP, false),
+              IUI_MAX_FOCUSABLE_WIDGETS);
+    free(buffer);
+    PASS();
+}
+
 /* Test Suite Runner */
 
 void run_focus_tests(void)
@@ -358,6 +423,7 @@ void run_focus_tests(void)
     test_focus_prev_single_widget();
     test_focus_navigation_multiple_widgets();
     test_focus_wrap_around();
+    test_focus_move_directional();
 
     /* Input interaction */
     test_focus_cleared_on_mouse_click();
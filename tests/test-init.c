@@ -144,6 +144,16 @@ static void test_def_is_valid(void)
     no_text_config.renderer.draw_text = NULL;
     ASSERT_FALSE(iui_config_is_valid(&no_text_config));
 
+    /* A known buffer size must fit the requested capacities */
+    iui_config_t sized_config = valid_config;
+    sized_config.buffer_size = iui_min_memory_size();
+    ASSERT_TRUE(iui_config_is_valid(&sized_config));
+    sized_config.max_widget_map = 128;
+    ASSERT_FALSE(iui_config_is_valid(&sized_config));
+    ASSERT_NULL(iui_init(&sized_config));
+    sized_config.buffer_size = iui_min_memory_size_for(&sized_config);
+    ASSERT_TRUE(iui_config_is_valid(&sized_config));
+
     free(buffer);
     PASS();
 }
@@ -235,6 +245,77 @@ static void test_box_children_limit(void)
     PASS();
 }
 
+static void test_stack_capacities(void)
+{
+    TEST(stack_capacities);
+    iui_config_t config = {
+        .max_box_depth = 12,
+        .max_box_children = 40,
+        .id_stack_size = 2,
+        .clip_stack_size = 24,
+        .max_widget_map = 200,
+    };
+
+    /* Defaults match the fixed-size variant; bigger stacks cost more */
+    ASSERT_EQ(iui_min_memory_size_for(NULL), iui_min_memory_size());
+    size_t size = iui_min_memory_size_for(&config);
+    ASSERT_TRUE(size > iui_min_memory_size());
+
+    iui_context *ctx = create_test_context_for(&config);
+    ASSERT_NOT_NULL(ctx);
+
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 0, 0, 800, 600, 0);
+
+    /* ID stack shrunk to 2 */
+    uint32_t id = 1;
+    ASSERT_TRUE(iui_push_id(ctx, &id, sizeof(id)));
+    ASSERT_TRUE(iui_push_id(ctx, &id, sizeof(id)));
+    ASSERT_FALSE(iui_push_id(ctx, &id, sizeof(id)));
+    iui_pop_id(ctx);
+    iui_pop_id(ctx);
+
+    /* Clip stack grown past the default (window holds one entry) */
+    iui_rect_t clip = {10, 10, 100, 100};
+    int pushes = 0;
+    while (pushes < 64 && iui_push_clip(ctx, clip))
+        pushes++;
+    ASSERT_EQ(pushes, 23);
+    for (int i = 0; i < pushes; i++)
+        iui_pop_clip(ctx);
+
+    /* Box depth and width grown past the defaults */
+    iui_box_config_t wide = {.child_count = 40, .cross = 30.0f};
+    int depth = 0;
+    while (depth < 64 && iui_box_begin(ctx, &wide).width > 0.f)
+        depth++;
+    ASSERT_EQ(depth, 12);
+    ASSERT_EQ(iui_box_depth(ctx), 12);
+    iui_rect_t last = {0};
+    for (int i = 0; i < 40; i++)
+        last = iui_box_next(ctx);
+    ASSERT_TRUE(last.width > 0.f);
+    for (int i = 0; i < depth; i++)
+        iui_box_end(ctx);
+
+    /* Widget map grown past the default, then overflowed */
+    iui_rect_t r = {100, 100, 10, 10};
+    for (int i = 0; i < 201; i++)
+        iui_get_component_state(ctx, r, false);
+    ASSERT_EQ(ctx->widget_map.count, 200);
+    ASSERT_TRUE(ctx->widget_map.overflow);
+
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    /* Negative capacities are rejected */
+    config.id_stack_size = -1;
+    ASSERT_FALSE(iui_config_is_valid(&config));
+
+    free(ctx);
+    PASS();
+}
+
 /* String Buffer Safety Tests */
 
 static void test_text_format_overflow(void)
@@ -325,6 +406,7 @@ void run_bounds_tests(void)
     test_id_stack_underflow();
     test_window_limit();
     test_box_children_limit();
+    test_stack_capacities();
     SECTION_END();
 }
 
@@ -431,6 +431,332 @@ static void test_delete_selection(void)
     PASS();
 }
 
+/* True if the focused field's prefix-width index matches a from-scratch
+ * measurement of text
+ */
+static bool prefix_index_matches(iui_context *ctx, const char *text)
+{
+    const iui_text_index *idx = &ctx->field_tracking.text_index;
+    size_t len = strlen(text);
+    if (idx->len != len)
+        return false;
+    float x = 0.f;
+    for (size_t pos = 0; pos < len;) {
+        if (fabsf(idx->x[pos] - x) > 0.001f)
+            return false;
+        x += iui_get_codepoint_width(ctx, iui_utf8_decode(text, pos, len));
+        pos = iui_utf8_next(text, pos, len);
+    }
+    return fabsf(idx->x[len] - x) <= 0.001f;
+}
+
+static void textfield_edit_frame(iui_context *ctx,
+                                 char *text,
+                                 size_t size,
+                                 iui_edit_state *state)
+{
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_edit_with_selection(ctx, text, size, state);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+}
+
+static void test_textfield_prefix_index(void)
+{
+    TEST(textfield_prefix_index);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    char text_buf[64] = "Hi \xC3\xA9t\xC3\xA9 World";
+    iui_edit_state state = {0};
+    const iui_text_index *idx = &ctx->field_tracking.text_index;
+
+    /* Focus the field; the index is built for the focused buffer only */
+    iui_update_mouse_pos(ctx, 200.0f, 150.0f);
+    iui_update_mouse_buttons(ctx, IUI_MOUSE_LEFT, 0);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_edit_with_selection(ctx, text_buf, sizeof(text_buf), &state);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    iui_update_mouse_buttons(ctx, 0, IUI_MOUSE_LEFT);
+    ASSERT_TRUE(idx->owner == text_buf);
+
+    /* Insert in the middle, then delete before a multi-byte code point */
+    state.cursor = state.selection_start = state.selection_end = 3;
+    iui_update_char(ctx, 'X');
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_edit_with_selection(ctx, text_buf, sizeof(text_buf), &state);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    iui_update_key(ctx, IUI_KEY_DELETE);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_edit_with_selection(ctx, text_buf, sizeof(text_buf), &state);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    ASSERT_EQ(strcmp(text_buf, "Hi Xt\xC3\xA9 World"), 0);
+
+    /* Incremental updates must match a from-scratch measurement */
+    ASSERT_TRUE(prefix_index_matches(ctx, text_buf));
+
+    /* Edits patch the index rather than rebuild it: a marked offset before
+     * a replaced selection and a backspace survives them
+     */
+    ctx->field_tracking.text_index.x[1] += 100.f;
+    state.selection_start = 7, state.selection_end = 9, state.cursor = 9;
+    iui_update_char(ctx, 'Y');
+    textfield_edit_frame(ctx, text_buf, sizeof(text_buf), &state);
+    iui_update_key(ctx, IUI_KEY_BACKSPACE);
+    textfield_edit_frame(ctx, text_buf, sizeof(text_buf), &state);
+    ASSERT_EQ(strcmp(text_buf, "Hi Xt\xC3\xA9orld"), 0);
+    ASSERT_TRUE(idx->owner == text_buf);
+    ctx->field_tracking.text_index.x[1] -= 100.f;
+    ASSERT_TRUE(prefix_index_matches(ctx, text_buf));
+
+    /* Attaching a glyph pack may change advances: the index is dropped */
+    static const uint8_t empty_pack[16] = {'I', 'U', 'G', 'P', 1};
+    ASSERT_TRUE(iui_glyph_pack_attach(ctx, empty_pack, sizeof(empty_pack)));
+    ASSERT_NULL(idx->owner);
+    textfield_edit_frame(ctx, text_buf, sizeof(text_buf), &state);
+    ASSERT_TRUE(idx->owner == text_buf);
+    iui_glyph_pack_detach_all(ctx);
+    ASSERT_NULL(idx->owner);
+
+    /* The plain text field patches it the same way: insert, then delete */
+    char plain[32] = "ab\xC3\xA9"
+                     "cd";
+    size_t cursor = 4;
+    ctx->focused_edit = plain;
+    for (int frame = 0; frame < 4; frame++) {
+        if (frame == 1) {
+            ctx->field_tracking.text_index.x[1] += 100.f;
+            iui_update_char(ctx, 'Z');
+        } else if (frame == 2) {
+            iui_update_key(ctx, IUI_KEY_BACKSPACE);
+        } else if (frame == 3) {
+            iui_update_key(ctx, IUI_KEY_DELETE);
+        }
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+        iui_textfield(ctx, plain, sizeof(plain), &cursor, NULL);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+    }
+    ASSERT_STR_EQ(plain, "ab\xC3\xA9"
+                         "d");
+    ASSERT_TRUE(idx->owner == plain);
+    ctx->field_tracking.text_index.x[1] -= 100.f;
+    ASSERT_TRUE(prefix_index_matches(ctx, plain));
+
+    free(buffer);
+    PASS();
+}
+
+static void test_text_buffer_ops(void)
+{
+    TEST(text_buffer_ops);
+
+    char storage[16], out[16];
+    iui_text_buffer_t tb;
+    ASSERT_TRUE(iui_text_buffer_init(&tb, storage, sizeof(storage), "hello"));
+    ASSERT_EQ(iui_text_buffer_length(&tb), 5);
+    ASSERT_EQ(tb.gap, 5);
+
+    /* Edits at the cursor only resize the gap */
+    iui_text_buffer_move(&tb, 2);
+    ASSERT_TRUE(iui_text_buffer_insert(&tb, "XY", 2));
+    iui_text_buffer_erase(&tb, 1, 1);
+    ASSERT_EQ(iui_text_buffer_copy(&tb, out, sizeof(out)), 5);
+    ASSERT_STR_EQ(out, "heXlo");
+    ASSERT_EQ(tb.gap, 3);
+    ASSERT_EQ(tb.version, 2);
+
+    /* Moves snap back to the start of a UTF-8 sequence */
+    iui_text_buffer_move(&tb, 5);
+    ASSERT_TRUE(iui_text_buffer_insert(&tb, "\xC3\xA9", 2));
+    iui_text_buffer_move(&tb, 6);
+    ASSERT_EQ(tb.gap, 5);
+    iui_text_buffer_move(&tb, 100);
+    ASSERT_EQ(tb.gap, 7);
+    iui_text_buffer_copy(&tb, out, sizeof(out));
+    ASSERT_STR_EQ(out, "heXlo\xC3\xA9");
+
+    /* Full buffer: inserts fail, a short copy is truncated */
+    ASSERT_FALSE(iui_text_buffer_insert(&tb, "12345678", 9));
+    ASSERT_TRUE(iui_text_buffer_insert(&tb, "12345678", 8));
+    ASSERT_EQ(tb.gap_len, 0);
+    ASSERT_EQ(iui_text_buffer_copy(&tb, out, 4), 15);
+    ASSERT_STR_EQ(out, "heX");
+
+    /* Oversized initial text is cut on a code point boundary */
+    ASSERT_FALSE(iui_text_buffer_init(&tb, storage, 4, "ab\xC3\xA9"));
+    ASSERT_EQ(iui_text_buffer_length(&tb), 2);
+
+    PASS();
+}
+
+/* One frame of a gap-buffer field */
+static void textfield_buffer_frame(iui_context *ctx, iui_text_buffer_t *tb)
+{
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_textfield_buffer(ctx, tb, NULL);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+}
+
+static void test_textfield_buffer(void)
+{
+    TEST(textfield_buffer);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    static char storage[4096];
+    char out[64];
+    iui_text_buffer_t tb;
+    iui_text_buffer_init(&tb, storage, sizeof(storage), "hello world");
+
+    /* Focus the field */
+    iui_update_mouse_pos(ctx, 200.0f, 150.0f);
+    iui_update_mouse_buttons(ctx, IUI_MOUSE_LEFT, 0);
+    textfield_buffer_frame(ctx, &tb);
+    iui_update_mouse_buttons(ctx, 0, IUI_MOUSE_LEFT);
+
+    /* Ctrl+Left lands before "world"; typing goes there */
+    iui_update_modifiers(ctx, IUI_MOD_CTRL);
+    iui_update_key(ctx, IUI_KEY_LEFT);
+    textfield_buffer_frame(ctx, &tb);
+    ASSERT_EQ(tb.gap, 6);
+    iui_update_modifiers(ctx, 0);
+    iui_update_char(ctx, 'X');
+    textfield_buffer_frame(ctx, &tb);
+    iui_text_buffer_copy(&tb, out, sizeof(out));
+    ASSERT_STR_EQ(out, "hello Xworld");
+
+    /* Both runs around the gap are drawn, split at the cursor */
+    g_draw_text_calls = 0;
+    textfield_buffer_frame(ctx, &tb);
+    ASSERT_EQ(g_draw_text_calls, 3); /* title, "hello X", "world" */
+
+    /* Backspace and Delete remove one code point each side */
+    iui_update_key(ctx, IUI_KEY_BACKSPACE);
+    textfield_buffer_frame(ctx, &tb);
+    iui_update_key(ctx, IUI_KEY_DELETE);
+    textfield_buffer_frame(ctx, &tb);
+    iui_text_buffer_copy(&tb, out, sizeof(out));
+    ASSERT_STR_EQ(out, "hello orld");
+
+    iui_update_key(ctx, IUI_KEY_END);
+    textfield_buffer_frame(ctx, &tb);
+    ASSERT_EQ(tb.gap, iui_text_buffer_length(&tb));
+
+    free(buffer);
+    PASS();
+}
+
+/* One frame of a gap-buffer field with selection */
+static void textfield_buffer_sel_frame(iui_context *ctx,
+                                       iui_text_buffer_t *tb,
+                                       iui_edit_state *state,
+                                       const iui_textfield_options *opts)
+{
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_textfield_buffer_with_selection(ctx, tb, state, opts);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+}
+
+static void test_textfield_buffer_selection(void)
+{
+    TEST(textfield_buffer_selection);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    static char storage[256];
+    char out[64];
+    iui_text_buffer_t tb;
+    iui_edit_state state = {0};
+    iui_text_buffer_init(&tb, storage, sizeof(storage), "hello world");
+
+    /* Focus, then select "world" with End and Ctrl+Shift+Left */
+    iui_update_mouse_pos(ctx, 200.0f, 150.0f);
+    iui_update_mouse_buttons(ctx, IUI_MOUSE_LEFT, 0);
+    textfield_buffer_sel_frame(ctx, &tb, &state, NULL);
+    iui_update_mouse_buttons(ctx, 0, IUI_MOUSE_LEFT);
+    iui_update_key(ctx, IUI_KEY_END);
+    textfield_buffer_sel_frame(ctx, &tb, &state, NULL);
+    iui_update_modifiers(ctx, IUI_MOD_CTRL | IUI_MOD_SHIFT);
+    iui_update_key(ctx, IUI_KEY_LEFT);
+    textfield_buffer_sel_frame(ctx, &tb, &state, NULL);
+    iui_update_modifiers(ctx, 0);
+    ASSERT_EQ(state.selection_start, 6);
+    ASSERT_EQ(state.selection_end, 11);
+
+    /* Typing replaces the selection at the gap */
+    iui_update_char(ctx, 'X');
+    textfield_buffer_sel_frame(ctx, &tb, &state, NULL);
+    iui_text_buffer_copy(&tb, out, sizeof(out));
+    ASSERT_STR_EQ(out, "hello X");
+    ASSERT_EQ(state.cursor, 7);
+    ASSERT_EQ(tb.gap, 7);
+
+    /* Widths are cached on the text version and gap: a steady frame reuses
+     * them and a cursor move only measures the span it crossed
+     */
+    ASSERT_EQ(tb.measured.version, tb.version);
+    ASSERT_NEAR(tb.measured.width, 56.f, 0.01f);
+    tb.measured.head_width += 1000.f;
+    textfield_buffer_sel_frame(ctx, &tb, &state, NULL);
+    ASSERT_NEAR(tb.measured.head_width, 1056.f, 0.01f);
+    iui_update_key(ctx, IUI_KEY_LEFT);
+    textfield_buffer_sel_frame(ctx, &tb, &state, NULL);
+    ASSERT_NEAR(tb.measured.head_width, 1048.f, 0.01f);
+    tb.measured.version--; /* stale: measured again on the next frame */
+    iui_update_key(ctx, IUI_KEY_RIGHT);
+    textfield_buffer_sel_frame(ctx, &tb, &state, NULL);
+    ASSERT_NEAR(tb.measured.head_width, 56.f, 0.01f);
+    ASSERT_EQ(tb.measured.head_count, 7);
+
+    /* Shift+Home then Delete clears everything */
+    iui_update_modifiers(ctx, IUI_MOD_SHIFT);
+    iui_update_key(ctx, IUI_KEY_HOME);
+    textfield_buffer_sel_frame(ctx, &tb, &state, NULL);
+    iui_update_modifiers(ctx, 0);
+    iui_update_key(ctx, IUI_KEY_DELETE);
+    textfield_buffer_sel_frame(ctx, &tb, &state, NULL);
+    ASSERT_EQ(iui_text_buffer_length(&tb), 0);
+
+    /* Password mode masks one '*' per code point: 3 code points, 5 bytes */
+    iui_text_buffer_init(&tb, storage, sizeof(storage), "a\xC3\xA9\xC3\xA9");
+    iui_textfield_options opts = {.password_mode = true};
+    textfield_buffer_sel_frame(ctx, &tb, &state, &opts);
+    ASSERT_STR_EQ(g_last_text_content, "***");
+
+    /* A mask longer than the string buffer is drawn in chunks to the end */
+    static char big[IUI_STRING_BUFFER_SIZE * 3];
+    static char text[IUI_STRING_BUFFER_SIZE * 2 + 32];
+    size_t n = 0;
+    for (int i = 0; i < IUI_STRING_BUFFER_SIZE + 10; i++, n += 2)
+        memcpy(text + n, "\xC3\xA9", 2);
+    text[n] = '\0';
+    iui_text_buffer_init(&tb, big, sizeof(big), text);
+    g_draw_text_calls = 0;
+    textfield_buffer_sel_frame(ctx, &tb, &state, &opts);
+    ASSERT_EQ(g_draw_text_calls, 3); /* title and two mask chunks */
+    ASSERT_EQ(strlen(g_last_text_content), 11);
+
+    free(buffer);
+    PASS();
+}
+
 static void test_type_replaces_selection(void)
 {
     TEST(type_replaces_selection);
@@ -910,6 +1236,117 @@ static void test_input_update_functions(void)
     PASS();
 }
 
+static void test_input_event_queue(void)
+{
+    TEST(input_event_queue);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    char text_buf[32] = "";
+    size_t cursor = 0;
+
+    /* Click to focus */
+    iui_update_mouse_pos(ctx, 200.0f, 150.0f);
+    iui_update_mouse_buttons(ctx, IUI_MOUSE_LEFT, 0);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_textfield(ctx, text_buf, sizeof(text_buf), &cursor, NULL);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    ASSERT_EQ(iui_event_count(ctx), 0);
+    iui_update_mouse_buttons(ctx, 0, IUI_MOUSE_LEFT);
+
+    /* Several keystrokes and pointer moves between two frames */
+    const char *typed = "abc";
+    uint32_t t = 1000;
+    for (const char *c = typed; *c; c++) {
+        iui_input_event ev = {.type = IUI_EVENT_CHAR, .code = *c};
+        ev.time_ms = t++;
+        ASSERT_TRUE(iui_push_event(ctx, &ev));
+        ev = (iui_input_event) {.type = IUI_EVENT_MOTION, .time_ms = t++};
+        ev.x = 200.0f + (float) (*c - 'a'), ev.y = 150.0f;
+        ASSERT_TRUE(iui_push_event(ctx, &ev));
+        ev.x += 0.5f, ev.time_ms = t++;
+        ASSERT_TRUE(iui_push_event(ctx, &ev));
+    }
+    iui_update_key(ctx, IUI_KEY_BACKSPACE);
+    iui_update_char(ctx, 'd');
+
+    /* Release, 3 x (char, coalesced motion pair), key, char */
+    ASSERT_EQ(iui_event_count(ctx), 9);
+    ASSERT_EQ(iui_event_get(ctx, 0)->type, IUI_EVENT_BUTTON);
+    const iui_input_event *motion = iui_event_get(ctx, 2);
+    ASSERT_NOT_NULL(motion);
+    ASSERT_EQ(motion->type, IUI_EVENT_MOTION);
+    ASSERT_EQ(motion->time_ms, 1002);
+    ASSERT_NEAR(motion->x, 200.5f, 0.001f);
+    ASSERT_EQ(iui_event_get(ctx, 7)->time_ms, 1008);
+    ASSERT_NULL(iui_event_get(ctx, 9));
+
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_textfield(ctx, text_buf, sizeof(text_buf), &cursor, NULL);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    ASSERT_STR_EQ(text_buf, "abd");
+    ASSERT_EQ(cursor, 3);
+    ASSERT_EQ(iui_event_count(ctx), 0);
+
+    /* IME commit delivers the whole string */
+    iui_commit_composition(ctx, "xy\xc3\xa9");
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_textfield(ctx, text_buf, sizeof(text_buf), &cursor, NULL);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    ASSERT_STR_EQ(text_buf, "abdxy\xc3\xa9");
+
+    free(buffer);
+    PASS();
+}
+
+static void test_input_event_queue_modifiers(void)
+{
+    TEST(input_event_queue_modifiers);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    char text_buf[32] = "ab cd";
+    size_t cursor = 5;
+
+    /* Click to focus */
+    iui_update_mouse_pos(ctx, 200.0f, 150.0f);
+    iui_update_mouse_buttons(ctx, IUI_MOUSE_LEFT, 0);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_textfield(ctx, text_buf, sizeof(text_buf), &cursor, NULL);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    iui_update_mouse_buttons(ctx, 0, IUI_MOUSE_LEFT);
+    cursor = 5;
+
+    /* Ctrl+Left (word), then a plain Left, then Shift alone */
+    iui_update_modifiers(ctx, IUI_MOD_CTRL);
+    iui_update_key(ctx, IUI_KEY_LEFT);
+    iui_update_modifiers(ctx, IUI_MOD_NONE);
+    iui_update_key(ctx, IUI_KEY_LEFT);
+    iui_update_modifiers(ctx, IUI_MOD_SHIFT);
+
+    /* Each key sees its own modifiers; the live state is back afterwards */
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_begin_window(ctx, "Test", 100, 100, 300, 200, 0);
+    iui_textfield(ctx, text_buf, sizeof(text_buf), &cursor, NULL);
+    ASSERT_EQ(ctx->modifiers, IUI_MOD_SHIFT);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+    ASSERT_EQ(cursor, 2);
+
+    free(buffer);
+    PASS();
+}
+
 /* Test Suite Runner */
 
 void run_input_tests(void)
@@ -925,6 +1362,8 @@ void run_input_tests(void)
     test_selection_right_arrow();
     test_button_state_sequence();
     test_input_update_functions();
+    test_input_event_queue();
+    test_input_event_queue_modifiers();
     SECTION_END();
 
     SECTION_BEGIN("Text Selection");
@@ -934,6 +1373,10 @@ void run_input_tests(void)
     test_shift_home_end_selection();
     test_delete_selection();
     test_type_replaces_selection();
+    test_textfield_prefix_index();
+    test_text_buffer_ops();
+    test_textfield_buffer();
+    test_textfield_buffer_selection();
     test_selection_constants();
     test_textfield_with_selection();
     SECTION_END();
@@ -254,6 +254,173 @@ static void test_grid_restores_layout(void)
     PASS();
 }
 
+/* Window Table Tests */
+
+static void window_frame(iui_context *ctx, const char *const *names, int n)
+{
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    for (int i = 0; i < n; i++) {
+        iui_begin_window(ctx, names[i], (float) (i * 50), (float) (i * 10), 200,
+                         150, 0);
+        iui_end_window(ctx);
+    }
+    iui_end_frame(ctx);
+}
+
+static void test_window_press_hits_topmost(void)
+{
+    TEST(window_press_hits_topmost);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    const char *names[] = {"A", "B"};
+    window_frame(ctx, names, 2);
+    iui_window *a = &ctx->windows[0], *b = &ctx->windows[1];
+    ASSERT_EQ(ctx->window_top, 1);
+
+    /* Both title bars overlap here; only B (on top) may start a drag */
+    iui_update_mouse_pos(ctx, 60, 20);
+    iui_update_mouse_buttons(ctx, IUI_MOUSE_LEFT, 0);
+    window_frame(ctx, names, 2);
+    ASSERT_TRUE(ctx->dragging_object == b);
+    iui_update_mouse_buttons(ctx, 0, IUI_MOUSE_LEFT);
+    window_frame(ctx, names, 2);
+
+    /* Pressing A's uncovered title raises it without moving any slot */
+    iui_update_mouse_pos(ctx, 20, 15);
+    iui_update_mouse_buttons(ctx, IUI_MOUSE_LEFT, 0);
+    window_frame(ctx, names, 2);
+    ASSERT_TRUE(ctx->dragging_object == a);
+    ASSERT_EQ(ctx->window_top, 0);
+    ASSERT_EQ(ctx->window_bottom, 1);
+    ASSERT_EQ(a->id, iui_hash_str("A"));
+
+    free(buffer);
+    PASS();
+}
+
+static void test_window_capacity_from_config(void)
+{
+    TEST(window_capacity_from_config);
+    iui_config_t caps = {.max_windows = 100};
+    iui_context *ctx = create_test_context_for(&caps);
+    ASSERT_NOT_NULL(ctx);
+
+    char name[32];
+    for (int frame = 0; frame < 2; frame++) {
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        for (int i = 0; i < 101; i++) {
+            snprintf(name, sizeof(name), "Pane%d", i);
+            bool open = iui_begin_window(ctx, name, 0, 0, 100, 100, 0);
+            ASSERT_EQ(open, i < 100);
+            if (open) {
+                /* Found again by hash on the second frame */
+                ASSERT_TRUE(ctx->current_window == &ctx->windows[i]);
+                iui_end_window(ctx);
+            }
+        }
+        iui_end_frame(ctx);
+    }
+    ASSERT_EQ(ctx->num_windows, 100);
+
+    free(ctx);
+    PASS();
+}
+
+/* Measurement Record Tests */
+
+static void test_measure_records_content(void)
+{
+    TEST(measure_records_content);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    const uint32_t id = 0x1234;
+    float w = -1.f, h = -1.f;
+    ASSERT_FALSE(iui_measured_size(ctx, id, &w, &h));
+
+    float first_h = 0.f;
+    for (int frame = 0; frame < 2; frame++) {
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+        iui_measure_begin(ctx, id);
+        iui_require_content_width(ctx, 120.0f);
+        for (int i = 0; i < 3; i++)
+            iui_newline(ctx);
+        bool changed = iui_measure_end(ctx);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+
+        /* First frame creates the record, identical frames keep it */
+        ASSERT_EQ(changed, frame == 0);
+        ASSERT_TRUE(iui_measured_size(ctx, id, &w, &h));
+        ASSERT_NEAR(w, 120.0f, 0.001f);
+        if (frame == 0)
+            first_h = h;
+        ASSERT_NEAR(h, first_h, 0.001f);
+    }
+    ASSERT_TRUE(first_h >= 3 * 16.0f);
+
+    free(buffer);
+    PASS();
+}
+
+static void test_card_auto_height(void)
+{
+    TEST(card_auto_height);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    float inner_h[2];
+    float content_h = 0.f;
+    for (int frame = 0; frame < 2; frame++) {
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+        iui_card_begin(ctx, 20, 40, 200, 0, IUI_CARD_FILLED);
+        inner_h[frame] = iui_get_layout_rect(ctx).height;
+        float y0 = iui_get_layout_rect(ctx).y;
+        iui_newline(ctx);
+        iui_newline(ctx);
+        content_h = iui_get_layout_rect(ctx).y - y0;
+        iui_card_end(ctx);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+    }
+
+    /* Frame 1 has nothing measured yet; frame 2 fits the content */
+    ASSERT_NEAR(inner_h[0], 0.0f, 0.001f);
+    ASSERT_NEAR(inner_h[1], content_h, 0.001f);
+
+    /* A fixed-height card nested inside does not end the outer measurement,
+     * and the outer card keeps its record when it moves
+     */
+    for (int frame = 0; frame < 2; frame++) {
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+        iui_card_begin(ctx, 20, 40 + 10.f * frame, 200, 0, IUI_CARD_FILLED);
+        inner_h[frame] = iui_get_layout_rect(ctx).height;
+        float y0 = iui_get_layout_rect(ctx).y;
+        iui_newline(ctx);
+        iui_rect_t at = iui_get_layout_rect(ctx);
+        iui_card_begin(ctx, at.x, at.y, at.width, 40, IUI_CARD_OUTLINED);
+        iui_card_end(ctx);
+        iui_newline(ctx);
+        iui_newline(ctx);
+        content_h = iui_get_layout_rect(ctx).y - y0;
+        iui_card_end(ctx);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+    }
+    ASSERT_NEAR(inner_h[1], content_h, 0.001f);
+    ASSERT_EQ(ctx->measure.card_depth, 0);
+
+    free(buffer);
+    PASS();
+}
+
 /* Test Suite Runner */
 void run_layout_tests(void)
 {
@@ -267,5 +434,11 @@ void run_layout_tests(void)
     test_window_no_autosize_ignores_content_width();
     test_grid_reports_width_requirement();
     test_grid_restores_layout();
+    /* Window table */
+    test_window_press_hits_topmost();
+    test_window_capacity_from_config();
+    /* Measurement records */
+    test_measure_records_content();
+    test_card_auto_height();
     SECTION_END();
 }
@@ -1015,6 +1015,51 @@ static void test_input_layer_system(void)
     PASS();
 }
 
+static void test_input_layer_many_regions(void)
+{
+    TEST(input_layer_many_regions);
+    iui_config_t caps = {.max_blocking_regions = 256};
+    iui_context *ctx = create_test_context_for(&caps);
+    ASSERT_NOT_NULL(ctx);
+
+    /* Frame 1: 16x12 small overlays on a 40px pitch plus one wide sheet */
+    iui_begin_frame(ctx, 0.016f);
+    (void) iui_push_layer(ctx, 100);
+    int registered = 0;
+    for (int y = 0; y < 12; y++) {
+        for (int x = 0; x < 16; x++) {
+            iui_rect_t r = {x * 40.f, y * 40.f, 10.f, 10.f};
+            registered += iui_register_blocking_region(ctx, r);
+        }
+    }
+    ASSERT_EQ(registered, 192);
+    ASSERT_TRUE(iui_register_blocking_region(
+        ctx, (iui_rect_t) {0.f, 500.f, 640.f, 100.f}));
+    iui_pop_layer(ctx);
+    iui_end_frame(ctx);
+
+    /* Frame 2: a new layer is below every indexed region */
+    iui_begin_frame(ctx, 0.016f);
+    (void) iui_push_layer(ctx, 50);
+    for (int y = 0; y < 12; y++) {
+        for (int x = 0; x < 16; x++) {
+            iui_rect_t on = {x * 40.f + 2.f, y * 40.f + 2.f, 4.f, 4.f};
+            iui_rect_t gap = {x * 40.f + 15.f, y * 40.f + 15.f, 20.f, 20.f};
+            ASSERT_FALSE(iui_should_process_input(ctx, on));
+            ASSERT_TRUE(iui_should_process_input(ctx, gap));
+        }
+    }
+    ASSERT_FALSE(
+        iui_should_process_input(ctx, (iui_rect_t) {300.f, 550.f, 8.f, 8.f}));
+    ASSERT_TRUE(
+        iui_should_process_input(ctx, (iui_rect_t) {900.f, 900.f, 8.f, 8.f}));
+    iui_pop_layer(ctx);
+    iui_end_frame(ctx);
+
+    free(ctx);
+    PASS();
+}
+
 /* Test Suite Runners */
 
 void run_input_layer_tests(void)
@@ -1028,6 +1073,7 @@ void run_input_layer_tests(void)
     test_input_layer_with_modal_compat();
     test_input_layer_double_buffer();
     test_input_layer_system();
+    test_input_layer_many_regions();
     SECTION_END();
 }
 
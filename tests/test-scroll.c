@@ -345,6 +345,408 @@ static void test_scroll_horizontal(void)
     PASS();
 }
 
+static void test_scroll_virtual_list(void)
+{
+    TEST(scroll_virtual_list);
+
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    iui_scroll_state scroll = {0};
+    const int count = 100000;
+    const float h = IUI_LIST_ONE_LINE_HEIGHT;
+
+    /* First frame: top of the list, extent covers every row */
+    iui_begin_frame(ctx, 0.016f);
+    iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+    iui_scroll_begin(ctx, &scroll, 200.f, 300.f);
+    iui_list_range r = iui_list_virtual_begin(ctx, &scroll, count, h);
+    ASSERT_EQ(r.first, 0);
+    ASSERT_EQ(r.last, 6); /* ceil(300 / 56) */
+    for (int i = r.first; i < r.last; i++)
+        iui_list_item_simple(ctx, "Row", NULL);
+    iui_scroll_end(ctx, &scroll);
+    ASSERT_NEAR(scroll.content_h, count * h, 1.f);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    /* Deep in the list: only the visible rows, laid out at their slot */
+    iui_scroll_to(&scroll, 0.f, 5000.f * h + 10.f);
+    iui_begin_frame(ctx, 0.016f);
+    iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+    iui_rect_t view = iui_scroll_begin(ctx, &scroll, 200.f, 300.f);
+    r = iui_list_virtual_begin(ctx, &scroll, count, h);
+    ASSERT_EQ(r.first, 5000);
+    ASSERT_EQ(r.last, 5006);
+    ASSERT_NEAR(ctx->layout.y, view.y - 10.f, 0.5f);
+    for (int i = r.first; i < r.last; i++)
+        iui_list_item_simple(ctx, "Row", NULL);
+    iui_scroll_end(ctx, &scroll);
+    ASSERT_NEAR(scroll.content_h, count * h, 1.f);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    /* Outside a scroll region every item is visible */
+    r = iui_list_virtual_begin(ctx, &scroll, count, h);
+    ASSERT_EQ(r.first, 0);
+    ASSERT_EQ(r.last, count);
+
+    free(buffer);
+    PASS();
+}
+
+static void test_scroll_virtual_list_var(void)
+{
+    TEST(scroll_virtual_list_var);
+
+    /* Index agrees with a linear scan through growth and updates */
+    enum { CAP = 1000 };
+    static float storage[2 * CAP];
+    static float ref[CAP];
+    iui_list_heights h;
+    ASSERT_TRUE(iui_list_heights_init(&h, storage, CAP, 56.f));
+    ASSERT_TRUE(iui_list_heights_resize(&h, 300));
+    for (int i = 0; i < 300; i++)
+        iui_list_heights_set(&h, i, (float) (56 + (i % 3) * 16));
+    ASSERT_TRUE(iui_list_heights_resize(&h, CAP));
+    ASSERT_FALSE(iui_list_heights_resize(&h, CAP + 1));
+    for (int i = 0; i < CAP; i++)
+        ref[i] = i < 300 ? (float) (56 + (i % 3) * 16) : 56.f;
+    float sum = 0.f;
+    for (int i = 0; i < CAP; i++) {
+        ASSERT_NEAR(iui_list_heights_offset(&h, i), sum, 0.01f);
+        ASSERT_EQ(iui_list_heights_find(&h, sum), i);
+        ASSERT_EQ(iui_list_heights_find(&h, sum + ref[i] - 1.f), i);
+        sum += ref[i];
+    }
+    ASSERT_NEAR(iui_list_heights_offset(&h, CAP), sum, 0.01f);
+    ASSERT_EQ(iui_list_heights_find(&h, sum + 100.f), CAP - 1);
+
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    /* Render three-line items where 56 was estimated and learn them */
+    iui_scroll_state scroll = {0};
+    iui_list_heights_init(&h, storage, CAP, 56.f);
+    iui_list_heights_resize(&h, CAP);
+    iui_begin_frame(ctx, 0.016f);
+    iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+    iui_scroll_begin(ctx, &scroll, 200.f, 300.f);
+    iui_list_range r = iui_list_virtual_begin_var(ctx, &scroll, &h);
+    ASSERT_EQ(r.first, 0);
+    ASSERT_EQ(r.last, 6); /* ceil(300 / 56) */
+    iui_list_item item = {.headline = "Row"};
+    for (int i = r.first; i < r.last; i++) {
+        iui_list_item_ex(ctx, IUI_LIST_THREE_LINE, &item);
+        iui_list_virtual_measure(ctx, &h, i);
+    }
+    iui_scroll_end(ctx, &scroll);
+    float total = 6 * IUI_LIST_THREE_LINE_HEIGHT + (CAP - 6) * 56.f;
+    ASSERT_NEAR(scroll.content_h, total, 0.5f);
+    ASSERT_NEAR(iui_list_heights_offset(&h, 6),
+                6 * IUI_LIST_THREE_LINE_HEIGHT, 0.01f);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    /* Scroll to item 500, then correct a height above it */
+    iui_scroll_to(&scroll, 0.f, iui_list_heights_offset(&h, 500));
+    iui_begin_frame(ctx, 0.016f);
+    iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+    iui_scroll_begin(ctx, &scroll, 200.f, 300.f);
+    r = iui_list_virtual_begin_var(ctx, &scroll, &h);
+    ASSERT_EQ(r.first, 500);
+    iui_scroll_end(ctx, &scroll);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    float before = scroll.scroll_y;
+    iui_list_heights_set(&h, 10, 56.f + 30.f);
+    iui_begin_frame(ctx, 0.016f);
+    iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+    iui_rect_t view = iui_scroll_begin(ctx, &scroll, 200.f, 300.f);
+    r = iui_list_virtual_begin_var(ctx, &scroll, &h);
+    ASSERT_NEAR(scroll.scroll_y, before + 30.f, 0.01f);
+    ASSERT_EQ(r.first, 500);
+    ASSERT_NEAR(ctx->layout.y, view.y, 0.5f); /* item 500 still on top */
+    iui_scroll_end(ctx, &scroll);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    free(buffer);
+    PASS();
+}
+
+/* Mock layer hooks: remember what the library offered */
+static int g_layer_begins, g_layer_ends;
+static bool g_layer_reuse;
+
+static bool mock_layer_begin(iui_rect_t viewport,
+                             float scroll_y,
+                             bool reuse,
+                             void *user)
+{
+    (void) viewport;
+    (void) scroll_y;
+    (void) user;
+    g_layer_begins++;
+    g_layer_reuse = reuse;
+    return true;
+}
+
+static void mock_layer_end(void *user)
+{
+    (void) user;
+    g_layer_ends++;
+}
+
+/* One frame of a cached list; row 2 reads "Changed" when asked */
+static void scroll_layer_frame(iui_context *ctx,
+                               iui_scroll_state *scroll,
+                               iui_scroll_layer *layer,
+                               bool change)
+{
+    iui_begin_frame(ctx, 0.016f);
+    iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+    iui_scroll_begin_cached(ctx, scroll, 200.f, 300.f, layer);
+    for (int i = 0; i < 20; i++)
+        iui_list_item_simple(ctx, change && i == 2 ? "Changed" : "Row", NULL);
+    iui_scroll_end(ctx, scroll);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+}
+
+static void test_scroll_cached_layer(void)
+{
+    TEST(scroll_cached_layer);
+
+    void *buffer = malloc(iui_min_memory_size());
+    iui_config_t config = {
+        .buffer = buffer,
+        .font_height = 16.0f,
+        .renderer =
+            {
+                .draw_box = mock_draw_box,
+                .draw_text = mock_draw_text,
+                .set_clip_rect = mock_set_clip,
+                .text_width = mock_text_width,
+                .layer_begin = mock_layer_begin,
+                .layer_end = mock_layer_end,
+            },
+    };
+    iui_context *ctx = iui_init(&config);
+    ASSERT_NOT_NULL(ctx);
+
+    static uint32_t record[2048];
+    iui_scroll_state scroll = {0};
+    iui_scroll_layer layer = {.record = record, .record_cap = 2048};
+    g_layer_begins = g_layer_ends = 0;
+
+    /* Nothing to compare against yet, then an idle frame */
+    scroll_layer_frame(ctx, &scroll, &layer, false);
+    ASSERT_FALSE(g_layer_reuse);
+    ASSERT_TRUE(ctx->renderer.draw_box == mock_draw_box);
+    ASSERT_TRUE(ctx->renderer.layer_begin == mock_layer_begin);
+    reset_counters();
+    scroll_layer_frame(ctx, &scroll, &layer, false);
+    ASSERT_FALSE(g_layer_reuse);
+    int boxes = g_draw_box_calls;
+
+    /* Unchanged content while scrolling is recorded, then reused; the port
+     * still receives every command
+     */
+    iui_scroll_by(&scroll, 0.f, 20.f);
+    reset_counters();
+    scroll_layer_frame(ctx, &scroll, &layer, false);
+    ASSERT_TRUE(g_layer_reuse);
+    ASSERT_EQ(g_draw_box_calls, boxes);
+    ASSERT_EQ(layer.record_len, 0);
+
+    /* A change mid-scroll is caught in the frame that makes it */
+    iui_scroll_by(&scroll, 0.f, 20.f);
+    scroll_layer_frame(ctx, &scroll, &layer, true);
+    ASSERT_FALSE(g_layer_reuse);
+    iui_scroll_by(&scroll, 0.f, 20.f);
+    scroll_layer_frame(ctx, &scroll, &layer, true);
+    ASSERT_FALSE(g_layer_reuse);
+    iui_scroll_by(&scroll, 0.f, 20.f);
+    scroll_layer_frame(ctx, &scroll, &layer, true);
+    ASSERT_TRUE(g_layer_reuse);
+    ASSERT_EQ(g_layer_begins, 6);
+    ASSERT_EQ(g_layer_ends, 6);
+
+    /* A record too small for the frame falls back to a full redraw */
+    layer.record_cap = 16;
+    iui_scroll_by(&scroll, 0.f, 20.f);
+    reset_counters();
+    scroll_layer_frame(ctx, &scroll, &layer, true);
+    ASSERT_FALSE(g_layer_reuse);
+    ASSERT_EQ(g_draw_box_calls, boxes);
+
+    free(buffer);
+    PASS();
+}
+
+/* A horizontal carousel nested in a vertical feed */
+static void scroll_nested_frame(iui_context *ctx,
+                                iui_scroll_state *feed,
+                                iui_carousel_state *carousel,
+                                iui_rect_t *inner)
+{
+    iui_begin_frame(ctx, 0.016f);
+    iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+    iui_scroll_begin(ctx, feed, 300.f, 200.f);
+    iui_carousel_begin(ctx, carousel, 0.f, 120.f);
+    *inner = ctx->scroll_viewport;
+    for (int i = 0; i < 8; i++)
+        iui_carousel_item(ctx, carousel, NULL, "Card");
+    iui_carousel_end(ctx, carousel);
+    for (int i = 0; i < 10; i++)
+        iui_list_item_simple(ctx, "Row", NULL);
+    iui_scroll_end(ctx, feed);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+}
+
+static void test_scroll_nested(void)
+{
+    TEST(scroll_nested);
+
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    iui_scroll_state feed = {0};
+    iui_carousel_state carousel = {0};
+    iui_rect_t inner;
+
+    /* Each region measures its own content along its own flow */
+    scroll_nested_frame(ctx, &feed, &carousel, &inner);
+    ASSERT_TRUE(carousel.scroll.content_w > inner.width);
+    ASSERT_NEAR(carousel.scroll.content_h, 0.f, 0.5f);
+    ASSERT_TRUE(feed.content_h > 120.f + 10 * IUI_LIST_ONE_LINE_HEIGHT);
+    ASSERT_NEAR(feed.content_w, 300.f, 0.5f);
+
+    /* Over the carousel, dx scrolls it and dy scrolls the feed */
+    iui_update_mouse_pos(ctx, inner.x + 20.f, inner.y + 20.f);
+    iui_update_scroll(ctx, -40.f, -30.f);
+    scroll_nested_frame(ctx, &feed, &carousel, &inner);
+    ASSERT_NEAR(carousel.scroll.scroll_x, 40.f, 0.01f);
+    ASSERT_NEAR(carousel.scroll.scroll_y, 0.f, 0.01f);
+    ASSERT_NEAR(feed.scroll_y, 30.f, 0.01f);
+    ASSERT_NEAR(feed.scroll_x, 0.f, 0.01f);
+
+    /* Past the configured depth a region is refused and the parent kept */
+    enum { levels = IUI_SCROLL_STACK_SIZE + 1 };
+    iui_scroll_state s[levels + 1] = {0};
+    iui_begin_frame(ctx, 0.016f);
+    iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+    for (int i = 0; i < levels; i++)
+        iui_scroll_begin(ctx, &s[i], 300.f - i * 20.f, 300.f - i * 20.f);
+    ASSERT_EQ(ctx->scroll_depth, IUI_SCROLL_STACK_SIZE);
+    iui_rect_t vd = iui_scroll_begin(ctx, &s[levels], 50.f, 50.f);
+    ASSERT_NEAR(vd.height, 0.f, 0.001f);
+    ASSERT_FALSE(iui_scroll_end(ctx, &s[levels]));
+    ASSERT_TRUE(ctx->active_scroll == &s[levels - 1]);
+    for (int i = levels - 1; i >= 0; i--)
+        iui_scroll_end(ctx, &s[i]);
+    ASSERT_NULL(ctx->active_scroll);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    free(buffer);
+    PASS();
+}
+
+/* A vertical list nested in a vertical feed */
+static void scroll_stacked_frame(iui_context *ctx,
+                                 iui_scroll_state *feed,
+                                 iui_scroll_state *list,
+                                 iui_rect_t *inner)
+{
+    iui_begin_frame(ctx, 0.016f);
+    iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+    iui_scroll_begin(ctx, feed, 300.f, 200.f);
+    iui_scroll_begin(ctx, list, 280.f, 100.f);
+    *inner = ctx->scroll_viewport;
+    for (int i = 0; i < 10; i++)
+        iui_list_item_simple(ctx, "Item", NULL);
+    iui_scroll_end(ctx, list);
+    for (int i = 0; i < 10; i++)
+        iui_list_item_simple(ctx, "Row", NULL);
+    iui_scroll_end(ctx, feed);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+}
+
+static void test_scroll_nested_wheel(void)
+{
+    TEST(scroll_nested_wheel);
+
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    iui_scroll_state feed = {0}, list = {0};
+    iui_rect_t inner;
+    scroll_stacked_frame(ctx, &feed, &list, &inner);
+
+    /* The innermost region under the mouse takes the wheel */
+    iui_update_mouse_pos(ctx, inner.x + 20.f, inner.y + 20.f);
+    scroll_stacked_frame(ctx, &feed, &list, &inner);
+    iui_update_scroll(ctx, 0.f, -30.f);
+    scroll_stacked_frame(ctx, &feed, &list, &inner);
+    ASSERT_NEAR(list.scroll_y, 30.f, 0.01f);
+    ASSERT_NEAR(feed.scroll_y, 0.f, 0.01f);
+
+    /* Outside the inner viewport the feed scrolls */
+    iui_update_mouse_pos(ctx, inner.x + 20.f, inner.y + inner.height + 20.f);
+    scroll_stacked_frame(ctx, &feed, &list, &inner);
+    iui_update_scroll(ctx, 0.f, -30.f);
+    scroll_stacked_frame(ctx, &feed, &list, &inner);
+    ASSERT_NEAR(list.scroll_y, 30.f, 0.01f);
+    ASSERT_NEAR(feed.scroll_y, 30.f, 0.01f);
+
+    free(buffer);
+    PASS();
+}
+
+static void test_scroll_content_hash(void)
+{
+    TEST(scroll_content_hash);
+
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    iui_scroll_state scroll = {0};
+    int laid_out = 0;
+    for (int frame = 0; frame < 4; frame++) {
+        /* The row count changes on frame 2 */
+        int rows = frame < 2 ? 20 : 30;
+        iui_begin_frame(ctx, 0.016f);
+        iui_begin_window(ctx, "test", 10, 10, 400, 400, 0);
+        iui_scroll_begin(ctx, &scroll, 200.f, 300.f);
+        if (!iui_scroll_content_hash(ctx, &scroll, (uint32_t) rows)) {
+            for (int i = 0; i < rows; i++)
+                iui_list_item_simple(ctx, "Row", NULL);
+            laid_out++;
+        }
+        iui_scroll_end(ctx, &scroll);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+        ASSERT_NEAR(scroll.content_h, rows * IUI_LIST_ONE_LINE_HEIGHT, 0.5f);
+    }
+    ASSERT_EQ(laid_out, 2); /* frames 0 and 2 */
+
+    /* Outside the open region nothing is declared */
+    ASSERT_FALSE(iui_scroll_content_hash(ctx, &scroll, 30));
+
+    free(buffer);
+    PASS();
+}
+
 /* Test Suite Runner */
 
 void run_scroll_tests(void)
@@ -363,5 +765,11 @@ void run_scroll_tests(void)
     test_scroll_wheel_interaction();
     test_scroll_negative_clamping();
     test_scroll_horizontal();
+    test_scroll_virtual_list();
+    test_scroll_virtual_list_var();
+    test_scroll_cached_layer();
+    test_scroll_nested();
+    test_scroll_nested_wheel();
+    test_scroll_content_hash();
     SECTION_END();
 }
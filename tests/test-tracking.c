@@ -755,6 +755,59 @@ static void test_many_textfields_stress(void)
     PASS();
 }
 
+/* Configured capacity: sets sized from the config, emptied per frame */
+static void test_tracking_capacity_config(void)
+{
+    TEST(tracking_capacity_config);
+    iui_config_t caps = {.max_tracked_fields = 100};
+    iui_context *ctx = create_test_context_for(&caps);
+    ASSERT_NOT_NULL(ctx);
+
+#define NUM_FIELDS 128 /* 100 rounds up to 128 slots */
+    static char bufs[NUM_FIELDS + 1][4];
+
+    /* Fill every slot; one more is dropped without disturbing the rest */
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    for (int i = 0; i <= NUM_FIELDS; i++) {
+        iui_register_textfield(ctx, bufs[i]);
+        iui_register_slider(ctx, (uint32_t) (i + 1) * 0x9E3779B1u);
+    }
+    ASSERT_EQ(ctx->field_tracking.textfield_count, NUM_FIELDS);
+    ASSERT_EQ(ctx->field_tracking.slider_count, NUM_FIELDS);
+    for (int i = 0; i < NUM_FIELDS; i++) {
+        ASSERT_TRUE(iui_textfield_is_registered(ctx, bufs[i]));
+        ASSERT_TRUE(iui_slider_is_registered(
+            ctx, (uint32_t) (i + 1) * 0x9E3779B1u));
+    }
+    ASSERT_FALSE(iui_textfield_is_registered(ctx, bufs[NUM_FIELDS]));
+    ASSERT_TRUE(ctx->field_tracking.textfield_overflow);
+    ASSERT_TRUE(ctx->field_tracking.slider_overflow);
+
+    /* The dropped field keeps focus and the dropped slider its drag */
+    ctx->focused_edit = bufs[NUM_FIELDS];
+    ctx->slider.active_id = ((uint32_t) (NUM_FIELDS + 1) * 0x9E3779B1u) &
+                            IUI_SLIDER_ID_MASK;
+    uint32_t active = ctx->slider.active_id;
+    iui_end_frame(ctx);
+    ASSERT_TRUE(ctx->focused_edit == bufs[NUM_FIELDS]);
+    ASSERT_EQ(ctx->slider.active_id, active);
+
+    /* Next frame starts empty, and the stale slots are reusable */
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    ASSERT_EQ(ctx->field_tracking.textfield_count, 0);
+    ASSERT_FALSE(ctx->field_tracking.textfield_overflow);
+    ASSERT_FALSE(iui_textfield_is_registered(ctx, bufs[0]));
+    ASSERT_FALSE(iui_slider_is_registered(ctx, 0x9E3779B1u));
+    iui_register_textfield(ctx, bufs[NUM_FIELDS]);
+    ASSERT_TRUE(iui_textfield_is_registered(ctx, bufs[NUM_FIELDS]));
+    ASSERT_EQ(ctx->field_tracking.textfield_count, 1);
+    iui_end_frame(ctx);
+
+#undef NUM_FIELDS
+    free(ctx);
+    PASS();
+}
+
 /* Test Suite Runner */
 
 void run_field_tracking_tests(void)
@@ -782,5 +835,6 @@ void run_field_tracking_tests(void)
     test_slider_unrendered_clears_active();
     test_rerender_after_skip_frame();
     test_many_textfields_stress();
+    test_tracking_capacity_config();
     SECTION_END();
 }
@@ -134,6 +134,321 @@ static void test_vector_primitives_edge_values(void)
     PASS();
 }
 
+static void test_glyph_advance_table(void)
+{
+    TEST(glyph_advance_table);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    /* Force the built-in vector font for measurement */
+    ctx->renderer.text_width = NULL;
+    const char *text = "Hello, World! \x01~";
+    float base = ctx->font_height;
+
+    /* Table sum must match the per-glyph computation exactly */
+    ASSERT_EQ(iui_get_text_width(ctx, text), iui_text_width_vec(text, base));
+    ASSERT_EQ(iui_get_codepoint_width(ctx, 'W'),
+              iui_codepoint_width_vec('W', base));
+    ASSERT_EQ(iui_get_codepoint_width(ctx, 0x263A),
+              iui_codepoint_width_vec(0x263A, base));
+
+    /* Font change selects another table; switching back reuses the first */
+    const float *first = iui_glyph_advances(ctx);
+    ctx->font_height = base * 2.f;
+    ASSERT_TRUE(iui_glyph_advances(ctx) != first);
+    ASSERT_EQ(iui_get_text_width(ctx, text),
+              iui_text_width_vec(text, base * 2.f));
+    ctx->font_height = base;
+    ASSERT_TRUE(iui_glyph_advances(ctx) == first);
+
+    free(buffer);
+    PASS();
+}
+
+/* Two-glyph pack (U+00E9, U+0416) as built by scripts/gen-glyph-pack.py */
+static const uint8_t g_test_glyph_pack[] = {
+    'I', 'U', 'G', 'P', 1, 0, 0, 0, 2, 0, 0, 0, 26, 0, 0, 0,
+    /* index: {codepoint, offset} */
+    0xE9, 0, 0, 0, 0, 0, 0, 0, 0x16, 0x04, 0, 0, 13, 0, 0, 0,
+    /* U+00E9 */
+    0, 20, 30, 0, 0, 0, 'm', 0, 0, 'l', 20, (uint8_t) -30, 'e',
+    /* U+0416 */
+    0, 30, 42, 0, 0, 0, 'm', 0, 0, 'l', 30, (uint8_t) -42, 'e',
+};
+
+/* Pack whose only glyph (U+00E9) is cut off at data_size */
+static const uint8_t g_truncated_glyph_pack[] = {
+    'I', 'U', 'G', 'P', 1, 0, 0, 0, 1, 0, 0, 0, 11, 0, 0, 0,
+    0xE9, 0, 0, 0, 0, 0, 0, 0,
+    0, 20, 30, 0, 0, 0, 'm', 0, 0, 'l', 20,
+    /* past data_size */
+    (uint8_t) -30, 'l', 5, 5, 'e',
+};
+
+static void test_glyph_pack(void)
+{
+    TEST(glyph_pack);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+    ctx->renderer.text_width = NULL;
+
+    const signed char *box = iui_glyph_lookup(ctx, 0xE9, NULL);
+    float box_w = iui_get_codepoint_width(ctx, 0xE9);
+    ASSERT_TRUE(box == iui_glyph_lookup(ctx, 0x263A, NULL));
+
+    /* Malformed or truncated packs are rejected */
+    ASSERT_FALSE(iui_glyph_pack_attach(ctx, g_test_glyph_pack, 20));
+    ASSERT_FALSE(iui_glyph_pack_attach(ctx, "IUGX", 4));
+    ASSERT_TRUE(iui_glyph_pack_attach(ctx, g_test_glyph_pack,
+                                      sizeof(g_test_glyph_pack)));
+
+    /* Glyphs are served in place from the pack */
+    const signed char *g = iui_glyph_lookup(ctx, 0x416, NULL);
+    ASSERT_TRUE(g == (const signed char *) g_test_glyph_pack + 45);
+    ASSERT_EQ(IUI_GLYPH_RIGHT(g), 30);
+    ASSERT_TRUE(iui_glyph_lookup(ctx, 0x263A, NULL) == box);
+    ASSERT_TRUE(iui_glyph_lookup(ctx, 'A', NULL) == iui_get_glyph('A'));
+
+    /* Widths come from the pack glyph (20 units) instead of the box (24) */
+    float w = iui_get_codepoint_width(ctx, 0xE9);
+    ASSERT_NEAR(box_w - w, 4.f * ctx->font_height / 64.f, 0.001f);
+
+    iui_glyph_pack_detach_all(ctx);
+    ASSERT_TRUE(iui_glyph_lookup(ctx, 0xE9, NULL) == box);
+
+    free(buffer);
+    PASS();
+}
+
+/* Counting vector callbacks for glyph outline tests */
+static int g_path_moves, g_path_lines, g_path_curves, g_path_strokes;
+static int g_path_runs_begun, g_path_runs_ended;
+
+static void count_path_move(float x, float y, void *user)
+{
+    (void) x, (void) y, (void) user;
+    g_path_moves++;
+}
+
+static void count_path_line(float x, float y, void *user)
+{
+    (void) x, (void) y, (void) user;
+    g_path_lines++;
+}
+
+static void count_path_curve(float x1,
+                             float y1,
+                             float x2,
+                             float y2,
+                             float x3,
+                             float y3,
+                             void *user)
+{
+    (void) x1, (void) y1, (void) x2, (void) y2, (void) x3, (void) y3;
+    (void) user;
+    g_path_curves++;
+}
+
+static void count_path_stroke(float width, uint32_t color, void *user)
+{
+    (void) width, (void) color, (void) user;
+    g_path_strokes++;
+}
+
+static void count_path_begin_run(float width, uint32_t color, void *user)
+{
+    (void) width, (void) color, (void) user;
+    g_path_runs_begun++;
+}
+
+static void count_path_end_run(void *user)
+{
+    (void) user;
+    g_path_runs_ended++;
+}
+
+static void test_vector_text_run(void)
+{
+    TEST(vector_text_run);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    iui_vector_t vec = {
+        .path_move = count_path_move,
+        .path_line = count_path_line,
+        .path_curve = count_path_curve,
+        .path_stroke = count_path_stroke,
+    };
+    ctx->vector = &vec;
+
+    /* Without run callbacks every subpath is stroked on its own */
+    g_path_moves = g_path_strokes = 0;
+    g_path_runs_begun = g_path_runs_ended = 0;
+    iui_draw_text_vec(ctx, 0.f, 0.f, "Label text", 0xFFFFFFFF);
+    int strokes = g_path_strokes, moves = g_path_moves;
+    ASSERT_TRUE(strokes >= 10);
+
+    /* With them the whole string becomes one run and no per-path strokes */
+    vec.path_begin_run = count_path_begin_run;
+    vec.path_end_run = count_path_end_run;
+    g_path_moves = g_path_strokes = 0;
+    iui_draw_text_vec(ctx, 0.f, 0.f, "Label text", 0xFFFFFFFF);
+    ASSERT_EQ(g_path_strokes, 0);
+    ASSERT_EQ(g_path_runs_begun, 1);
+    ASSERT_EQ(g_path_runs_ended, 1);
+    ASSERT_EQ(g_path_moves, moves);
+
+    free(buffer);
+    PASS();
+}
+
+static void test_utf8_vector_text(void)
+{
+    TEST(utf8_vector_text);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+    ctx->renderer.text_width = NULL;
+
+    /* A multi-byte character is one glyph, not one box per byte */
+    float h = ctx->font_height;
+    ASSERT_EQ(iui_text_width_vec("\xC3\xA9", h), iui_codepoint_width_vec(0, h));
+
+    /* String width equals the sum of codepoint widths, across the 8/16-byte
+     * ASCII fast path boundaries and with a pack glyph in the middle.
+     */
+    ASSERT_TRUE(iui_glyph_pack_attach(ctx, g_test_glyph_pack,
+                                      sizeof(g_test_glyph_pack)));
+    const char *text = "Hello, long ASCII run \xC3\xA9 and \xE2\x82\xAC.";
+    const uint32_t cps[] = {0xE9, 0x20AC};
+    float expected = iui_get_codepoint_width(ctx, cps[0]) +
+                     iui_get_codepoint_width(ctx, cps[1]);
+    for (const char *p = text; *p; p++) {
+        if (!((unsigned char) *p & 0x80))
+            expected += iui_get_codepoint_width(ctx, (unsigned char) *p);
+    }
+    ASSERT_NEAR(iui_get_text_width(ctx, text), expected, 0.001f);
+
+    /* Drawing resolves the pack glyph: one subpath, stroked once */
+    static const iui_vector_t vec = {
+        .path_move = count_path_move,
+        .path_line = count_path_line,
+        .path_curve = count_path_curve,
+        .path_stroke = count_path_stroke,
+    };
+    ctx->vector = &vec;
+    g_path_moves = g_path_strokes = 0;
+    iui_draw_text_vec(ctx, 0.f, 0.f, "\xC3\xA9", 0xFFFFFFFF);
+    ASSERT_EQ(g_path_moves, 1);
+    ASSERT_EQ(g_path_strokes, 1);
+
+    /* Bytecode cut off at data_size stops there instead of reading on into
+     * the bytes that follow the pack
+     */
+    iui_glyph_pack_detach_all(ctx);
+    ASSERT_TRUE(iui_glyph_pack_attach(ctx, g_truncated_glyph_pack,
+                                      sizeof(g_truncated_glyph_pack)));
+    g_path_moves = g_path_lines = g_path_strokes = 0;
+    for (int i = 0; i < 2; i++) /* cache miss, then the cached result */
+        iui_draw_text_vec(ctx, 0.f, 0.f, "\xC3\xA9", 0xFFFFFFFF);
+    ASSERT_EQ(g_path_moves, 0);
+    ASSERT_EQ(g_path_lines, 0);
+    ASSERT_EQ(g_path_strokes, 0);
+
+    free(buffer);
+    PASS();
+}
+
+static void test_glyph_outline_cache(void)
+{
+    TEST(glyph_outline_cache);
+    iui_config_t config =
+        iui_make_config(NULL,
+                        (iui_renderer_t) {
+                            .draw_box = mock_draw_box,
+                            .draw_text = mock_draw_text,
+                            .set_clip_rect = mock_set_clip,
+                            .text_width = mock_text_width,
+                        },
+                        16.0f, NULL);
+    config.glyph_cache_points = 2048;
+    size_t cached_size = iui_min_memory_size_for(&config);
+    config.buffer = malloc(cached_size);
+    config.buffer_size = cached_size;
+    iui_context *ctx = iui_init(&config);
+    ASSERT_NOT_NULL(ctx);
+    ASSERT_EQ(ctx->glyph_cache.capacity, 2048);
+
+    static const iui_vector_t vec = {
+        .path_move = count_path_move,
+        .path_line = count_path_line,
+        .path_curve = count_path_curve,
+        .path_stroke = count_path_stroke,
+    };
+    ctx->vector = &vec;
+    g_path_moves = g_path_lines = g_path_curves = g_path_strokes = 0;
+
+    /* First draw flattens each distinct glyph once */
+    iui_draw_text_vec(ctx, 10.f, 10.f, "Go go", 0xFFFFFFFF);
+    ASSERT_EQ(ctx->glyph_cache.misses, 4); /* 'G', 'o', ' ', 'g' */
+    ASSERT_EQ(ctx->glyph_cache.hits, 1);
+    int moves = g_path_moves, lines = g_path_lines;
+    ASSERT_TRUE(moves > 0 && lines > 0);
+    ASSERT_EQ(g_path_curves, 0); /* curves arrive pre-flattened */
+
+    /* Redraw is served entirely from the cache with identical output */
+    iui_draw_text_vec(ctx, 10.f, 10.f, "Go go", 0xFFFFFFFF);
+    ASSERT_EQ(ctx->glyph_cache.misses, 4);
+    ASSERT_EQ(ctx->glyph_cache.hits, 6);
+    ASSERT_EQ(g_path_moves, moves * 2);
+    ASSERT_EQ(g_path_lines, lines * 2);
+
+    /* A new font size gets its own outlines */
+    ctx->font_height *= 2.f;
+    iui_draw_text_vec(ctx, 10.f, 10.f, "o", 0xFFFFFFFF);
+    ASSERT_EQ(ctx->glyph_cache.misses, 5);
+
+    /* A truncated pack glyph is cached as an empty outline: nothing drawn */
+    ASSERT_TRUE(iui_glyph_pack_attach(ctx, g_truncated_glyph_pack,
+                                      sizeof(g_truncated_glyph_pack)));
+    g_path_moves = g_path_strokes = 0;
+    for (int i = 0; i < 2; i++)
+        iui_draw_text_vec(ctx, 10.f, 10.f, "\xC3\xA9", 0xFFFFFFFF);
+    ASSERT_EQ(ctx->glyph_cache.misses, 1);
+    ASSERT_EQ(ctx->glyph_cache.hits, 1);
+    ASSERT_EQ(g_path_moves + g_path_strokes, 0);
+    iui_glyph_pack_detach_all(ctx);
+    ctx->font_height /= 2.f;
+
+    /* The default has no cache, like a negative size; outlines are
+     * flattened per draw with the same output
+     */
+    config.glyph_cache_points = 0;
+    ASSERT_EQ(iui_min_memory_size_for(&config), iui_min_memory_size());
+    config.glyph_cache_points = -1;
+    ASSERT_TRUE(iui_config_is_valid(&config));
+    ASSERT_EQ(iui_min_memory_size_for(&config), iui_min_memory_size());
+    ASSERT_TRUE(iui_min_memory_size() < cached_size);
+    ctx = iui_init(&config);
+    ASSERT_NOT_NULL(ctx);
+    ASSERT_NULL(ctx->glyph_cache.entries);
+    ctx->vector = &vec;
+    g_path_moves = g_path_lines = 0;
+    iui_draw_text_vec(ctx, 10.f, 10.f, "Go go", 0xFFFFFFFF);
+    ASSERT_EQ(g_path_moves, moves);
+    ASSERT_EQ(g_path_lines, lines);
+    ASSERT_EQ(ctx->glyph_cache.hits + ctx->glyph_cache.misses, 0);
+
+    config.glyph_cache_points = UINT16_MAX + 1;
+    ASSERT_FALSE(iui_config_is_valid(&config));
+
+    free(config.buffer);
+    PASS();
+}
+
 /* Test Suite Runner */
 void run_vector_tests(void)
 {
@@ -144,5 +459,10 @@ void run_vector_tests(void)
     test_draw_circle();
     test_draw_arc();
     test_vector_primitives_edge_values();
+    test_glyph_advance_table();
+    test_glyph_pack();
+    test_glyph_outline_cache();
+    test_vector_text_run();
+    test_utf8_vector_text();
     SECTION_END();
 }
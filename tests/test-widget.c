@@ -54,6 +54,236 @@ static void test_component_state_functions(void)
     PASS();
 }
 
+static void test_hover_resolves_topmost(void)
+{
+    TEST(hover_resolves_topmost);
+    iui_config_t caps = {.max_widget_map = 16};
+    iui_context *ctx = create_test_context_for(&caps);
+    ASSERT_NOT_NULL(ctx);
+
+    /* B is drawn after A and overlaps it under the pointer */
+    iui_rect_t a = {20.0f, 60.0f, 100.0f, 60.0f};
+    iui_rect_t b = {60.0f, 80.0f, 100.0f, 60.0f};
+    iui_rect_t moved = {22.0f, 60.0f, 100.0f, 60.0f};
+    iui_update_mouse_pos(ctx, 80.0f, 100.0f);
+
+    iui_state_t state_a[2], state_b[2];
+    uint32_t id_a = 0, id_b = 0;
+    for (int frame = 0; frame < 2; frame++) {
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+        state_a[frame] = iui_get_component_state(ctx, a, false);
+        id_a = iui_last_component_id(ctx);
+        state_b[frame] = iui_get_component_state(ctx, b, false);
+        id_b = iui_last_component_id(ctx);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+    }
+
+    /* First frame has no map yet, so both hover; then only B does */
+    ASSERT_EQ(state_a[0], IUI_STATE_HOVERED);
+    ASSERT_EQ(state_a[1], IUI_STATE_DEFAULT);
+    ASSERT_EQ(state_b[1], IUI_STATE_HOVERED);
+
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    ASSERT_TRUE(iui_is_hot(ctx, id_b));
+    ASSERT_FALSE(iui_is_hot(ctx, id_a));
+    ASSERT_FALSE(iui_is_hot(ctx, 0));
+
+    /* A widget that moved keeps its ID, and stays covered by B */
+    iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+    ASSERT_EQ(iui_get_component_state(ctx, moved, false), IUI_STATE_DEFAULT);
+    ASSERT_EQ(iui_last_component_id(ctx), id_a);
+    ASSERT_EQ(iui_get_component_state(ctx, b, false), IUI_STATE_HOVERED);
+    iui_end_window(ctx);
+    iui_end_frame(ctx);
+
+    /* Identical rects get distinct IDs: only the later one is on top */
+    for (int frame = 0; frame < 2; frame++) {
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+        state_a[frame] = iui_get_component_state(ctx, a, false);
+        id_a = iui_last_component_id(ctx);
+        state_b[frame] = iui_get_component_state(ctx, a, false);
+        id_b = iui_last_component_id(ctx);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+    }
+    ASSERT_TRUE(id_a != id_b);
+    ASSERT_EQ(state_a[1], IUI_STATE_DEFAULT);
+    ASSERT_EQ(state_b[1], IUI_STATE_HOVERED);
+    free(ctx);
+
+    /* Without a widget map (the default) every widget under the pointer
+     * hovers
+     */
+    void *buffer = malloc(iui_min_memory_size());
+    ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+    iui_update_mouse_pos(ctx, 80.0f, 100.0f);
+    for (int frame = 0; frame < 2; frame++) {
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+        state_a[frame] = iui_get_component_state(ctx, a, false);
+        state_b[frame] = iui_get_component_state(ctx, b, false);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+    }
+    ASSERT_EQ(state_a[1], IUI_STATE_HOVERED);
+    ASSERT_EQ(state_b[1], IUI_STATE_HOVERED);
+
+    free(buffer);
+    PASS();
+}
+
+static void test_hover_ignores_clipped_widgets(void)
+{
+    TEST(hover_ignores_clipped_widgets);
+    iui_config_t caps = {.max_widget_map = 16};
+    iui_context *ctx = create_test_context_for(&caps);
+    ASSERT_NOT_NULL(ctx);
+
+    /* A header button above a clipped region whose content was scrolled up
+     * past the region's top edge, so its rows lie under the header
+     */
+    iui_rect_t header = {20.0f, 40.0f, 100.0f, 30.0f};
+    iui_rect_t region = {0.0f, 100.0f, 400.0f, 150.0f};
+    iui_rect_t row = {0.0f, 100.0f - 400.0f, 400.0f, 500.0f};
+    iui_update_mouse_pos(ctx, 50.0f, 50.0f);
+
+    iui_state_t state[3];
+    for (int frame = 0; frame < 3; frame++) {
+        if (frame == 2)
+            iui_update_mouse_buttons(ctx, IUI_MOUSE_LEFT, 0);
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+        state[frame] = iui_get_component_state(ctx, header, false);
+        ASSERT_TRUE(iui_push_clip(ctx, region));
+        ASSERT_EQ(iui_get_component_state(ctx, row, false), IUI_STATE_DEFAULT);
+        iui_pop_clip(ctx);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+    }
+    ASSERT_EQ(state[1], IUI_STATE_HOVERED);
+    ASSERT_EQ(state[2], IUI_STATE_PRESSED);
+
+    free(ctx);
+    PASS();
+}
+
+static void test_component_id_scopes(void)
+{
+    TEST(component_id_scopes);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+
+    /* IDs are positional: a conditional widget shifts the one after it,
+     * unless it is drawn inside its own ID scope
+     */
+    iui_rect_t r = {20.0f, 20.0f, 50.0f, 20.0f};
+    uint32_t ids[2][2]; /* [wrapped][shown] */
+    for (int wrapped = 0; wrapped < 2; wrapped++) {
+        for (int shown = 0; shown < 2; shown++) {
+            iui_begin_frame(ctx, 1.0f / 60.0f);
+            iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+            if (shown) {
+                if (wrapped)
+                    ASSERT_TRUE(iui_push_id(ctx, "opt", 3));
+                iui_get_component_state(ctx, r, false);
+                if (wrapped)
+                    iui_pop_id(ctx);
+            }
+            iui_get_component_state(ctx, r, false);
+            ids[wrapped][shown] = iui_last_component_id(ctx);
+            iui_end_window(ctx);
+            iui_end_frame(ctx);
+        }
+    }
+    ASSERT_TRUE(ids[0][0] != ids[0][1]);
+    ASSERT_EQ(ids[1][0], ids[1][1]);
+
+    free(buffer);
+    PASS();
+}
+
+static void test_widget_state_table(void)
+{
+    TEST(widget_state_table);
+    void *buffer = malloc(iui_min_memory_size());
+    iui_context *ctx = create_test_context(buffer, false);
+    ASSERT_NOT_NULL(ctx);
+    iui_widget_state_table *t = &ctx->widget_states;
+    iui_rect_t r = {0.0f, 0.0f, 10.0f, 10.0f};
+
+    /* Three IDs sharing one home slot form a probe chain */
+    uint32_t step = t->mask + 1, a = 5, b = 5 + step, c = 5 + 2 * step;
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    ASSERT_NULL(iui_widget_state_touch(ctx, 0, r));
+    iui_widget_state_touch(ctx, a, r)->anim_t = 0.f;
+    iui_widget_state_touch(ctx, b, r)->anim_t = 0.f;
+    iui_widget_state_touch(ctx, c, r)->hover_t = 0.5f;
+    iui_end_frame(ctx);
+    ASSERT_EQ(t->count, 3);
+
+    /* Untouched A is evicted; C is still found past the hole it leaves */
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_widget_state *wb = iui_widget_state_touch(ctx, b, r);
+    ASSERT_TRUE(wb->anim_t > 0.f && wb->anim_t < 1.f);
+    iui_widget_state_touch(ctx, c, r);
+    iui_end_frame(ctx);
+    ASSERT_EQ(t->count, 2);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    ASSERT_NEAR(iui_widget_state_touch(ctx, c, r)->hover_t, 0.5f, 0.001f);
+    ASSERT_EQ(iui_widget_state_touch(ctx, a, r)->anim_t, 1.f);
+    iui_end_frame(ctx);
+
+    /* An empty frame clears the table; a full one evicts the least
+     * recently touched record for a new one
+     */
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_end_frame(ctx);
+    ASSERT_EQ(t->count, 0);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    for (uint32_t id = 1; id <= (uint32_t) t->capacity; id++)
+        iui_widget_state_touch(ctx, id, r)->anim_t = 0.f;
+    iui_end_frame(ctx);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    for (uint32_t id = 2; id <= (uint32_t) t->capacity; id++)
+        iui_widget_state_touch(ctx, id, r);
+    iui_widget_state *fresh = iui_widget_state_touch(ctx, 1000, r);
+    ASSERT_NOT_NULL(fresh);
+    ASSERT_EQ(fresh->anim_t, 1.f);
+    ASSERT_EQ(t->count, t->capacity);
+    ASSERT_EQ(iui_widget_state_touch(ctx, 1, r)->anim_t, 1.f);
+    ASSERT_EQ(t->count, t->capacity);
+    ASSERT_TRUE(iui_widget_state_touch(ctx, 2, r)->anim_t > 0.f);
+    iui_end_frame(ctx);
+    iui_begin_frame(ctx, 1.0f / 60.0f);
+    iui_end_frame(ctx);
+
+    /* Two buttons pressed on consecutive frames animate concurrently */
+    const char *labels[2] = {"One", "Two"};
+    for (int frame = 0; frame < 3; frame++) {
+        iui_update_mouse_pos(ctx, 200.0f, frame ? 90.0f : 50.0f);
+        iui_update_mouse_buttons(ctx, frame < 2 ? IUI_MOUSE_LEFT : 0, 0);
+        iui_begin_frame(ctx, 1.0f / 60.0f);
+        iui_begin_window(ctx, "Test", 0, 0, 400, 300, 0);
+        for (int i = 0; i < 2; i++)
+            iui_button(ctx, labels[i], IUI_ALIGN_CENTER);
+        iui_end_window(ctx);
+        iui_end_frame(ctx);
+    }
+    int animating = 0;
+    for (uint32_t i = 0; i <= t->mask; i++)
+        if (t->slots[i].id != 0 && t->slots[i].anim_t < 1.f)
+            animating++;
+    ASSERT_EQ(animating, 2);
+
+    free(buffer);
+    PASS();
+}
+
 static void test_slider_min_greater_than_max(void)
 {
     TEST(slider_min_greater_than_max);
@@ -278,6 +508,10 @@ void run_widget_tests(void)
 {
     SECTION_BEGIN("Widget Edge Cases");
     test_component_state_functions();
+    test_hover_resolves_topmost();
+    test_hover_ignores_clipped_widgets();
+    test_component_id_scopes();
+    test_widget_state_table();
     test_slider_min_equals_max();
     test_slider_min_greater_than_max();
     test_slider_step_larger_than_range();